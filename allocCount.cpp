@@ -0,0 +1,73 @@
+/***********************************************************************
+ * Source File:
+ *    ALLOC COUNT
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The global operator new and delete hooks. Each thread keeps its
+ *    own counts so the hooks never contend with each other.
+ ************************************************************************/
+
+#include "allocCount.h"
+
+#ifdef ALLOC_COUNT
+#include <new>       // for BAD_ALLOC
+#include <cstdlib>   // for MALLOC and FREE
+
+static thread_local AllocStats statsThread = { 0, 0, 0 };
+
+/*************************************************
+ * ALLOCATE
+ * Count, then get the memory from malloc()
+ *************************************************/
+static void * allocate(size_t size)
+{
+   statsThread.numNew++;
+   statsThread.numBytes += (long)size;
+   void * p = malloc(size ? size : 1);
+   if (!p)
+      throw std::bad_alloc();
+   return p;
+}
+
+/*************************************************
+ * DEALLOCATE
+ *************************************************/
+static void deallocate(void * p)
+{
+   if (!p)
+      return;
+   statsThread.numDelete++;
+   free(p);
+}
+
+void * operator new   (size_t size)                       { return allocate(size); }
+void * operator new[] (size_t size)                       { return allocate(size); }
+void operator delete   (void * p) noexcept                { deallocate(p);         }
+void operator delete[] (void * p) noexcept                { deallocate(p);         }
+void operator delete   (void * p, size_t) noexcept        { deallocate(p);         }
+void operator delete[] (void * p, size_t) noexcept        { deallocate(p);         }
+
+bool allocCountEnabled()
+{
+   return true;
+}
+
+AllocStats allocStats()
+{
+   return statsThread;
+}
+
+#else
+
+bool allocCountEnabled()
+{
+   return false;
+}
+
+AllocStats allocStats()
+{
+   return AllocStats{ 0, 0, 0 };
+}
+
+#endif // ALLOC_COUNT
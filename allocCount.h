@@ -0,0 +1,80 @@
+/***********************************************************************
+ * Header File:
+ *    ALLOC COUNT
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Opt-in allocation counting. Build with ALLOC_COUNT defined and
+ *    every operator new and delete in the program is counted, per
+ *    thread, and every Counted<T> counts its own constructions, copies
+ *    and deletions. Without ALLOC_COUNT nothing is hooked, the counts
+ *    stay zero, and Counted<T> is an empty base that costs nothing.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>    // for ATOMIC type counts
+
+/***************************************************
+ * ALLOC STATS
+ * How many times this thread called new and delete,
+ * and how many bytes it asked for
+ ***************************************************/
+struct AllocStats
+{
+   long numNew;
+   long numDelete;
+   long numBytes;
+
+   AllocStats operator - (const AllocStats & rhs) const
+   {
+      return AllocStats{ numNew - rhs.numNew, numDelete - rhs.numDelete,
+                         numBytes - rhs.numBytes };
+   }
+};
+
+// were we built with ALLOC_COUNT?
+bool allocCountEnabled();
+
+// what this thread has allocated so far. All zero without ALLOC_COUNT
+AllocStats allocStats();
+
+/***************************************************
+ * TYPE COUNTS
+ * What happened to the objects of one type. Shared
+ * by every thread, so these are atomic
+ ***************************************************/
+struct TypeCounts
+{
+   std::atomic<long> numConstruct;
+   std::atomic<long> numCopy;
+   std::atomic<long> numDelete;
+
+   TypeCounts() : numConstruct(0), numCopy(0), numDelete(0) {}
+   long getLive() const { return numConstruct + numCopy - numDelete; }
+   void reset()         { numConstruct = 0; numCopy = 0; numDelete = 0; }
+};
+
+/***************************************************
+ * COUNTED
+ * Derive T from Counted<T> to count T objects, the
+ * way PieceSpy counts itself in the tests
+ ***************************************************/
+template <class T>
+class Counted
+{
+public:
+   static TypeCounts & counts()
+   {
+      static TypeCounts counts;
+      return counts;
+   }
+
+#ifdef ALLOC_COUNT
+protected:
+   Counted()                                { counts().numConstruct++; }
+   Counted(const Counted &)                 { counts().numCopy++;      }
+   ~Counted()                               { counts().numDelete++;    }
+   Counted & operator = (const Counted &)   { return *this;            }
+#endif
+};
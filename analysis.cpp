@@ -0,0 +1,130 @@
+/***********************************************************************
+ * Source File:
+ *    ANALYSIS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Think about a position on a thread of our own so the window keeps
+ *    drawing. What the search finds comes back through a lock-free
+ *    queue that the window polls once a frame.
+ ************************************************************************/
+
+#include "analysis.h"
+using namespace std;
+
+/*************************************************
+ * ANALYSIS : CONSTRUCT
+ *************************************************/
+Analysis::Analysis() :
+   board(nullptr),
+   search(board),
+   fRunning(false),
+   fDoneReady(false),
+   notify(nullptr),
+   pNotify(nullptr)
+{
+   search.setReport(report, this);
+}
+
+/*************************************************
+ * ANALYSIS : START
+ * Copy the position on this thread, then hand it
+ * to the worker
+ *************************************************/
+void Analysis::start(const Board & board, int maxDepth)
+{
+   stop();
+
+   bool fCopied = this->board.setFen(board.getFen());
+   assert(fCopied);
+   if (!fCopied)
+      return;
+
+   // start the clock here so a stop() that comes before the worker
+   // gets going is not lost
+   timeManager.startInfinite();
+   fRunning = true;
+   worker = thread(&Analysis::think, this, maxDepth);
+}
+
+/*************************************************
+ * ANALYSIS : STOP
+ * What the old search left in the queue is thrown
+ * away so it is not mistaken for the next one's
+ *************************************************/
+void Analysis::stop()
+{
+   timeManager.stop();
+   if (worker.joinable())
+      worker.join();
+   fRunning = false;
+
+   AnalysisResult result;
+   while (results.pop(result))
+      ;
+   fDoneReady = false;
+}
+
+/*************************************************
+ * ANALYSIS : POLL
+ * The worker queues everything before it sets
+ * fDoneReady, so once we see the flag, whatever is
+ * still queued goes first
+ *************************************************/
+bool Analysis::poll(AnalysisResult & result)
+{
+   if (results.pop(result))
+      return true;
+   if (!fDoneReady.load(memory_order_acquire))
+      return false;
+   if (results.pop(result))
+      return true;
+   result = resultDone;
+   fDoneReady.store(false, memory_order_relaxed);
+   return true;
+}
+
+/*************************************************
+ * ANALYSIS : THINK
+ * The worker thread
+ *************************************************/
+void Analysis::think(int maxDepth)
+{
+   search.think(maxDepth, timeManager);
+   send(search, true /*fDone*/);
+   fRunning = false;
+}
+
+/*************************************************
+ * ANALYSIS : SEND
+ * When the window has not kept up and the queue is
+ * full, the result is dropped; a newer one follows.
+ * The last one has a slot of its own instead
+ *************************************************/
+void Analysis::send(const Search & search, bool fDone)
+{
+   AnalysisResult result;
+   result.move  = search.getBestMove();
+   result.depth = search.getDepth();
+   result.score = search.getScore();
+   result.nodes = search.getNodes();
+   result.fDone = fDone;
+   if (fDone)
+   {
+      resultDone = result;
+      fDoneReady.store(true, memory_order_release);
+   }
+   else
+      results.push(result);
+   if (notify)
+      notify(pNotify);
+}
+
+/*************************************************
+ * ANALYSIS : REPORT
+ * Called by the search after every iteration
+ *************************************************/
+void Analysis::report(const Search & search, void * p)
+{
+   ((Analysis *)p)->send(search, false /*fDone*/);
+}
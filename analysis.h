@@ -0,0 +1,87 @@
+/***********************************************************************
+ * Header File:
+ *    ANALYSIS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Think about a position on a thread of our own so the window keeps
+ *    drawing. What the search finds comes back through a lock-free
+ *    queue that the window polls once a frame.
+ ************************************************************************/
+
+#pragma once
+
+#include <thread>         // for THREAD, where the search runs
+#include <atomic>         // for ATOMIC running flag
+#include "board.h"
+#include "search.h"
+#include "timeManager.h"
+#include "spscQueue.h"
+
+class TestAnalysis;
+
+/***************************************************
+ * ANALYSIS RESULT
+ * One completed iteration of the search
+ ***************************************************/
+struct AnalysisResult
+{
+   Move move;      // the best move so far
+   int  depth;
+   int  score;     // for the side to move
+   long nodes;
+   bool fDone;     // the search is over, this is the last one
+};
+
+/***************************************************
+ * ANALYSIS
+ * start() copies the position, so the board can
+ * change while we think about the old one. Call
+ * start(), stop(), and poll() from one thread
+ ***************************************************/
+class Analysis
+{
+   friend TestAnalysis;
+public:
+   Analysis();
+   ~Analysis() { stop(); }
+
+   // think about board until stop() or maxDepth. Stops any analysis
+   // already running first
+   void start(const Board & board, int maxDepth = DEPTH_MAX);
+
+   // tell the search to finish and wait for it
+   void stop();
+
+   bool isRunning() const { return fRunning; }
+
+   // the next result, if there is one. The last one (fDone) is never
+   // dropped and comes after all the others
+   bool poll(AnalysisResult & result);
+
+   // called on the search thread after each result is queued, for
+   // example to ask the window for a frame. Pass nullptr to turn it off
+   void setNotify(void (*notify)(void * p), void * p)
+   {
+      this->notify = notify;
+      this->pNotify = p;
+   }
+
+   static const int DEPTH_MAX = 60;   // deeper than we will ever get
+
+private:
+   void think(int maxDepth);
+   void send(const Search & search, bool fDone);
+   static void report(const Search & search, void * p);
+
+   Board board;                             // our own copy of the position
+   Search search;
+   TimeManager timeManager;
+   std::thread worker;                      // runs the search
+   std::atomic <bool> fRunning;
+   SpscQueue <AnalysisResult, 64> results;  // worker to window
+   AnalysisResult resultDone;               // the last result, which the queue may not have room for
+   std::atomic <bool> fDoneReady;           // resultDone is there to poll
+   void (*notify)(void * p);                // something new to poll
+   void * pNotify;                          // handed back to notify()
+};
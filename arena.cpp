@@ -0,0 +1,146 @@
+/***********************************************************************
+ * Source File:
+ *    ARENA
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The bump allocator and the fixed-size pool
+ ************************************************************************/
+
+#include "arena.h"
+#include <new>        // for ::OPERATOR NEW
+#include <cassert>
+using namespace std;
+
+// every allocation is aligned this much, enough for any Piece
+const size_t ALIGN = alignof(max_align_t);
+
+static size_t roundUp(size_t size)
+{
+   return (size + ALIGN - 1) & ~(ALIGN - 1);
+}
+
+/*************************************************
+ * ARENA : CONSTRUCT
+ *************************************************/
+Arena::Arena(size_t sizeBlock) :
+   sizeBlock(roundUp(sizeBlock)),
+   iBlock(0),
+   offset(0),
+   bytesUsed(0),
+   numAllocations(0)
+{
+   assert(sizeBlock > 0);
+}
+
+/*************************************************
+ * ARENA : DESTRUCT
+ *************************************************/
+Arena::~Arena()
+{
+   for (char * pBlock : blocks)
+      ::operator delete(pBlock);
+}
+
+/*************************************************
+ * ARENA : ALLOCATE
+ * Carve from the current block, moving on to the
+ * next one (making it if need be) when it is full
+ *************************************************/
+void * Arena::allocate(size_t size)
+{
+   size = roundUp(size ? size : 1);
+   assert(size <= sizeBlock);
+
+   if (iBlock < blocks.size() && offset + size > sizeBlock)
+   {
+      iBlock++;
+      offset = 0;
+   }
+   if (iBlock == blocks.size())
+      blocks.push_back((char *)::operator new(sizeBlock));
+
+   void * p = blocks[iBlock] + offset;
+   offset += size;
+   bytesUsed += size;
+   numAllocations++;
+   return p;
+}
+
+/*************************************************
+ * ARENA : RESET
+ *************************************************/
+void Arena::reset()
+{
+   iBlock = 0;
+   offset = 0;
+   bytesUsed = 0;
+   numAllocations = 0;
+}
+
+/*************************************************
+ * POOL : CONSTRUCT
+ * A slot must be able to hold the free-list link
+ *************************************************/
+Pool::Pool(size_t sizeSlot, size_t slotsPerBlock) :
+   sizeSlot(roundUp(sizeSlot < sizeof(Slot) ? sizeof(Slot) : sizeSlot)),
+   slotsPerBlock(slotsPerBlock),
+   pFree(nullptr),
+   numAllocations(0),
+   numInUse(0),
+   numPeak(0)
+{
+   assert(slotsPerBlock > 0);
+}
+
+/*************************************************
+ * POOL : DESTRUCT
+ *************************************************/
+Pool::~Pool()
+{
+   assert(numInUse == 0);
+   for (char * pBlock : blocks)
+      ::operator delete(pBlock);
+}
+
+/*************************************************
+ * POOL : ALLOCATE
+ * Take the first free slot. When there are none,
+ * a new block puts slotsPerBlock on the free list
+ *************************************************/
+void * Pool::allocate()
+{
+   if (!pFree)
+   {
+      char * pBlock = (char *)::operator new(sizeSlot * slotsPerBlock);
+      blocks.push_back(pBlock);
+      for (size_t i = slotsPerBlock; i > 0; i--)
+      {
+         Slot * pSlot = (Slot *)(pBlock + (i - 1) * sizeSlot);
+         pSlot->pNext = pFree;
+         pFree = pSlot;
+      }
+   }
+
+   Slot * pSlot = pFree;
+   pFree = pSlot->pNext;
+   numAllocations++;
+   numInUse++;
+   if (numInUse > numPeak)
+      numPeak = numInUse;
+   return pSlot;
+}
+
+/*************************************************
+ * POOL : DEALLOCATE
+ *************************************************/
+void Pool::deallocate(void * p)
+{
+   if (!p)
+      return;
+   assert(numInUse > 0);
+   Slot * pSlot = (Slot *)p;
+   pSlot->pNext = pFree;
+   pFree = pSlot;
+   numInUse--;
+}
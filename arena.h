@@ -0,0 +1,132 @@
+/***********************************************************************
+ * Header File:
+ *    ARENA
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Two allocators that hand out memory without going to the heap
+ *    for every object:
+ *       Arena - carve objects out of big blocks, one after another,
+ *               and give them all back at once with reset()
+ *       Pool  - slots of one size, handed out and taken back one at
+ *               a time through a free list
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>     // for VECTOR of blocks
+#include <cstddef>    // for SIZE_T
+
+class TestArena;
+
+/***************************************************
+ * ARENA
+ * A bump allocator. Nothing is freed until reset(),
+ * which keeps the blocks for next time
+ ***************************************************/
+class Arena
+{
+   friend TestArena;
+public:
+   Arena(size_t sizeBlock = 4096);
+   ~Arena();
+   Arena(const Arena &) = delete;
+   Arena & operator = (const Arena &) = delete;
+
+   // size bytes aligned for anything
+   void * allocate(size_t size);
+
+   // forget every allocation, but keep the memory
+   void reset();
+
+   // statistics
+   size_t getBytesUsed()     const { return bytesUsed;      }
+   size_t getBlocks()        const { return blocks.size();  }
+   long   getAllocations()   const { return numAllocations; }
+
+private:
+   size_t sizeBlock;
+   std::vector <char *> blocks;
+   size_t iBlock;           // the block we are carving from
+   size_t offset;           // how far into it we are
+   size_t bytesUsed;        // since the last reset
+   long   numAllocations;   // since the last reset
+};
+
+/***************************************************
+ * POOL
+ * Slots of one size. Every block holds slotsPerBlock
+ * of them, and a freed slot is the next one handed out
+ ***************************************************/
+class Pool
+{
+   friend TestArena;
+public:
+   Pool(size_t sizeSlot, size_t slotsPerBlock = 64);
+   ~Pool();
+   Pool(const Pool &) = delete;
+   Pool & operator = (const Pool &) = delete;
+
+   void * allocate();
+   void   deallocate(void * p);
+
+   // statistics
+   size_t getSizeSlot()      const { return sizeSlot;       }
+   size_t getBlocks()        const { return blocks.size();  }
+   long   getAllocations()   const { return numAllocations; }
+   long   getInUse()         const { return numInUse;       }
+   long   getPeak()          const { return numPeak;        }
+
+private:
+   struct Slot
+   {
+      Slot * pNext;
+   };
+
+   size_t sizeSlot;
+   size_t slotsPerBlock;
+   std::vector <char *> blocks;
+   Slot * pFree;            // the slots nobody is using
+   long   numAllocations;
+   long   numInUse;
+   long   numPeak;
+};
+
+/***************************************************
+ * POOL ALLOCATOR
+ * Lets a standard container get its memory from a
+ * Pool. Anything bigger than a slot, or any request
+ * made without a pool, goes to the heap
+ ***************************************************/
+template <class T>
+class PoolAllocator
+{
+public:
+   typedef T value_type;
+
+   PoolAllocator() : pPool(nullptr)                             {}
+   PoolAllocator(Pool & pool) : pPool(&pool)                    {}
+   template <class U>
+   PoolAllocator(const PoolAllocator<U> & rhs) : pPool(rhs.pPool) {}
+
+   T * allocate(size_t n)
+   {
+      if (pPool && n * sizeof(T) <= pPool->getSizeSlot())
+         return (T *)pPool->allocate();
+      return (T *)::operator new(n * sizeof(T));
+   }
+   void deallocate(T * p, size_t n)
+   {
+      if (pPool && n * sizeof(T) <= pPool->getSizeSlot())
+         pPool->deallocate(p);
+      else
+         ::operator delete(p);
+   }
+
+   template <class U>
+   bool operator == (const PoolAllocator<U> & rhs) const { return pPool == rhs.pPool; }
+   template <class U>
+   bool operator != (const PoolAllocator<U> & rhs) const { return pPool != rhs.pPool; }
+
+   Pool * pPool;
+};
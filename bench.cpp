@@ -0,0 +1,462 @@
+/***********************************************************************
+ * Source File:
+ *    BENCH
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The benchmark runner. The primitives (Position, Move, Board, Knight)
+ *    go through the harness and can be saved as JSON; the search gets a
+ *    fixed amount of time and we report how deep it got.
+ ************************************************************************/
+
+#include "bench.h"
+#include "board.h"
+#include "boardState.h"
+#include "search.h"
+#include "timeManager.h"
+#include "nnue.h"
+#include "position.h"
+#include "pieceKnight.h"
+#include "benchHarness.h"
+#include "allocCount.h"
+#include "trace.h"
+#include "perfCounters.h"
+#include <fstream>    // for OFSTREAM
+#include <set>        // for SET of moves
+#include <vector>     // for VECTOR of states
+#include <memory>     // for UNIQUE_PTR of the perft boards
+#include <iostream>   // for COUT
+#include <iomanip>    // for SETW
+#include <chrono>     // for STEADY_CLOCK
+#include <string>     // for STRING
+using namespace std;
+
+const double MS_BENCH_SEARCH = 1000.0;   // time for each configuration
+const int    DEPTH_MAX       = 60;       // deeper than we will ever get
+const long   OPS_PRIMITIVE   = 100000;   // operations per repetition
+
+/*****************************************************************
+ * BENCH POSITION
+ * Parsing "e4" and moving a position by a Delta
+ ****************************************************************/
+static void benchPosition(BenchHarness & harness)
+{
+   const char * texts[] = { "a1", "e4", "h8", "d5", "g7", "b2", "c6", "f3" };
+   const string strings[] = { "a1", "e4", "h8", "d5", "g7", "b2", "c6", "f3" };
+
+   harness.run("position_parse_chars", OPS_PRIMITIVE, [&](long ops)
+   {
+      for (long i = 0; i < ops; i++)
+      {
+         Position pos(texts[i & 7]);
+         doNotOptimize(pos);
+      }
+   });
+
+   harness.run("position_parse_string", OPS_PRIMITIVE, [&](long ops)
+   {
+      Position pos;
+      for (long i = 0; i < ops; i++)
+      {
+         pos = strings[i & 7];
+         doNotOptimize(pos);
+      }
+   });
+
+   const Delta deltas[] = { ADD_R, ADD_C, SUB_R, SUB_C,
+                            { 2, 1 }, { 1, 2 }, { -2, -1 }, { -1, -2 } };
+   harness.run("position_add_delta", OPS_PRIMITIVE, [&](long ops)
+   {
+      Position pos(3, 3);
+      for (long i = 0; i < ops; i++)
+      {
+         Position posDest(pos, deltas[i & 7]);
+         doNotOptimize(posDest);
+      }
+   });
+}
+
+/*****************************************************************
+ * BENCH MOVE
+ * Reading and writing Smith notation
+ ****************************************************************/
+static void benchMove(BenchHarness & harness)
+{
+   const string smiths[] = { "e5c6r", "g1f3", "b8c6", "e7e8Q",
+                             "e1g1c", "d5e6E", "a7b8nQ", "h2h4" };
+
+   harness.run("move_parse_smith", OPS_PRIMITIVE, [&](long ops)
+   {
+      for (long i = 0; i < ops; i++)
+      {
+         Move move(smiths[i & 7]);
+         doNotOptimize(move);
+      }
+   });
+
+   Move moves[8];
+   for (int i = 0; i < 8; i++)
+      moves[i] = Move(smiths[i]);
+   harness.run("move_format_smith", OPS_PRIMITIVE, [&](long ops)
+   {
+      for (long i = 0; i < ops; i++)
+      {
+         Move & move = moves[i & 7];
+         string text = move.getText(move.getSource(), move.getDest(),
+                                    move.getMoveType(), move.getCapture(),
+                                    move.getPromote());
+         doNotOptimize(text);
+      }
+   });
+}
+
+/*****************************************************************
+ * BENCH BOARD
+ * Looking up a square, and generating knight moves
+ ****************************************************************/
+static void benchBoard(BenchHarness & harness)
+{
+   Board board;
+   Position squares[64];
+   for (int i = 0; i < 64; i++)
+      squares[i] = Position(i % 8, i / 8);
+
+   harness.run("board_square", OPS_PRIMITIVE, [&](long ops)
+   {
+      const Board & boardConst = board;
+      for (long i = 0; i < ops; i++)
+      {
+         PieceType pt = boardConst[squares[i & 63]].getType();
+         doNotOptimize(pt);
+      }
+   });
+
+   const Piece & knight = board[Position(6, 0)];   // g1
+   harness.run("knight_get_moves", OPS_PRIMITIVE / 10, [&](long ops)
+   {
+      for (long i = 0; i < ops; i++)
+      {
+         set <Move> moves;
+         knight.getMoves(moves, board);
+         doNotOptimize(moves);
+      }
+   });
+}
+
+/*****************************************************************
+ * BENCH ALLOC
+ * Where does the memory come from? The board makes its pieces
+ * in its arena and the search takes its move lists from a pool,
+ * so we report how much of each they used. Built with ALLOC_COUNT,
+ * an explicit switch that is off in the default bench build, we
+ * also count every new, per move generated and per search node.
+ * The counts go in with the timings so a change that starts
+ * allocating on a hot path shows up in the JSON.
+ ****************************************************************/
+static void benchAlloc(BenchHarness & harness)
+{
+   // move generation from the starting position, the way the search
+   // does it and the way the pieces do it
+   Board board;
+   Pool pool(256 * sizeof(Move));
+   long numMoves = 0;
+   AllocStats before = allocStats();
+   for (int i = 0; i < 1000; i++)
+   {
+      MoveList moves(PoolAllocator <Move> {pool});
+      moves.reserve(256);
+      board.getMoves(moves, true /*isWhite*/);
+      numMoves += (long)moves.size();
+   }
+   AllocStats movegenList = allocStats() - before;
+   before = allocStats();
+   for (int i = 0; i < 1000; i++)
+   {
+      set <Move> moves;
+      board.getMoves(moves, true /*isWhite*/);
+   }
+   AllocStats movegenSet = allocStats() - before;
+
+   // a short search, counting the pieces made along the way
+   Counted<Piece>::counts().reset();
+   Search search(board);
+   before = allocStats();
+   search.think(DEPTH_MAX, MS_BENCH_SEARCH / 4.0);
+   AllocStats think = allocStats() - before;
+   long nodes = search.getNodes();
+
+   harness.count("board_arena_bytes",  (double)board.getArena().getBytesUsed());
+   harness.count("board_arena_blocks", (double)board.getArena().getBlocks());
+   harness.count("search_pool_peak_lists", (double)search.getPool().getPeak());
+   harness.count("search_pool_blocks",     (double)search.getPool().getBlocks());
+   harness.count("search_pool_lists_per_node",
+                 nodes ? (double)search.getPool().getAllocations() / nodes : 0.0);
+
+   if (!allocCountEnabled())
+   {
+      cout << "allocations   :\tnot counted, build with ALLOC_COUNT (/p:AllocCount=true)\n";
+      return;
+   }
+   harness.count("alloc_per_move_generated",
+                 numMoves ? (double)movegenList.numNew / numMoves : 0.0);
+   harness.count("alloc_per_move_in_set",
+                 numMoves ? (double)movegenSet.numNew / numMoves : 0.0);
+   harness.count("alloc_per_search_node",
+                 nodes ? (double)think.numNew / nodes : 0.0);
+   harness.count("bytes_per_search_node",
+                 nodes ? (double)think.numBytes / nodes : 0.0);
+   harness.count("pieces_per_search_node",
+                 nodes ? (double)(Counted<Piece>::counts().numConstruct +
+                                  Counted<Piece>::counts().numCopy) / nodes : 0.0);
+}
+
+/*****************************************************************
+ * BENCH PERFT
+ * Copy-make against make/unmake: count the same trees both ways.
+ * The times are per node so the two can be compared directly,
+ * and each position's count is checked so a bug in either one
+ * cannot make it look faster.
+ ****************************************************************/
+static void benchPerft(BenchHarness & harness)
+{
+   struct Perft
+   {
+      const char * fen;
+      int depth;
+   } suite[] =
+   {
+      { "1n4n1/8/8/8/8/8/8/1N4N1 w - - 0 1",        4 },   // the start
+      { "8/8/2n1n3/8/3N4/8/1N3n2/8 w - - 0 1",      4 },   // captures
+      { "n6n/8/8/3NN3/3nn3/8/8/N6N b - - 0 1",      3 },   // crowded
+      { "8/1n4n1/8/3N4/4n3/8/1N4N1/8 b - - 0 20",   4 }    // middlegame
+   };
+
+   // the trees, counted once. Make/unmake leaves each board as it
+   // found it, so the boards are set up here and not in the timing
+   long nodes = 0;
+   vector <unique_ptr <Board>> boards;
+   vector <BoardState> states;
+   for (const Perft & perft : suite)
+   {
+      boards.emplace_back(new Board);
+      Board & board = *boards.back();
+      board.setFen(perft.fen);
+      BoardState state;
+      state.set(board);
+      long nodesCopy = perftCopyMake(state, perft.depth);
+      long nodesMake = perftMakeUnmake(board, perft.depth);
+      if (nodesCopy != nodesMake)
+         cout << "perft mismatch on " << perft.fen << ": copy-make "
+              << nodesCopy << ", make/unmake " << nodesMake << "\n";
+      nodes += nodesMake;
+      states.push_back(state);
+   }
+
+   // one pass over the suite already does the nodes operations we
+   // told the harness about, so the passes ignore ops
+   harness.run("perft_make_unmake", nodes, [&](long /*ops*/)
+   {
+      long sum = 0;
+      for (size_t i = 0; i < boards.size(); i++)
+         sum += perftMakeUnmake(*boards[i], suite[i].depth);
+      doNotOptimize(sum);
+   });
+
+   harness.run("perft_copy_make", nodes, [&](long /*ops*/)
+   {
+      long sum = 0;
+      for (size_t i = 0; i < states.size(); i++)
+         sum += perftCopyMake(states[i], suite[i].depth);
+      doNotOptimize(sum);
+   });
+
+   harness.count("perft_nodes", (double)nodes);
+   harness.count("board_state_bytes", (double)sizeof(BoardState));
+}
+
+/*****************************************************************
+ * BENCH SEARCH
+ * How deep can the search get in a fixed amount of time
+ * with null-move pruning and late-move reductions on and off?
+ * With hardware counters, how well does it use the CPU?
+ ****************************************************************/
+static void benchSearch(PerfCounters & perf)
+{
+   struct Config
+   {
+      const char * name;
+      bool useNullMove;
+      bool useLateMoveReductions;
+   } configs[] =
+   {
+      { "plain",       false, false },
+      { "null move",   true,  false },
+      { "lmr",         false, true  },
+      { "null + lmr",  true,  true  }
+   };
+
+   for (const Config & config : configs)
+   {
+      Board board;
+      Search search(board);
+      search.useNullMove = config.useNullMove;
+      search.useLateMoveReductions = config.useLateMoveReductions;
+
+      perf.start();
+      Move move = search.think(DEPTH_MAX, MS_BENCH_SEARCH);
+      perf.stop();
+
+      // the start position has no pawns, so there is no hit rate
+      // to give until the board can hold one
+      cout << left << setw(15) << config.name << ":\t"
+           << "depth " << search.getDepth()
+           << " in " << MS_BENCH_SEARCH << "ms, "
+           << search.getNodes() << " nodes, ";
+      if (search.getPawnProbes() > 0)
+         cout << "pawn hits " << (int)(search.getPawnHitRate() * 100.0) << "%, ";
+      else
+         cout << "no pawns, ";
+      cout << "best " << move.getText() << "\n";
+
+      long nodes = search.getNodes();
+      if (perf.getIpc() >= 0.0)
+         cout << "\t\tipc " << setprecision(2) << fixed << perf.getIpc();
+      for (int i = COUNTER_L1D_MISSES; i < COUNTER_NUM; i++)
+         if (perf.get((Counter)i) >= 0 && nodes > 0)
+            cout << ", " << PerfCounters::getName((Counter)i) << "/node "
+                 << setprecision(2) << fixed << (double)perf.get((Counter)i) / nodes;
+      if (perf.isAvailable())
+         cout << defaultfloat << "\n";
+   }
+}
+
+/*****************************************************************
+ * BENCH CLOCK
+ * How much time does the time manager hand out for a few
+ * common time controls, and how much does the search use?
+ ****************************************************************/
+static void benchClock()
+{
+   struct Clock
+   {
+      const char * name;
+      double msRemaining;
+      double msIncrement;
+      int    movesToGo;
+   } clocks[] =
+   {
+      { "10s",       10000.0,    0.0,  0 },
+      { "30s+0.5s",  30000.0,  500.0,  0 },
+      { "40/60s",    60000.0,    0.0, 40 }
+   };
+
+   for (const Clock & clock : clocks)
+   {
+      Board board;
+      Search search(board);
+      TimeManager timeManager;
+      timeManager.start(clock.msRemaining, clock.msIncrement, clock.movesToGo);
+      double msSoft = timeManager.getSoft();
+
+      search.think(DEPTH_MAX, timeManager);
+
+      cout << left << setw(15) << clock.name << ":\t"
+           << "soft " << msSoft << "ms, hard " << timeManager.getHard()
+           << "ms, used " << timeManager.elapsed() << "ms, depth "
+           << search.getDepth() << "\n";
+   }
+}
+
+/*****************************************************************
+ * BENCH NNUE
+ * How many network evaluations per second with each kernel
+ * this CPU can run? An evaluation here is what the search
+ * does at a node: make a move, evaluate, take it back.
+ ****************************************************************/
+static void benchNnue()
+{
+   const int EVALS = 200000;
+   const char * kernels[] = { "scalar", "sse4.1", "avx2" };
+   string best = Network::getKernel();
+
+   Network network;
+   network.randomize(1);
+
+   for (const char * kernel : kernels)
+   {
+      if (!Network::setKernel(kernel))
+      {
+         cout << left << setw(15) << kernel << ":\tnot supported\n";
+         continue;
+      }
+
+      Board board;
+      board.setNetwork(&network);
+      Move move(Position(6, 0), Position(5, 2));   // g1f3
+
+      long sum = 0;
+      auto start = chrono::steady_clock::now();
+      for (int i = 0; i < EVALS; i++)
+      {
+         board.move(move);
+         sum += board.evaluate();
+         board.undo();
+      }
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+      cout << left << setw(15) << kernel << ":\t"
+           << (long)(EVALS / seconds) << " evals/second"
+           << (best == kernel ? " (default)" : "")
+           << " [" << sum / EVALS << "]\n";
+      board.setNetwork(nullptr);
+   }
+
+   Network::setKernel(best.c_str());
+}
+
+/*****************************************************************
+ * BENCH RUNNER
+ * Runs all the benchmarks
+ ****************************************************************/
+void benchRunner(const char * fileJson, int cpu, const char * fileTrace)
+{
+   BenchHarness harness;
+   if (cpu >= 0 && !harness.pinToCpu(cpu))
+      cout << "cannot pin to cpu " << cpu << "\n";
+
+   // opened after pinning, since they count for this thread
+   PerfCounters perf;
+   if (perf.isAvailable())
+      harness.setPerfCounters(&perf);
+   else
+      cout << "hardware counters not available, timing only\n";
+
+   benchPosition(harness);
+   benchMove(harness);
+   benchBoard(harness);
+   benchAlloc(harness);
+   benchPerft(harness);
+   harness.writeText(cout);
+   if (fileJson)
+   {
+      ofstream fout(fileJson);
+      harness.writeJson(fout);
+      if (fout.fail())
+         cout << "cannot write " << fileJson << "\n";
+   }
+
+   benchSearch(perf);
+   benchClock();
+   benchNnue();
+
+   // the last few thousand scopes of each thread, from the searches
+   if (fileTrace)
+   {
+      if (!traceEnabled())
+         cout << "nothing traced, build with TRACE\n";
+      ofstream fout(fileTrace);
+      traceWrite(fout);
+      if (fout.fail())
+         cout << "cannot write " << fileTrace << "\n";
+   }
+}
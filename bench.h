@@ -0,0 +1,16 @@
+/***********************************************************************
+ * Header File:
+ *    BENCH
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The benchmark runner
+ ************************************************************************/
+
+#pragma once
+
+// run every benchmark. Write the primitives' results to fileJson if it
+// is not null, pin to a cpu if it is not -1, and write what was traced
+// to fileTrace if it is not null
+void benchRunner(const char * fileJson = nullptr, int cpu = -1,
+                 const char * fileTrace = nullptr);
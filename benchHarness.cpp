@@ -0,0 +1,170 @@
+/***********************************************************************
+ * Source File:
+ *    BENCH HARNESS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Time small pieces of code and report nanoseconds per operation
+ ************************************************************************/
+
+#include "benchHarness.h"
+#include <algorithm>   // for SORT
+#include <iomanip>     // for SETW
+#include <cassert>
+#ifdef _WIN32
+#include <windows.h>   // for SETTHREADAFFINITYMASK
+#elif defined(__linux__)
+#include <sched.h>     // for SCHED_SETAFFINITY
+#endif
+using namespace std;
+
+/*************************************************
+ * BENCH HARNESS : CONSTRUCT
+ *************************************************/
+BenchHarness::BenchHarness(int numWarmup, int numReps) :
+   numWarmup(numWarmup),
+   numReps(numReps),
+   cpu(-1),
+   pPerf(nullptr)
+{
+   assert(numReps > 0);
+}
+
+/*************************************************
+ * BENCH HARNESS : PIN TO CPU
+ *************************************************/
+bool BenchHarness::pinToCpu(int cpu)
+{
+   if (cpu < 0)
+      return false;
+#ifdef _WIN32
+   if (cpu >= (int)(sizeof(DWORD_PTR) * 8) ||
+       SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) == 0)
+      return false;
+#elif defined(__linux__)
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   CPU_SET(cpu, &set);
+   if (sched_setaffinity(0, sizeof(set), &set) != 0)
+      return false;
+#else
+   return false;
+#endif
+   this->cpu = cpu;
+   return true;
+}
+
+/*************************************************
+ * BENCH HARNESS : PERCENTILE
+ * Nearest rank, p from 0 to 100
+ *************************************************/
+double BenchHarness::percentile(const vector <double> & sorted, double p)
+{
+   assert(!sorted.empty());
+   size_t i = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+   return sorted[min(i, sorted.size() - 1)];
+}
+
+/*************************************************
+ * BENCH HARNESS : RECORD
+ *************************************************/
+const BenchResult & BenchHarness::record(const char * name, long ops,
+                                         vector <double> & nsPerOp)
+{
+   sort(nsPerOp.begin(), nsPerOp.end());
+   BenchResult result;
+   result.name     = name;
+   result.ops      = ops;
+   result.reps     = (int)nsPerOp.size();
+   result.nsMin    = nsPerOp.front();
+   result.nsP10    = percentile(nsPerOp, 10.0);
+   result.nsMedian = percentile(nsPerOp, 50.0);
+   result.nsP90    = percentile(nsPerOp, 90.0);
+   result.nsMax    = nsPerOp.back();
+
+   // the counters ran across every timed repetition
+   double opsTotal = (double)ops * result.reps;
+   for (int i = 0; i < COUNTER_NUM; i++)
+   {
+      long long value = pPerf ? pPerf->get((Counter)i) : -1;
+      result.perOp[i] = value < 0 ? -1.0 : (double)value / opsTotal;
+   }
+   result.ipc = pPerf ? pPerf->getIpc() : -1.0;
+   results.push_back(result);
+   return results.back();
+}
+
+/*************************************************
+ * BENCH HARNESS : COUNT
+ *************************************************/
+void BenchHarness::count(const char * name, double value)
+{
+   counters.push_back(BenchCounter{ name, value });
+}
+
+/*************************************************
+ * BENCH HARNESS : WRITE TEXT
+ *************************************************/
+void BenchHarness::writeText(ostream & out) const
+{
+   ios::fmtflags flags = out.flags();
+   streamsize precision = out.precision();
+   out << fixed << setprecision(2);
+   for (const BenchResult & result : results)
+   {
+      out << left << setw(28) << result.name << ":\t"
+          << setw(10) << right << result.nsMedian << " ns/op  (p10 "
+          << result.nsP10 << ", p90 " << result.nsP90 << ")";
+      if (result.ipc >= 0.0)
+         out << "  ipc " << result.ipc;
+      for (int i = COUNTER_L1D_MISSES; i < COUNTER_NUM; i++)
+         if (result.perOp[i] >= 0.0)
+            out << ", " << PerfCounters::getName((Counter)i) << "/op "
+                << result.perOp[i];
+      out << "\n";
+   }
+   for (const BenchCounter & counter : counters)
+      out << left << setw(28) << counter.name << ":\t"
+          << setw(10) << right << counter.value << "\n";
+   out.flags(flags);
+   out.precision(precision);
+}
+
+/*************************************************
+ * BENCH HARNESS : WRITE JSON
+ * The names are ours, so they need no escaping
+ *************************************************/
+void BenchHarness::writeJson(ostream & out) const
+{
+   ios::fmtflags flags = out.flags();
+   streamsize precision = out.precision();
+   out << fixed << setprecision(3);
+   out << "{\n  \"cpu\": " << cpu << ",\n  \"results\": [\n";
+   for (size_t i = 0; i < results.size(); i++)
+   {
+      const BenchResult & result = results[i];
+      out << "    { \"name\": \"" << result.name << "\""
+          << ", \"ops\": "       << result.ops
+          << ", \"reps\": "      << result.reps
+          << ", \"ns_min\": "    << result.nsMin
+          << ", \"ns_p10\": "    << result.nsP10
+          << ", \"ns_median\": " << result.nsMedian
+          << ", \"ns_p90\": "    << result.nsP90
+          << ", \"ns_max\": "    << result.nsMax;
+      if (result.ipc >= 0.0)
+         out << ", \"ipc\": " << result.ipc;
+      for (int c = 0; c < COUNTER_NUM; c++)
+         if (result.perOp[c] >= 0.0)
+            out << ", \"" << PerfCounters::getName((Counter)c) << "_per_op\": "
+                << result.perOp[c];
+      out << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+   }
+   out << "  ],\n  \"counters\": [\n";
+   for (size_t i = 0; i < counters.size(); i++)
+      out << "    { \"name\": \"" << counters[i].name << "\""
+          << ", \"value\": " << counters[i].value
+          << " }" << (i + 1 < counters.size() ? "," : "") << "\n";
+   out << "  ]\n}\n";
+   out.flags(flags);
+   out.precision(precision);
+}
@@ -0,0 +1,132 @@
+/***********************************************************************
+ * Header File:
+ *    BENCH HARNESS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Time small pieces of code: a few warmup runs, then many timed
+ *    repetitions, reported as the median and percentiles of the
+ *    nanoseconds per operation. Given hardware counters, it also reports
+ *    the instructions per cycle and the misses per operation. Results
+ *    can be written as JSON so two runs can be compared.
+ ************************************************************************/
+
+#pragma once
+
+#include <string>     // for STRING
+#include <vector>     // for VECTOR of results
+#include <iostream>   // for OSTREAM
+#include <chrono>     // for STEADY_CLOCK
+#include "perfCounters.h"
+
+class TestBenchHarness;
+
+/***************************************************
+ * DO NOT OPTIMIZE
+ * Keep the compiler from throwing away a result we
+ * computed only so we could time it
+ ***************************************************/
+template <class T>
+inline void doNotOptimize(const T & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   asm volatile("" : : "r,m"(value) : "memory");
+#else
+   static volatile const T * pSink;
+   pSink = &value;
+#endif
+}
+
+/***************************************************
+ * BENCH RESULT
+ * Nanoseconds per operation for one benchmark
+ ***************************************************/
+struct BenchResult
+{
+   std::string name;
+   long   ops;          // operations in each repetition
+   int    reps;         // timed repetitions
+   double nsMin;
+   double nsP10;
+   double nsMedian;
+   double nsP90;
+   double nsMax;
+   double perOp[COUNTER_NUM];   // hardware counts per operation, -1 if not counted
+   double ipc;                  // instructions per cycle, -1 if not counted
+};
+
+/***************************************************
+ * BENCH COUNTER
+ * A number that is not a time, such as allocations
+ * per search node
+ ***************************************************/
+struct BenchCounter
+{
+   std::string name;
+   double value;
+};
+
+/***************************************************
+ * BENCH HARNESS
+ * Run benchmarks and collect their results
+ ***************************************************/
+class BenchHarness
+{
+   friend TestBenchHarness;
+public:
+   BenchHarness(int numWarmup = 3, int numReps = 21);
+
+   // run only on this CPU so the scheduler does not move us around.
+   // Returns false if we cannot, in which case nothing changes
+   bool pinToCpu(int cpu);
+   int  getCpu() const { return cpu; }
+
+   // count the timed repetitions with these, if they are available
+   void setPerfCounters(PerfCounters * pPerf) { this->pPerf = pPerf; }
+
+   // time run(ops) which must do ops operations
+   template <class F>
+   const BenchResult & run(const char * name, long ops, F run)
+   {
+      for (int i = 0; i < numWarmup; i++)
+         run(ops);
+
+      std::vector <double> nsPerOp;
+      if (pPerf)
+         pPerf->start();
+      for (int i = 0; i < numReps; i++)
+      {
+         auto start = std::chrono::steady_clock::now();
+         run(ops);
+         auto end = std::chrono::steady_clock::now();
+         nsPerOp.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+      }
+      if (pPerf)
+         pPerf->stop();
+      return record(name, ops, nsPerOp);
+   }
+
+   const std::vector <BenchResult> & getResults() const { return results; }
+
+   // remember a counter so it is reported with the timings
+   void count(const char * name, double value);
+   const std::vector <BenchCounter> & getCounters() const { return counters; }
+
+   // one line per benchmark, for people
+   void writeText(std::ostream & out) const;
+
+   // { "cpu": .., "results": [ { "name": .., "ns_median": .., ... } ],
+   //   "counters": [ { "name": .., "value": .. } ] }
+   void writeJson(std::ostream & out) const;
+
+private:
+   const BenchResult & record(const char * name, long ops, std::vector <double> & nsPerOp);
+   static double percentile(const std::vector <double> & sorted, double p);
+
+   int numWarmup;
+   int numReps;
+   int cpu;                  // -1 when we are not pinned
+   PerfCounters * pPerf;     // null when we only time
+   std::vector <BenchResult> results;
+   std::vector <BenchCounter> counters;
+};
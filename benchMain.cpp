@@ -0,0 +1,42 @@
+/**********************************************************************
+* Source File:
+*    BENCH MAIN
+* Author:
+*    <your name here>
+* Summary:
+*    Run the benchmarks without starting the game:
+*       bench [--json results.json] [--cpu 2] [--trace trace.json]
+************************************************************************/
+
+#include "bench.h"      // for BENCH RUNNER
+#include <cstdlib>      // for ATOI
+#include <cstring>      // for STRCMP
+#include <iostream>     // for CERR
+using namespace std;
+
+/*********************************
+ * MAIN - Where it all begins...
+ *********************************/
+int main(int argc, char** argv)
+{
+   const char * fileJson = nullptr;
+   int cpu = -1;
+   const char * fileTrace = nullptr;
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+         fileJson = argv[++i];
+      else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc)
+         cpu = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+         fileTrace = argv[++i];
+      else
+      {
+         cerr << "usage: " << argv[0] << " [--json results.json] [--cpu n] [--trace trace.json]\n";
+         return 1;
+      }
+   }
+
+   benchRunner(fileJson, cpu, fileTrace);
+   return 0;
+}
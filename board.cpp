@@ -13,9 +13,20 @@
 #include "piece.h"
 #include "pieceSpace.h"
 #include "pieceKnight.h"
+#include "pieceFlyweight.h"
+#include "arena.h"
+#include "evaluate.h"
+#include "nnue.h"
+#include "zobrist.h"
+#include "trace.h"
+#include <cstdlib>     // for ATOI
+#include <cctype>      // for TOUPPER
 #include <cassert>
 using namespace std;
 
+// enough for a board full of pieces in one block
+const size_t SIZE_ARENA_BLOCK = 8192;
+
 /***********************************************
  * BOARD : RESET
  *         Just fill the board with the known pieces
@@ -35,60 +46,517 @@ using namespace std;
 void Board::reset(bool fFree)
 {
 	// free everything
+	if (fFree)
+		free();
+
+	// the knights on their starting squares, spaces everywhere else
 	for (int r = 0; r < 8; r++)
 		for (int c = 0; c < 8; c++)
-			board[c][r] = nullptr;
+			if ((r == 0 || r == 7) && (c == 1 || c == 6))
+				board[c][r] = new (arena) Knight(c, r, r == 0 /*isWhite*/);
+			else
+				board[c][r] = new (arena) Space(c, r);
+
+	numMoves = 0;
+	rescore();
+	assertBoard();
 }
 
-// we really REALLY need to delete this. 
-//Space space;
+/***********************************************
+ * BOARD : SET FEN
+ *         Set up the board from Forsyth-Edwards Notation:
+ *         "1n4n1/8/8/8/8/8/8/1N4N1 w - - 0 1". Only the
+ *         piece placement, side to move, and move number
+ *         are used. Returns false, leaving the board alone,
+ *         if the text is malformed or has a piece we have
+ *         no class for.
+ ***********************************************/
+bool Board::setFen(const string& fen)
+{
+	// piece placement: rank 8 first, a-file first
+	char squares[8][8];
+	int c = 0;
+	int r = 7;
+	size_t i = 0;
+	for (; i < fen.size() && fen[i] != ' '; i++)
+	{
+		char ch = fen[i];
+		if (ch == '/')
+		{
+			if (c != 8 || r == 0)
+				return false;
+			c = 0;
+			r--;
+		}
+		else if ('1' <= ch && ch <= '8')
+		{
+			for (int n = ch - '0'; n > 0; n--, c++)
+				if (c < 8)
+					squares[c][r] = ' ';
+			if (c > 8)
+				return false;
+		}
+		else if ((ch == 'N' || ch == 'n') && c < 8)
+			squares[c++][r] = ch;
+		else
+			return false;
+	}
+	if (c != 8 || r != 0)
+		return false;
+
+	// side to move
+	while (i < fen.size() && fen[i] == ' ')
+		i++;
+	bool isWhite = true;
+	if (i < fen.size())
+	{
+		if (fen[i] != 'w' && fen[i] != 'b')
+			return false;
+		isWhite = (fen[i] == 'w');
+	}
+
+	// the move number is the last field, if it is there
+	int fullMove = 1;
+	size_t iLast = fen.find_last_of(' ');
+	if (iLast != string::npos && iLast > i)
+	{
+		fullMove = atoi(fen.c_str() + iLast + 1);
+		if (fullMove < 1)
+			fullMove = 1;
+	}
+
+	free();
+	for (r = 0; r < 8; r++)
+		for (c = 0; c < 8; c++)
+			if (squares[c][r] == ' ')
+				board[c][r] = new (arena) Space(c, r);
+			else
+				board[c][r] = new (arena) Knight(c, r, squares[c][r] == 'N' /*isWhite*/);
+
+	numMoves = (fullMove - 1) * 2 + (isWhite ? 0 : 1);
+	rescore();
+	assertBoard();
+	return true;
+}
+
+/***********************************************
+ * BOARD : GET FEN
+ *         The board as setFen() reads it. We know no
+ *         castling or en-passant, so those are "-"
+ ***********************************************/
+string Board::getFen() const
+{
+	const char letters[] = "??kqrbnp";
+	string fen;
+	for (int r = 7; r >= 0; r--)
+	{
+		int numSpaces = 0;
+		for (int c = 0; c < 8; c++)
+		{
+			uint8_t code = squares[r * 8 + c];
+			PieceType pt = squareType(code);
+			if (pt < KING)
+			{
+				numSpaces++;
+				continue;
+			}
+			if (numSpaces)
+				fen += (char)('0' + numSpaces);
+			numSpaces = 0;
+			char letter = letters[pt];
+			fen += squareWhite(code) ? (char)toupper(letter) : letter;
+		}
+		if (numSpaces)
+			fen += (char)('0' + numSpaces);
+		if (r > 0)
+			fen += '/';
+	}
+	fen += whiteTurn() ? " w - - 0 " : " b - - 0 ";
+	fen += to_string(numMoves / 2 + 1);
+	return fen;
+}
 
 /***********************************************
 * BOARD : GET
 *         Get a piece from a given position.
 ***********************************************/
-//const Piece& Board::operator [] (const Position& pos) const
-//{
-//   return space;
-//}
-//Piece& Board::operator [] (const Position& pos)
-//{
-//   return space;
-//}
-Piece& Board::operator[](const Position& pos) {
+Piece& Board::operator[](const Position& pos)
+{
+	assert(0 <= pos.getCol() && pos.getCol() < 8);
+	assert(0 <= pos.getRow() && pos.getRow() < 8);
+	assert(board[pos.getCol()][pos.getRow()] != nullptr);
+	return *board[pos.getCol()][pos.getRow()];
+}
+const Piece& Board::operator[](const Position& pos) const
+{
+	assert(0 <= pos.getCol() && pos.getCol() < 8);
+	assert(0 <= pos.getRow() && pos.getRow() < 8);
+	assert(board[pos.getCol()][pos.getRow()] != nullptr);
+	return *board[pos.getCol()][pos.getRow()];
+}
 
-	if (pos.isValid()) {
-		assert(0 <= pos.getCol() && pos.getCol() < 8);
-		assert(0 <= pos.getRow() && pos.getRow() < 8);
-		return *board[pos.getCol()][pos.getRow()];  // Return reference to the Piece at the specified position
+/***********************************************
+ * BOARD : GET MOVES
+ *         All the possible moves for one side. These are
+ *         not checked for leaving the king in check. Only
+ *         the bytes are read, never the pieces
+ ***********************************************/
+void Board::getMoves(MoveList& moves, bool isWhite) const
+{
+	TRACE_SCOPE("movegen");
+	for (int square = 0; square < 64; square++)
+	{
+		uint8_t code = squares[square];
+		if (squareType(code) > SPACE && squareWhite(code) == isWhite)
+			PieceFlyweight::get(squareType(code)).getMoves(moves, squares, square, isWhite);
 	}
+}
+void Board::getMoves(set <Move>& moves, bool isWhite) const
+{
+	MoveList list;
+	getMoves(list, isWhite);
+	moves.insert(list.begin(), list.end());
+}
 
+/***********************************************
+ * BOARD : IS IN CHECK
+ *         Can the other side capture our king?
+ ***********************************************/
+bool Board::isInCheck(bool isWhite) const
+{
+	// asked at every node, so each thread keeps its list
+	thread_local MoveList moves;
+	moves.clear();
+	getMoves(moves, !isWhite);
+	for (const Move& move : moves)
+		if (move.getCapture() == KING)
+			return true;
+	return false;
 }
-const Piece& Board::operator[](const Position& pos) const {
-	if (pos.isValid()) {
-		assert(0 <= pos.getCol() && pos.getCol() < 8);
-		assert(0 <= pos.getRow() && pos.getRow() < 8);
-		return *board[pos.getCol()][pos.getRow()];  // Return const reference to the Piece at the specified position
+
+/***********************************************
+ * BOARD : HAS NON PAWN MATERIAL
+ *         Does this side have anything besides the king
+ *         and pawns? Without it, passing is often the best
+ *         move (zugzwang) so the search cannot assume it.
+ ***********************************************/
+bool Board::hasNonPawnMaterial(bool isWhite) const
+{
+	for (int square = 0; square < 64; square++)
+	{
+		PieceType pt = squareType(squares[square]);
+		if (pt > SPACE && pt != PAWN && pt != KING &&
+		    squareWhite(squares[square]) == isWhite)
+			return true;
 	}
+	return false;
 }
 
 /***********************************************
  * BOARD : DISPLAY
- *         Display the board
+ *         Draw the squares that changed: each one drawn
+ *         bottom to top, the square, the highlights,
+ *         then the piece, none reaching past its square.
+ *         Everything is drawn after a resize or a new
+ *         position
  ***********************************************/
 void Board::display(const Position& posHover, const Position& posSelect) const
 {
+	bool fAll;
+	uint64_t squaresDraw = takeDirty(posHover, posSelect, fAll);
+	if (!pgout || !squaresDraw)
+		return;
+
+	if (fAll)
+	{
+		pgout->drawBoard();
+		pgout->drawHover(posHover);
+		pgout->drawSelected(posSelect);
+		for (int square = 0; square < 64; square++)
+			if (possible & (1ull << square))
+				pgout->drawPossible(Position(square % 8, square / 8));
+		for (int r = 0; r < 8; r++)
+			for (int c = 0; c < 8; c++)
+				if (board[c][r])
+					board[c][r]->display(pgout);
+		return;
+	}
+
+	for (int square = 0; square < 64; square++)
+		if (squaresDraw & (1ull << square))
+		{
+			Position pos(square % 8, square / 8);
+			pgout->drawSquare(pos);
+			if (pos == posHover)
+				pgout->drawHover(pos);
+			if (pos == posSelect)
+				pgout->drawSelected(pos);
+			if (possible & (1ull << square))
+				pgout->drawPossible(pos);
+			if (board[pos.getCol()][pos.getRow()])
+				board[pos.getCol()][pos.getRow()]->display(pgout);
+		}
+}
+
+/***********************************************
+ * BOARD : MARK DIRTY
+ *         This square needs to be drawn again
+ ***********************************************/
+void Board::markDirty(const Position& pos) const
+{
+	if (pos.isValid())
+		dirty |= 1ull << (pos.getRow() * 8 + pos.getCol());
+}
+
+/***********************************************
+ * BOARD : TAKE DIRTY
+ *         The squares to draw this frame: what changed
+ *         since the last one, including the highlights.
+ *         fAll when all of it
+ ***********************************************/
+uint64_t Board::takeDirty(const Position& posHover, const Position& posSelect,
+                          bool& fAll) const
+{
+	if (posHover != posHoverLast)
+	{
+		markDirty(posHoverLast);
+		markDirty(posHover);
+		posHoverLast = posHover;
+	}
+	if (posSelect != posSelectLast)
+	{
+		markDirty(posSelectLast);
+		markDirty(posSelect);
+		posSelectLast = posSelect;
+	}
+
+	uint64_t squaresDraw = dirty;
+	dirty = 0;
+
+	fAll = fDrawAll;
+	fDrawAll = false;
+	return fAll ? ~0ull : squaresDraw;
+}
+
+/***********************************************
+ * BOARD : EVALUATE
+ *         Blend the middlegame and endgame sums by how
+ *         much material is left on the board
+ ***********************************************/
+int Board::evaluate() const
+{
+	if (pNetwork)
+	{
+		int value = pNetwork->evaluate(accumulators.back(), whiteTurn());
+		return whiteTurn() ? value : -value;
+	}
+	return taper(scoreMg, scoreEg, phase);
+}
+
+/***********************************************
+ * BOARD : SET NETWORK
+ *         Evaluate with a network instead of the tables.
+ *         The network must outlive the board.
+ ***********************************************/
+void Board::setNetwork(const Network* pNetwork)
+{
+	this->pNetwork = pNetwork;
+	rescore();
+}
+
+/***********************************************
+ * BOARD : RESCORE
+ *         Throw away the running sums and compute them
+ *         again, after the board was set up by hand
+ ***********************************************/
+void Board::rescore()
+{
+	markAllDirty();
+	encodeAll();
+	scoreAll(scoreMg, scoreEg, phase);
+
+	// every piece can be captured once, each leaving a space behind
+	size_t numPieces = 0;
+	for (int square = 0; square < 64; square++)
+		if (squareType(squares[square]) > SPACE)
+			numPieces++;
+	while (spaces.size() < numPieces)
+		spaces.push_back(new (arena) Space(0, 0));
+	keyPawn = pawnKey();
+
+	accumulators.clear();
+	if (pNetwork)
+	{
+		squareKing[0] = findKing(true  /*isWhite*/);
+		squareKing[1] = findKing(false /*isWhite*/);
+		accumulators.resize(1);
+		networkAll(accumulators.back());
+	}
+}
+
+/***********************************************
+ * BOARD : ENCODE ALL
+ *         One byte per square from the pieces
+ ***********************************************/
+void Board::encodeAll()
+{
+	for (int r = 0; r < 8; r++)
+		for (int c = 0; c < 8; c++)
+		{
+			const Piece* pPiece = board[c][r];
+			squares[r * 8 + c] = pPiece ?
+				squareCode(pPiece->getType(), pPiece->isWhite()) : (uint8_t)INVALID;
+		}
+}
+
+/***********************************************
+ * BOARD : FIND KING
+ *         The square (0...63, a1 is 0) of one side's king.
+ *         With no king we use its home square, e1 or e8,
+ *         so the network still works.
+ ***********************************************/
+int Board::findKing(bool isWhite) const
+{
+	for (int square = 0; square < 64; square++)
+		if (squares[square] == squareCode(KING, isWhite))
+			return square;
+	return isWhite ? 4 : 60;
+}
+
+/***********************************************
+ * BOARD : NETWORK ALL
+ *         Build the first layer of the network from scratch
+ ***********************************************/
+void Board::networkAll(Accumulator& acc) const
+{
+	assert(pNetwork);
+	for (int perspective = 0; perspective < 2; perspective++)
+	{
+		bool perspectiveWhite = (perspective == 0);
+		int features[64];
+		int num = 0;
+		for (int square = 0; square < 64; square++)
+		{
+			PieceType pt = squareType(squares[square]);
+			if (pt <= SPACE || pt == KING)
+				continue;
+			features[num++] = Network::feature(perspectiveWhite,
+				squareKing[perspective], pt, squareWhite(squares[square]), square);
+		}
+		pNetwork->refresh(acc, perspectiveWhite, features, num);
+	}
+}
+
+/***********************************************
+ * BOARD : NETWORK PIECE
+ *         Turn one piece's features on (sign = 1) or off
+ *         (sign = -1). Kings are not features; when one
+ *         moves, the whole accumulator is rebuilt.
+ ***********************************************/
+void Board::networkPiece(uint8_t code, int square, int sign)
+{
+	PieceType pt = squareType(code);
+	if (!pNetwork || pt <= SPACE || pt == KING)
+		return;
+
+	for (int perspective = 0; perspective < 2; perspective++)
+	{
+		bool perspectiveWhite = (perspective == 0);
+		int feature = Network::feature(perspectiveWhite, squareKing[perspective],
+			pt, squareWhite(code), square);
+		if (sign > 0)
+			pNetwork->addFeature(accumulators.back(), perspectiveWhite, feature);
+		else
+			pNetwork->subFeature(accumulators.back(), perspectiveWhite, feature);
+	}
+}
+
+/***********************************************
+ * BOARD : SCORE PIECE
+ *         Add (sign = 1) or remove (sign = -1) one piece
+ *         from the running evaluation sums
+ ***********************************************/
+void Board::scorePiece(uint8_t code, int square, int sign)
+{
+	PieceType pt = squareType(code);
+	if (pt <= SPACE)
+		return;
+
+	bool isWhite = squareWhite(code);
+	scoreMg += sign * pieceSquareMg(pt, isWhite, square % 8, square / 8);
+	scoreEg += sign * pieceSquareEg(pt, isWhite, square % 8, square / 8);
+	phase   += sign * piecePhase(pt);
+
+	// adding and removing are the same XOR
+	if (pt == PAWN)
+		keyPawn ^= zobristPiece(PAWN, isWhite, square);
+}
+
+/***********************************************
+ * BOARD : SCORE ALL
+ *         Compute the evaluation sums from scratch
+ ***********************************************/
+void Board::scoreAll(int& mg, int& eg, int& ph) const
+{
+	mg = eg = ph = 0;
+	for (int square = 0; square < 64; square++)
+	{
+		PieceType pt = squareType(squares[square]);
+		if (pt <= SPACE)
+			continue;
+		bool isWhite = squareWhite(squares[square]);
+		mg += pieceSquareMg(pt, isWhite, square % 8, square / 8);
+		eg += pieceSquareEg(pt, isWhite, square % 8, square / 8);
+		ph += piecePhase(pt);
+	}
+}
 
+/***********************************************
+ * BOARD : PAWN KEY
+ *         Compute the pawn hash from scratch
+ ***********************************************/
+uint64_t Board::pawnKey() const
+{
+	uint64_t key = 0;
+	for (int square = 0; square < 64; square++)
+		if (squareType(squares[square]) == PAWN)
+			key ^= zobristPiece(PAWN, squareWhite(squares[square]), square);
+	return key;
 }
 
+/***********************************************
+ * BOARD : GET PAWNS
+ *         Which squares have white and black pawns, one
+ *         bit per square (row * 8 + col)
+ ***********************************************/
+void Board::getPawns(uint64_t& pawnsWhite, uint64_t& pawnsBlack) const
+{
+	pawnsWhite = pawnsBlack = 0;
+	for (int square = 0; square < 64; square++)
+		if (squareType(squares[square]) == PAWN)
+			(squareWhite(squares[square]) ? pawnsWhite : pawnsBlack) |= 1ull << square;
+}
 
 /************************************************
  * BOARD : CONSTRUCT
  *         Free up all the allocated memory
  ************************************************/
-Board::Board(ogstream* pgout, bool noreset) : pgout(pgout), numMoves(0)
+Board::Board(ogstream* pgout, bool noreset) : numMoves(0),
+	arena(SIZE_ARENA_BLOCK), scoreMg(0), scoreEg(0), phase(0), keyPawn(0),
+	pNetwork(nullptr), dirty(0), fDrawAll(true),
+	posHoverLast(-1), posSelectLast(-1), possible(0), pgout(pgout)
 {
+	squareKing[0] = squareKing[1] = 0;
 
+	for (int r = 0; r < 8; r++)
+		for (int c = 0; c < 8; c++)
+		{
+			board[c][r] = nullptr;
+			squares[r * 8 + c] = INVALID;
+		}
+
+	if (!noreset)
+		reset(false /*fFree*/);
 }
 
 
@@ -98,7 +566,28 @@ Board::Board(ogstream* pgout, bool noreset) : pgout(pgout), numMoves(0)
  ************************************************/
 void Board::free()
 {
+	// the pieces on the board
+	for (int r = 0; r < 8; r++)
+		for (int c = 0; c < 8; c++)
+		{
+			delete board[c][r];
+			board[c][r] = nullptr;
+		}
 
+	// the pieces captured along the way
+	while (!history.empty())
+	{
+		delete history.top().pCaptured;
+		history.pop();
+	}
+
+	// and the spaces kept for the next capture
+	for (Piece* pSpace : spaces)
+		delete pSpace;
+	spaces.clear();
+
+	// the pieces we made are gone, so their memory can be used again
+	arena.reset();
 }
 
 
@@ -108,7 +597,38 @@ void Board::free()
  *********************************************/
 void Board::assertBoard()
 {
+#ifndef NDEBUG
+	for (int r = 0; r < 8; r++)
+		for (int c = 0; c < 8; c++)
+		{
+			if (board[c][r])
+				assert(board[c][r]->position == Position(c, r));
+			assert(squares[r * 8 + c] == (board[c][r] ?
+				squareCode(board[c][r]->getType(), board[c][r]->isWhite()) : (uint8_t)INVALID));
+		}
 
+	// the running sums must match a full recompute
+	int mg, eg, ph;
+	scoreAll(mg, eg, ph);
+	assert(mg == scoreMg);
+	assert(eg == scoreEg);
+	assert(ph == phase);
+	assert(pawnKey() == keyPawn);
+
+	// so must the network's first layer
+	if (pNetwork)
+	{
+		assert(squareKing[0] == findKing(true  /*isWhite*/));
+		assert(squareKing[1] == findKing(false /*isWhite*/));
+		Accumulator acc;
+		networkAll(acc);
+		for (int i = 0; i < NNUE_HIDDEN; i++)
+		{
+			assert(acc.values[0][i] == accumulators.back().values[0][i]);
+			assert(acc.values[1][i] == accumulators.back().values[1][i]);
+		}
+	}
+#endif // !NDEBUG
 }
 
 
@@ -119,7 +639,121 @@ void Board::assertBoard()
  *********************************************/
 void Board::move(const Move& move)
 {
+	TRACE_SCOPE("make");
+	Position posSrc  = move.getSource();
+	Position posDest = move.getDest();
+	int squareSrc  = posSrc.getRow()  * 8 + posSrc.getCol();
+	int squareDest = posDest.getRow() * 8 + posDest.getCol();
+	uint8_t codeMoving   = squares[squareSrc];
+	uint8_t codeCaptured = squares[squareDest];
+	assert(squareType(codeMoving) > SPACE && squareType(codeCaptured) != INVALID);
+
+	if (pNetwork)
+		accumulators.push_back(accumulators.back());
+
+	// the position: two bytes and the sums that follow them
+	scorePiece(codeMoving, squareSrc, -1);
+	networkPiece(codeMoving, squareSrc, -1);
+	scorePiece(codeCaptured, squareDest, -1);
+	networkPiece(codeCaptured, squareDest, -1);
+	squares[squareDest] = codeMoving;
+	squares[squareSrc]  = SPACE;
+	scorePiece(codeMoving, squareDest, 1);
+	networkPiece(codeMoving, squareDest, 1);
+
+	// every feature depends on the king square
+	if (pNetwork && (squareType(codeMoving) == KING || squareType(codeCaptured) == KING))
+	{
+		squareKing[0] = findKing(true  /*isWhite*/);
+		squareKing[1] = findKing(false /*isWhite*/);
+		networkAll(accumulators.back());
+	}
+
+	// the pieces follow. A simple move swaps the piece with the space
+	// it moves into. A capture keeps the captured piece around so we
+	// can undo, and leaves one of the spare spaces behind
+	Piece*& pSrc  = board[posSrc.getCol()][posSrc.getRow()];
+	Piece*& pDest = board[posDest.getCol()][posDest.getRow()];
+	assert(pSrc != nullptr && pDest != nullptr);
+	MoveRecord record{ move, codeCaptured, nullptr, pSrc->lastMove };
+	Piece* pMoving = pSrc;
+	if (squareType(codeCaptured) == SPACE)
+		pSrc = pDest;
+	else
+	{
+		assert(!spaces.empty());
+		record.pCaptured = pDest;
+		pSrc = spaces.back();
+		spaces.pop_back();
+	}
+	pSrc->position = posSrc;
+	pDest = pMoving;
+	pDest->position = posDest;
+	pDest->nMoves++;
+	pDest->lastMove = numMoves;
+	markDirty(posSrc);
+	markDirty(posDest);
+
+	history.push(record);
+	numMoves++;
+	assertBoard();
+}
 
+/**********************************************
+ * BOARD : UNDO
+ *         Take back the last move made with move()
+ *********************************************/
+void Board::undo()
+{
+	TRACE_SCOPE("unmake");
+	assert(!history.empty());
+	MoveRecord record = history.top();
+	history.pop();
+	numMoves--;
+
+	Position posSrc  = record.move.getSource();
+	Position posDest = record.move.getDest();
+	int squareSrc  = posSrc.getRow()  * 8 + posSrc.getCol();
+	int squareDest = posDest.getRow() * 8 + posDest.getCol();
+	uint8_t codeMoving = squares[squareDest];
+
+	// the position
+	scorePiece(codeMoving, squareDest, -1);
+	scorePiece(codeMoving, squareSrc, 1);
+	scorePiece(record.codeCaptured, squareDest, 1);
+	squares[squareSrc]  = codeMoving;
+	squares[squareDest] = record.codeCaptured;
+	if (pNetwork)
+	{
+		accumulators.pop_back();
+		if (squareType(codeMoving) == KING || squareType(record.codeCaptured) == KING)
+		{
+			squareKing[0] = findKing(true  /*isWhite*/);
+			squareKing[1] = findKing(false /*isWhite*/);
+		}
+	}
+
+	// the pieces, putting back whatever was on the destination
+	Piece*& pSrc  = board[posSrc.getCol()][posSrc.getRow()];
+	Piece*& pDest = board[posDest.getCol()][posDest.getRow()];
+	Piece* pMoving = pDest;
+	pMoving->position = posSrc;
+	pMoving->nMoves--;
+	pMoving->lastMove = record.lastMove;
+	if (record.pCaptured)
+	{
+		spaces.push_back(pSrc);
+		pDest = record.pCaptured;
+	}
+	else
+	{
+		pDest = pSrc;
+		pDest->position = posDest;
+	}
+	pSrc = pMoving;
+	markDirty(posSrc);
+	markDirty(posDest);
+	assertBoard();
 }
 
 /**********************************************
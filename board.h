@@ -9,9 +9,17 @@
 
 #pragma once
 
+#include <set>
 #include <stack>
+#include <vector>
+#include <string>
+#include <cstdint>
 #include <cassert>
 #include "move.h"   // Because we return a set of Move
+#include "nnue.h"   // for ACCUMULATOR
+#include "arena.h"  // for ARENA of pieces
+#include "pieceFlyweight.h"   // for MOVELIST
+#include "position.h"         // for POSITION of the highlights
 
 class ogstream;
 class TestPawn;
@@ -21,6 +29,8 @@ class TestRook;
 class TestQueen;
 class TestKing;
 class TestBoard;
+class TestSearch;
+class TestNnue;
 class Position;
 class Piece;
 
@@ -39,29 +49,115 @@ class Board
    friend TestQueen;
    friend TestKing;
    friend TestBoard;
+   friend TestSearch;
+   friend TestNnue;
 public:
 
    // create and destroy the board
    Board(ogstream* pgout = nullptr, bool noreset = false);
-   virtual ~Board()   {  }
+   virtual ~Board()   { free(); }
 
    // getters
-   virtual int  getCurrentMove() const { return -99;      }
-   virtual bool whiteTurn()      const { return false;  }
+   virtual int  getCurrentMove() const { return numMoves;           }
+   virtual bool whiteTurn()      const { return numMoves % 2 == 0;  }
    virtual void display(const Position& posHover, const Position& posSelect) const;
+   std::string getFen() const;         // what setFen() reads
    virtual const Piece& operator [] (const Position& pos) const;
+   virtual void getMoves(std::set <Move> & moves, bool isWhite) const;
+   void getMoves(MoveList & moves, bool isWhite) const;
+   virtual bool isInCheck(bool isWhite) const;
+   virtual bool hasNonPawnMaterial(bool isWhite) const;
+   virtual int  evaluate() const;      // white's point of view
+   virtual void setNetwork(const Network * pNetwork);   // nullptr for the tables
+   virtual bool hasNetwork()     const { return pNetwork != nullptr; }
+   virtual uint64_t getPawnKey() const { return keyPawn;            }
+   virtual int  getPhase()       const { return phase;              }
+   virtual void getPawns(uint64_t & pawnsWhite, uint64_t & pawnsBlack) const;
+
+   // one byte per square, row * 8 + col, see squareCode()
+   const uint8_t * getSquares() const  { return squares;             }
+
+   // where the pieces live, for the statistics
+   const Arena & getArena()     const  { return arena;               }
+
+   // the squares display() will draw next, one bit per square. After a
+   // resize the window is new, so draw all of it
+   uint64_t getDirty()          const  { return dirty;               }
+   void markAllDirty()          const  { fDrawAll = true;            }
+
+   // squares display() draws with drawPossible(), such as the engine's
+   // best move. Only the squares that change are drawn again
+   void setPossible(uint64_t squares)
+   {
+      dirty |= possible ^ squares;
+      possible = squares;
+   }
 
    // setters
    virtual void free();
    virtual void reset(bool fFree = true);
+   virtual bool setFen(const std::string & fen);
    virtual void move(const Move & move);
+   virtual void undo();
+   virtual void moveNull()                 { numMoves++;                 }
+   virtual void undoNull()                 { numMoves--;                 }
    virtual Piece& operator [] (const Position& pos);
 
 protected:
    void  assertBoard();
-
+   void  rescore();
+   void  encodeAll();
+   void  markDirty(const Position & pos) const;
+   uint64_t takeDirty(const Position & posHover, const Position & posSelect,
+                      bool & fAll) const;
+   void  scoreAll(int & mg, int & eg, int & ph) const;
+   void  scorePiece(uint8_t code, int square, int sign);
+   void  networkAll(Accumulator & acc) const;
+   void  networkPiece(uint8_t code, int square, int sign);
+   int   findKing(bool isWhite) const;
+   uint64_t pawnKey() const;
+
+   /***************************************************
+    * MOVE RECORD
+    * Everything we need to take back a move
+    **************************************************/
+   struct MoveRecord
+   {
+      Move    move;          // the move that was made
+      uint8_t codeCaptured;  // what was on the destination, maybe SPACE
+      Piece * pCaptured;     // the same, for display, if not a space
+      int     lastMove;      // when the moving piece last moved before this
+   };
+
+   // the position is the bytes: move(), undo(), and the scores read
+   // and write only them. The pieces follow along for display() and
+   // the lab's Piece API, and spaces holds one spare space per piece
+   // so a capture never has to make one
    Piece * board[8][8];    // the board of chess pieces
+   uint8_t squares[64];    // the same board, one byte per square
    int numMoves;
+   std::stack <MoveRecord, std::vector <MoveRecord>> history;   // moves made so we can undo them
+   std::vector <Piece *> spaces;      // spaces undo() took off the board
+   Arena arena;                       // every piece the board made
+
+   // material and piece-square sums, kept up to date by move() and undo()
+   int scoreMg;
+   int scoreEg;
+   int phase;
+   uint64_t keyPawn;                  // Zobrist hash of just the pawns
+
+   // the network's first layer, one per move made so undo() is a pop
+   const Network * pNetwork;
+   std::vector <Accumulator> accumulators;
+   int squareKing[2];                 // white's king, black's king
+
+   // what changed since the last display(). The frame starts as a
+   // copy of the screen, so nothing else needs drawing
+   mutable uint64_t dirty;            // squares changed since the last display
+   mutable bool fDrawAll;             // draw the next display in full
+   mutable Position posHoverLast;     // the highlights the last display drew
+   mutable Position posSelectLast;
+   uint64_t possible;                 // squares to draw with drawPossible()
 
    ogstream* pgout;
 };
@@ -81,10 +177,23 @@ public:
    void display(const Position& posHover,
                 const Position& posSelect) const          { assert(false); }
    void reset(bool fFree = true)                          { assert(false); }
+   bool setFen(const std::string & fen)                   { assert(false); return false; }
    void move       (const Move& move)                     { assert(false); }
    void undo()                                            { assert(false); }
+   void moveNull()                                        { assert(false); }
+   void undoNull()                                        { assert(false); }
    int  getCurrentMove() const                            { assert(false); return 0; }
    bool whiteTurn()      const                            { assert(false); return false; }
+   void getMoves(std::set <Move>& moves, bool isWhite) const { assert(false); }
+   bool isInCheck(bool isWhite) const                     { assert(false); return false; }
+   bool hasNonPawnMaterial(bool isWhite) const            { assert(false); return false; }
+   int  evaluate() const                                  { assert(false); return 0; }
+   void setNetwork(const Network * pNetwork)              { assert(false); }
+   bool hasNetwork()     const                            { assert(false); return false; }
+   uint64_t getPawnKey() const                            { assert(false); return 0; }
+   int  getPhase()       const                            { assert(false); return 0; }
+   void getPawns(uint64_t & pawnsWhite,
+                 uint64_t & pawnsBlack) const             { assert(false); }
    void free()                                            { assert(false); }
    Piece& operator [] (const Position& pos)
    { 
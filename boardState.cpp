@@ -0,0 +1,250 @@
+/***********************************************************************
+ * Source File:
+ *    BOARD STATE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The copy-make board and the perft counts that compare it with
+ *    Board's make and unmake
+ ************************************************************************/
+
+#include "boardState.h"
+#include "board.h"
+#include "pieceKnight.h"
+#include "arena.h"
+#include "zobrist.h"
+#include <cassert>
+using namespace std;
+
+// more moves than any position has
+const int MAX_MOVES = 256;
+
+/*************************************************
+ * CASTLE MASK
+ * The rights still left after a piece leaves or
+ * lands on a square
+ *************************************************/
+static uint8_t castleMask(int square)
+{
+   switch (square)
+   {
+      case 0:                    // a1
+         return (uint8_t)~CASTLE_WHITE_QUEEN;
+      case 7:                    // h1
+         return (uint8_t)~CASTLE_WHITE_KING;
+      case 4:                    // e1
+         return (uint8_t)~(CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN);
+      case 56:                   // a8
+         return (uint8_t)~CASTLE_BLACK_QUEEN;
+      case 63:                   // h8
+         return (uint8_t)~CASTLE_BLACK_KING;
+      case 60:                   // e8
+         return (uint8_t)~(CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN);
+      default:
+         return 0xff;
+   }
+}
+
+static int lowestBit(uint64_t bits)
+{
+   assert(bits);
+   int square = 0;
+   while (!(bits & 1))
+   {
+      bits >>= 1;
+      square++;
+   }
+   return square;
+}
+
+/*************************************************
+ * BOARD STATE : SET
+ *************************************************/
+void BoardState::set(const Board & board)
+{
+   for (int color = 0; color < 2; color++)
+      for (int i = 0; i < 6; i++)
+         pieces[color][i] = 0;
+
+   const uint8_t * squares = board.getSquares();
+   for (int square = 0; square < 64; square++)
+   {
+      PieceType pt = squareType(squares[square]);
+      if (pt >= KING)
+         pieces[squareWhite(squares[square]) ? 0 : 1][pt - KING] |= 1ull << square;
+   }
+
+   isWhiteTurn = board.whiteTurn() ? 1 : 0;
+   fullMove    = (uint16_t)(board.getCurrentMove() / 2 + 1);
+   halfMove    = 0;
+   castling    = 0;
+   enPassant   = -1;
+   hash        = computeHash();
+}
+
+/*************************************************
+ * BOARD STATE : GET SQUARE
+ *************************************************/
+uint8_t BoardState::getSquare(int square) const
+{
+   assert(0 <= square && square < 64);
+   uint64_t bit = 1ull << square;
+   for (int color = 0; color < 2; color++)
+      for (int i = 0; i < 6; i++)
+         if (pieces[color][i] & bit)
+            return squareCode((PieceType)(KING + i), color == 0);
+   return SPACE;
+}
+
+/*************************************************
+ * BOARD STATE : GET OCCUPIED
+ *************************************************/
+uint64_t BoardState::getOccupied(bool isWhite) const
+{
+   const uint64_t * bitboards = pieces[isWhite ? 0 : 1];
+   return bitboards[0] | bitboards[1] | bitboards[2] |
+          bitboards[3] | bitboards[4] | bitboards[5];
+}
+
+/*************************************************
+ * BOARD STATE : COMPUTE HASH
+ *************************************************/
+uint64_t BoardState::computeHash() const
+{
+   uint64_t key = isWhiteTurn ? 0 : zobristSide();
+   for (int color = 0; color < 2; color++)
+      for (int i = 0; i < 6; i++)
+         for (uint64_t bits = pieces[color][i]; bits; bits &= bits - 1)
+            key ^= zobristPiece((PieceType)(KING + i), color == 0, lowestBit(bits));
+   return key;
+}
+
+/*************************************************
+ * BOARD STATE : GET MOVES
+ * Like the board, only the knights know how to move
+ *************************************************/
+void BoardState::getMoves(MoveList & moves) const
+{
+   bool isWhite = whiteTurn();
+   uint64_t ours   = getOccupied(isWhite);
+   const uint64_t * theirs = pieces[isWhite ? 1 : 0];
+
+   for (uint64_t knights = pieces[isWhite ? 0 : 1][KNIGHT - KING]; knights; knights &= knights - 1)
+   {
+      int squareSrc = lowestBit(knights);
+      Position posSrc(squareSrc % 8, squareSrc / 8);
+      for (uint64_t dests = knightAttacks(squareSrc) & ~ours; dests; dests &= dests - 1)
+      {
+         int squareDest = lowestBit(dests);
+         PieceType capture = SPACE;
+         for (int i = 0; i < 6; i++)
+            if (theirs[i] & (1ull << squareDest))
+               capture = (PieceType)(KING + i);
+         moves.push_back(Move(posSrc, Position(squareDest % 8, squareDest / 8),
+                              Move::MOVE, capture, SPACE, isWhite));
+      }
+   }
+}
+
+/*************************************************
+ * BOARD STATE : MOVE
+ *************************************************/
+void BoardState::move(const Move & move)
+{
+   bool isWhite = whiteTurn();
+   int us   = isWhite ? 0 : 1;
+   int them = 1 - us;
+   int squareSrc  = move.getSource().getRow() * 8 + move.getSource().getCol();
+   int squareDest = move.getDest().getRow()   * 8 + move.getDest().getCol();
+   uint64_t bitSrc  = 1ull << squareSrc;
+   uint64_t bitDest = 1ull << squareDest;
+
+   // whatever was on the destination goes away
+   bool isCapture = false;
+   for (int i = 0; i < 6; i++)
+      if (pieces[them][i] & bitDest)
+      {
+         pieces[them][i] &= ~bitDest;
+         hash ^= zobristPiece((PieceType)(KING + i), !isWhite, squareDest);
+         isCapture = true;
+      }
+
+   // the piece that moves
+   int iMoving = 0;
+   while (iMoving < 6 && !(pieces[us][iMoving] & bitSrc))
+      iMoving++;
+   assert(iMoving < 6);
+   PieceType pt = (PieceType)(KING + iMoving);
+   pieces[us][iMoving] ^= bitSrc | bitDest;
+   hash ^= zobristPiece(pt, isWhite, squareSrc) ^ zobristPiece(pt, isWhite, squareDest);
+
+   // the rest of the state
+   halfMove   = (isCapture || pt == PAWN) ? 0 : (uint8_t)(halfMove + 1);
+   castling  &= castleMask(squareSrc) & castleMask(squareDest);
+   enPassant  = -1;
+   if (!isWhite)
+      fullMove++;
+   isWhiteTurn = isWhite ? 0 : 1;
+   hash ^= zobristSide();
+   assert(hash == computeHash());
+}
+
+/*************************************************
+ * PERFT COPY MAKE
+ *************************************************/
+static long perftCopyMake(const BoardState & state, int depth, Pool & pool)
+{
+   if (depth == 0)
+      return 1;
+
+   MoveList moves(PoolAllocator <Move> {pool});
+   moves.reserve(MAX_MOVES);
+   state.getMoves(moves);
+   if (depth == 1)
+      return (long)moves.size();
+
+   long nodes = 0;
+   for (const Move & move : moves)
+   {
+      BoardState child = state;
+      child.move(move);
+      nodes += perftCopyMake(child, depth - 1, pool);
+   }
+   return nodes;
+}
+
+long perftCopyMake(const BoardState & state, int depth)
+{
+   Pool pool(MAX_MOVES * sizeof(Move), 8);
+   return perftCopyMake(state, depth, pool);
+}
+
+/*************************************************
+ * PERFT MAKE UNMAKE
+ *************************************************/
+static long perftMakeUnmake(Board & board, int depth, Pool & pool)
+{
+   if (depth == 0)
+      return 1;
+
+   MoveList moves(PoolAllocator <Move> {pool});
+   moves.reserve(MAX_MOVES);
+   board.getMoves(moves, board.whiteTurn());
+   if (depth == 1)
+      return (long)moves.size();
+
+   long nodes = 0;
+   for (const Move & move : moves)
+   {
+      board.move(move);
+      nodes += perftMakeUnmake(board, depth - 1, pool);
+      board.undo();
+   }
+   return nodes;
+}
+
+long perftMakeUnmake(Board & board, int depth)
+{
+   Pool pool(MAX_MOVES * sizeof(Move), 8);
+   return perftMakeUnmake(board, depth, pool);
+}
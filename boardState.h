@@ -0,0 +1,70 @@
+/***********************************************************************
+ * Header File:
+ *    BOARD STATE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Everything about a position in one small, plain struct: a bitboard
+ *    per piece type and color, whose turn it is, castling, en-passant,
+ *    the hash, and the move counters. It is cheap enough to copy that a
+ *    search can copy it for every ply instead of taking moves back.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>            // for UINT64_T
+#include <type_traits>        // for IS_TRIVIALLY_COPYABLE
+#include "move.h"             // for MOVE
+#include "pieceFlyweight.h"   // for MOVELIST and SQUARECODE
+
+class Board;
+
+// the castling rights
+const uint8_t CASTLE_WHITE_KING  = 0x01;
+const uint8_t CASTLE_WHITE_QUEEN = 0x02;
+const uint8_t CASTLE_BLACK_KING  = 0x04;
+const uint8_t CASTLE_BLACK_QUEEN = 0x08;
+
+/***************************************************
+ * BOARD STATE
+ * Squares are numbered row * 8 + col, a1 is 0, the
+ * same as Board::getSquares(). Copy it with = and
+ * make a move on the copy; there is no undo
+ ***************************************************/
+struct BoardState
+{
+   uint64_t pieces[2][6];   // [white, black][KING ... PAWN], one bit per square
+   uint64_t hash;           // Zobrist of the pieces and the side to move
+   uint16_t fullMove;       // starts at 1, counts up after black moves
+   uint8_t  halfMove;       // plies since the last capture or pawn move
+   uint8_t  isWhiteTurn;    // 1 when white is to move
+   uint8_t  castling;       // the CASTLE_* rights left
+   int8_t   enPassant;      // square a pawn just skipped over, or -1
+
+   // from a board. The board knows no castling or en-passant
+   void set(const Board & board);
+
+   // getters
+   bool     whiteTurn()                 const { return isWhiteTurn != 0; }
+   uint8_t  getSquare(int square)       const;   // as squareCode()
+   uint64_t getOccupied(bool isWhite)   const;
+   uint64_t computeHash()               const;   // from scratch
+
+   // the moves for the side to move, as Board::getMoves() makes them
+   void getMoves(MoveList & moves) const;
+
+   // make a move on this copy
+   void move(const Move & move);
+};
+
+static_assert(sizeof(BoardState) < 128, "BoardState must stay small to copy");
+static_assert(std::is_trivially_copyable<BoardState>::value,
+              "BoardState must be copyable with memcpy");
+static_assert(std::is_standard_layout<BoardState>::value,
+              "BoardState must be plain data");
+
+// the leaf nodes depth plies down, copying the state at every ply
+long perftCopyMake(const BoardState & state, int depth);
+
+// the same count with Board::move() and Board::undo()
+long perftMakeUnmake(Board & board, int depth);
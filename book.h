@@ -0,0 +1,107 @@
+/***********************************************************************
+ * Header File:
+ *    BOOK
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    An opening book in the Polyglot format: 16-byte entries, sorted by
+ *    the key of the position, each a move and how good it has been. The
+ *    file is mapped into memory and never read into our own buffers, so
+ *    opening a big book is instant and its pages are shared between
+ *    processes. A builder makes one from a collection of PGN games.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>     // for UINT64_T
+#include <string>      // for STRING file names
+#include <vector>      // for VECTOR of book moves
+#include <map>         // for MAP of what the builder has seen
+#include <iostream>    // for ISTREAM of PGN
+#include "board.h"
+#include "move.h"
+
+class TestBook;
+
+/***************************************************
+ * BOOK MOVE
+ * A move from the book and its weight, which picks
+ * how often it is played
+ ***************************************************/
+struct BookMove
+{
+   Move move;
+   int weight;
+};
+
+/***************************************************
+ * BOOK
+ ***************************************************/
+class Book
+{
+   friend TestBook;
+public:
+   Book();
+   ~Book() { close(); }
+
+   // false if the file is missing or is not a whole number of entries
+   bool open(const std::string & fileName);
+   void close();
+   bool isOpen() const { return data != nullptr; }
+   size_t size() const { return numEntries; }
+
+   // the book's moves here that are legal, heaviest first
+   void getMoves(Board & board, std::vector <BookMove> & moves) const;
+
+   // one of them chosen in proportion to its weight by random, which
+   // is anywhere in 0...2^32-1. False if the book has nothing here
+   bool pick(Board & board, Move & move, uint32_t random) const;
+
+   // the position's key and the move as Polyglot writes them
+   static uint64_t key(const Board & board);
+   static uint16_t encode(const Move & move);
+
+private:
+   static const uint64_t * random64();
+   size_t lowerBound(uint64_t key) const;
+   uint64_t entryKey(size_t i) const;
+
+   const uint8_t * data;       // the mapped file
+   size_t numEntries;
+   size_t sizeMapped;
+   void * hMapping;            // Windows only: the mapping to unmap
+};
+
+/***************************************************
+ * BOOK BUILDER
+ * Play through games and count, for every position
+ * and move, how well it went for the side that made
+ * it: two for a win, one for a draw
+ ***************************************************/
+class BookBuilder
+{
+   friend TestBook;
+public:
+   // only the first plies of each game go in
+   BookBuilder(int maxPlies = 30) : maxPlies(maxPlies) {}
+
+   void add(const Board & board, const Move & move, int weight);
+
+   // every game in the collection, up to the first move we cannot
+   // play. Returns how many games there were
+   int addPgn(std::istream & in);
+
+   // how many different position and move pairs we have
+   size_t size() const { return weights.size(); }
+
+   // the book, with the weights scaled to fit. False if we cannot
+   // write it
+   bool write(const std::string & fileName) const;
+
+private:
+   std::map <std::pair <uint64_t, uint16_t>, uint64_t> weights;
+   int maxPlies;
+};
+
+// which legal move the SAN, like Nbd7 or exd6, means here
+bool findSan(Board & board, const std::string & san, Move & move);
@@ -13,14 +13,48 @@
 #include "position.h"     // for POSITION
 #include "piece.h"        // for PIECE and company
 #include "board.h"        // for BOARD
-#include "test.h"
+#include "uiImage.h"      // for RENDERBATCH
+#include "analysis.h"     // for ANALYSIS
 #include <set>            // for STD::SET
 #include <cassert>        // for ASSERT
 #include <fstream>        // for IFSTREAM
 #include <string>         // for STRING
+#include <cstdlib>        // for ATOF and ATOI
+#include <sstream>        // for ISTRINGSTREAM
+#include <iostream>       // for CERR
+#include <vector>         // for VECTOR of windows
+#include <memory>         // for UNIQUE_PTR
 using namespace std;
 
 
+/*************************************
+ * GAME
+ * The board in the window and the engine thinking
+ * about it on a thread of its own
+ **************************************/
+struct Game
+{
+   Game(Interface & ui, ogstream * pgout) : board(pgout)
+   {
+      // each result the engine finds is worth a frame
+      analysis.setNotify(requestRedraw, &ui);
+   }
+
+   static void requestRedraw(void * p) { ((Interface *)p)->requestRedraw(); }
+
+   Board board;
+   Analysis analysis;
+};
+
+/*************************************
+ * SQUARE BIT
+ * The bit of a square, as Board::setPossible() wants
+ **************************************/
+inline uint64_t squareBit(const Position & pos)
+{
+   return 1ull << (pos.getRow() * 8 + pos.getCol());
+}
+
 /*************************************
  * All the interesting work happens here, when
  * I get called back from OpenGL to draw a frame.
@@ -32,9 +66,111 @@ void callBack(Interface *pUI, void * p)
 {
    // the first step is to cast the void pointer into a game object. This
    // is the first step of every single callback function in OpenGL. 
-   Board * pBoard = (Board *)p;  
+   Game * pGame = (Game *)p;
+   Board * pBoard = &pGame->board;
+
+   // 'a' starts and stops the engine thinking about the position
+   if (pUI->getKey() == 'a')
+   {
+      if (pGame->analysis.isRunning())
+      {
+         pGame->analysis.stop();
+         pBoard->setPossible(0);
+      }
+      else
+         pGame->analysis.start(*pBoard);
+      pUI->resetKey();
+   }
+
+   // show the best move the engine has found so far. This never
+   // waits for the engine
+   AnalysisResult result;
+   while (pGame->analysis.poll(result))
+      if (result.move.getMoveType() != Move::MOVE_ERROR)
+         pBoard->setPossible(squareBit(result.move.getSource()) |
+                             squareBit(result.move.getDest()));
+
+   // only the squares that changed, unless the window is new
+   if (pUI->needsFullRedraw())
+      pBoard->markAllDirty();
+   pBoard->display(pUI->getHoverPosition(), pUI->getSelectPosition());
+}
+
+
+/*********************************
+ * SET RENDER MODE
+ * We only draw when something changed unless the
+ * command line has "--fps 30", which draws thirty
+ * times a second whether anything changed or not
+ *********************************/
+void setRenderMode(Interface & ui, const string & commandLine)
+{
+   size_t i = commandLine.find("--fps");
+   if (i == string::npos)
+      return;
+
+   double fps = atof(commandLine.c_str() + i + 5);
+   if (fps > 0.0)
+      ui.setFramesPerSecond(fps);
+   ui.setRenderMode(Interface::RENDER_FIXED_FPS);
 }
 
+/*********************************
+ * GET NUM BOARDS
+ * One window unless the command line has "--boards 4",
+ * which opens four, all played in this one process
+ *********************************/
+int getNumBoards(const string & commandLine)
+{
+   size_t i = commandLine.find("--boards");
+   if (i == string::npos)
+      return 1;
+
+   int numBoards = atoi(commandLine.c_str() + i + 8);
+   return numBoards > 0 ? numBoards : 1;
+}
+
+/*********************************
+ * RENDER
+ * "--render fens.txt dir" draws every FEN in fens.txt
+ * into dir/1.png, dir/2.png, ... without opening a
+ * window. Add "--ppm" for PPM files and "--scale 2"
+ * for bigger pictures. Returns false when the command
+ * line does not ask for this
+ *********************************/
+bool render(const string & commandLine, int & exitCode)
+{
+   istringstream words(commandLine);
+   string word;
+   string fileFens;
+   string dirOut;
+   string extension = ".png";
+   double scale = 1.0;
+   bool isRender = false;
+   while (words >> word)
+      if (word == "--render")
+      {
+         isRender = true;
+         words >> fileFens >> dirOut;
+      }
+      else if (word == "--ppm")
+         extension = ".ppm";
+      else if (word == "--scale")
+         words >> scale;
+
+   if (!isRender)
+      return false;
+
+   ifstream fin(fileFens);
+   if (dirOut.empty() || !fin.is_open() || scale <= 0.0)
+   {
+      cerr << "usage: --render fens.txt dir [--ppm] [--scale s]\n";
+      exitCode = 1;
+      return true;
+   }
+   exitCode = renderBatch(fin, dirOut, extension, scale, cerr) == 0 ? 0 : 1;
+   return true;
+}
 
 /*********************************
  * MAIN - Where it all begins...
@@ -50,21 +186,39 @@ int WINAPI WinMain(
 int main(int argc, char** argv)
 #endif // !_WIN32
 {
+#ifdef _WIN32
+   string commandLine(pCmdLine);
+#else // !_WIN32
+   string commandLine;
+   for (int i = 1; i < argc; i++)
+      commandLine += string(argv[i]) + " ";
+#endif // !_WIN32
 
-   // run all the unit tests
-   testRunner();
-   
-   // Instantiate the graphics window
-   Interface ui("Chess");    
+   // pictures only, no window
+   int exitCode = 0;
+   if (render(commandLine, exitCode))
+      return exitCode;
+
+   // Instantiate the graphics windows, each a board of its own
+   vector <unique_ptr <Interface>> uis;
+   vector <unique_ptr <ogstream>> gouts;
+   vector <unique_ptr <Game>> games;
+   int numBoards = getNumBoards(commandLine);
+   for (int i = 0; i < numBoards; i++)
+   {
+      string title = i == 0 ? string("Chess") : "Chess " + to_string(i + 1);
+      uis.emplace_back(new Interface(title.c_str()));
+      setRenderMode(*uis.back(), commandLine);
 
-   // Initialize the game class
-   ogstream* pgout = new ogstream;
-   Board board(pgout);
+      // Initialize the game class
+      gouts.emplace_back(new ogstream);
+      games.emplace_back(new Game(*uis.back(), gouts.back().get()));
+      uis.back()->setCallBack(callBack, (void *)games.back().get());
+   }
 
    // set everything into action
-   ui.run(callBack, (void *)(&board));      
+   uis.front()->run(callBack, (void *)games.front().get());
    
    // All done.
-   delete pgout;
    return 0;
 }
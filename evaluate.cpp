@@ -0,0 +1,303 @@
+/***********************************************************************
+ * Source File:
+ *    EVALUATE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Piece-square tables for the middlegame and the endgame. The Board
+ *    keeps a running sum of these so it never has to rescan the squares.
+ ************************************************************************/
+
+#include "evaluate.h"
+#include <cassert>
+
+// material in centipawns:            -  SPACE KING QUEEN ROOK BISHOP KNIGHT PAWN
+const int MATERIAL_MG[] = { 0,  0,    0,   1025, 477, 365,   337,   82 };
+const int MATERIAL_EG[] = { 0,  0,    0,   936,  512, 297,   281,   94 };
+const int PHASE[]       = { 0,  0,    0,   4,    2,   1,     1,     0  };
+
+// pawn structure, by how far the pawn has advanced (0 is its own back rank)
+const int PASSED_MG[8]  = { 0,  5,  10,  15,  25,  45,  70,  0 };
+const int PASSED_EG[8]  = { 0, 10,  20,  30,  50,  80, 120,  0 };
+const int ISOLATED_MG   = -10;
+const int ISOLATED_EG   = -15;
+const int DOUBLED_MG    = -10;
+const int DOUBLED_EG    = -20;
+
+// The tables are drawn as white sees the board: rank 8 on top, a-file on
+// the left. Black uses the same tables flipped top to bottom.
+const int PAWN_MG[64] =
+{
+     0,   0,   0,   0,   0,   0,   0,   0,
+    50,  50,  50,  50,  50,  50,  50,  50,
+    10,  10,  20,  30,  30,  20,  10,  10,
+     5,   5,  10,  25,  25,  10,   5,   5,
+     0,   0,   0,  20,  20,   0,   0,   0,
+     5,  -5, -10,   0,   0, -10,  -5,   5,
+     5,  10,  10, -20, -20,  10,  10,   5,
+     0,   0,   0,   0,   0,   0,   0,   0
+};
+const int PAWN_EG[64] =
+{
+     0,   0,   0,   0,   0,   0,   0,   0,
+    80,  80,  80,  80,  80,  80,  80,  80,
+    50,  50,  50,  50,  50,  50,  50,  50,
+    30,  30,  30,  30,  30,  30,  30,  30,
+    15,  15,  15,  15,  15,  15,  15,  15,
+     5,   5,   5,   5,   5,   5,   5,   5,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0
+};
+const int KNIGHT_MG[64] =
+{
+   -50, -40, -30, -30, -30, -30, -40, -50,
+   -40, -20,   0,   0,   0,   0, -20, -40,
+   -30,   0,  10,  15,  15,  10,   0, -30,
+   -30,   5,  15,  20,  20,  15,   5, -30,
+   -30,   0,  15,  20,  20,  15,   0, -30,
+   -30,   5,  10,  15,  15,  10,   5, -30,
+   -40, -20,   0,   5,   5,   0, -20, -40,
+   -50, -40, -30, -30, -30, -30, -40, -50
+};
+const int KNIGHT_EG[64] =
+{
+   -50, -40, -30, -30, -30, -30, -40, -50,
+   -40, -20,   0,   0,   0,   0, -20, -40,
+   -30,   0,  10,  15,  15,  10,   0, -30,
+   -30,   0,  15,  20,  20,  15,   0, -30,
+   -30,   0,  15,  20,  20,  15,   0, -30,
+   -30,   0,  10,  15,  15,  10,   0, -30,
+   -40, -20,   0,   0,   0,   0, -20, -40,
+   -50, -40, -30, -30, -30, -30, -40, -50
+};
+const int BISHOP_MG[64] =
+{
+   -20, -10, -10, -10, -10, -10, -10, -20,
+   -10,   0,   0,   0,   0,   0,   0, -10,
+   -10,   0,   5,  10,  10,   5,   0, -10,
+   -10,   5,   5,  10,  10,   5,   5, -10,
+   -10,   0,  10,  10,  10,  10,   0, -10,
+   -10,  10,  10,  10,  10,  10,  10, -10,
+   -10,   5,   0,   0,   0,   0,   5, -10,
+   -20, -10, -10, -10, -10, -10, -10, -20
+};
+const int BISHOP_EG[64] =
+{
+   -20, -10, -10, -10, -10, -10, -10, -20,
+   -10,   0,   0,   0,   0,   0,   0, -10,
+   -10,   0,   5,  10,  10,   5,   0, -10,
+   -10,   0,  10,  15,  15,  10,   0, -10,
+   -10,   0,  10,  15,  15,  10,   0, -10,
+   -10,   0,   5,  10,  10,   5,   0, -10,
+   -10,   0,   0,   0,   0,   0,   0, -10,
+   -20, -10, -10, -10, -10, -10, -10, -20
+};
+const int ROOK_MG[64] =
+{
+     0,   0,   0,   0,   0,   0,   0,   0,
+     5,  10,  10,  10,  10,  10,  10,   5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+     0,   0,   0,   5,   5,   0,   0,   0
+};
+const int ROOK_EG[64] =
+{
+     5,   5,   5,   5,   5,   5,   5,   5,
+    10,  10,  10,  10,  10,  10,  10,  10,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0
+};
+const int QUEEN_MG[64] =
+{
+   -20, -10, -10,  -5,  -5, -10, -10, -20,
+   -10,   0,   0,   0,   0,   0,   0, -10,
+   -10,   0,   5,   5,   5,   5,   0, -10,
+    -5,   0,   5,   5,   5,   5,   0,  -5,
+     0,   0,   5,   5,   5,   5,   0,  -5,
+   -10,   5,   5,   5,   5,   5,   0, -10,
+   -10,   0,   5,   0,   0,   0,   0, -10,
+   -20, -10, -10,  -5,  -5, -10, -10, -20
+};
+const int QUEEN_EG[64] =
+{
+   -20, -10, -10,  -5,  -5, -10, -10, -20,
+   -10,   0,   5,   5,   5,   5,   0, -10,
+   -10,   5,  10,  10,  10,  10,   5, -10,
+    -5,   5,  10,  15,  15,  10,   5,  -5,
+    -5,   5,  10,  15,  15,  10,   5,  -5,
+   -10,   5,  10,  10,  10,  10,   5, -10,
+   -10,   0,   5,   5,   5,   5,   0, -10,
+   -20, -10, -10,  -5,  -5, -10, -10, -20
+};
+const int KING_MG[64] =
+{
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -20, -30, -30, -40, -40, -30, -30, -20,
+   -10, -20, -20, -20, -20, -20, -20, -10,
+    20,  20,   0,   0,   0,   0,  20,  20,
+    20,  30,  10,   0,   0,  10,  30,  20
+};
+const int KING_EG[64] =
+{
+   -50, -40, -30, -20, -20, -30, -40, -50,
+   -30, -20, -10,   0,   0, -10, -20, -30,
+   -30, -10,  20,  30,  30,  20, -10, -30,
+   -30, -10,  30,  40,  40,  30, -10, -30,
+   -30, -10,  30,  40,  40,  30, -10, -30,
+   -30, -10,  20,  30,  30,  20, -10, -30,
+   -30, -30,   0,   0,   0,   0, -30, -30,
+   -50, -30, -30, -30, -30, -30, -30, -50
+};
+
+/*************************************************
+ * TABLE
+ * Which table goes with which piece
+ *************************************************/
+static const int * table(PieceType pt, bool fMiddlegame)
+{
+   switch (pt)
+   {
+   case PAWN:   return fMiddlegame ? PAWN_MG   : PAWN_EG;
+   case KNIGHT: return fMiddlegame ? KNIGHT_MG : KNIGHT_EG;
+   case BISHOP: return fMiddlegame ? BISHOP_MG : BISHOP_EG;
+   case ROOK:   return fMiddlegame ? ROOK_MG   : ROOK_EG;
+   case QUEEN:  return fMiddlegame ? QUEEN_MG  : QUEEN_EG;
+   case KING:   return fMiddlegame ? KING_MG   : KING_EG;
+   default:     return nullptr;
+   }
+}
+
+/*************************************************
+ * INDEX
+ * Where in the table a square is. White reads the
+ * table upside down because it is drawn rank 8 first.
+ *************************************************/
+static int index(bool isWhite, int col, int row)
+{
+   assert(0 <= col && col < 8 && 0 <= row && row < 8);
+   return isWhite ? (7 - row) * 8 + col : row * 8 + col;
+}
+
+/*************************************************
+ * PIECE SQUARE MG
+ *************************************************/
+int pieceSquareMg(PieceType pt, bool isWhite, int col, int row)
+{
+   const int * pTable = table(pt, true /*fMiddlegame*/);
+   if (!pTable)
+      return 0;
+   int value = MATERIAL_MG[pt] + pTable[index(isWhite, col, row)];
+   return isWhite ? value : -value;
+}
+
+/*************************************************
+ * PIECE SQUARE EG
+ *************************************************/
+int pieceSquareEg(PieceType pt, bool isWhite, int col, int row)
+{
+   const int * pTable = table(pt, false /*fMiddlegame*/);
+   if (!pTable)
+      return 0;
+   int value = MATERIAL_EG[pt] + pTable[index(isWhite, col, row)];
+   return isWhite ? value : -value;
+}
+
+/*************************************************
+ * PIECE PHASE
+ *************************************************/
+int piecePhase(PieceType pt)
+{
+   return PHASE[pt];
+}
+
+/*************************************************
+ * FILE MASK
+ * Every square on one column
+ *************************************************/
+static uint64_t fileMask(int col)
+{
+   return 0x0101010101010101ull << col;
+}
+
+/*************************************************
+ * PAWN STRUCTURE SIDE
+ * Score one side's pawns. A pawn is passed when no enemy
+ * pawn is in front of it on its own or a neighboring file.
+ *************************************************/
+static void pawnStructureSide(uint64_t pawnsOurs, uint64_t pawnsTheirs, bool isWhite,
+                              int & mg, int & eg)
+{
+   for (int col = 0; col < 8; col++)
+   {
+      uint64_t file = fileMask(col);
+      uint64_t neighbors = (col > 0 ? fileMask(col - 1) : 0) |
+                           (col < 7 ? fileMask(col + 1) : 0);
+
+      // every pawn after the first on a file is doubled
+      int count = 0;
+      for (int row = 0; row < 8; row++)
+         if (pawnsOurs & (1ull << (row * 8 + col)))
+            count++;
+      if (count > 1)
+      {
+         mg += DOUBLED_MG * (count - 1);
+         eg += DOUBLED_EG * (count - 1);
+      }
+      if (count && !(pawnsOurs & neighbors))
+      {
+         mg += ISOLATED_MG * count;
+         eg += ISOLATED_EG * count;
+      }
+
+      for (int row = 0; row < 8; row++)
+      {
+         if (!(pawnsOurs & (1ull << (row * 8 + col))))
+            continue;
+
+         // the rows in front of this pawn
+         uint64_t ahead = isWhite ? (row < 7 ? ~0ull << ((row + 1) * 8) : 0)
+                                  : (row > 0 ? ~0ull >> ((8 - row) * 8) : 0);
+         if (!(pawnsTheirs & ahead & (file | neighbors)))
+         {
+            int advanced = isWhite ? row : 7 - row;
+            mg += PASSED_MG[advanced];
+            eg += PASSED_EG[advanced];
+         }
+      }
+   }
+}
+
+/*************************************************
+ * PAWN STRUCTURE
+ *************************************************/
+void pawnStructure(uint64_t pawnsWhite, uint64_t pawnsBlack, int & mg, int & eg)
+{
+   int mgWhite = 0, egWhite = 0;
+   int mgBlack = 0, egBlack = 0;
+   pawnStructureSide(pawnsWhite, pawnsBlack, true  /*isWhite*/, mgWhite, egWhite);
+   pawnStructureSide(pawnsBlack, pawnsWhite, false /*isWhite*/, mgBlack, egBlack);
+   mg = mgWhite - mgBlack;
+   eg = egWhite - egBlack;
+}
+
+/*************************************************
+ * TAPER
+ * All the pieces on the board is pure middlegame,
+ * none of them is pure endgame
+ *************************************************/
+int taper(int scoreMg, int scoreEg, int phase)
+{
+   if (phase > PHASE_MAX)
+      phase = PHASE_MAX;
+   return (scoreMg * phase + scoreEg * (PHASE_MAX - phase)) / PHASE_MAX;
+}
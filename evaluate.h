@@ -0,0 +1,30 @@
+/***********************************************************************
+ * Header File:
+ *    EVALUATE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Piece-square tables for the middlegame and the endgame. The Board
+ *    keeps a running sum of these so it never has to rescan the squares.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>       // for UINT64_T
+#include "pieceType.h"   // for PIECE TYPE
+
+const int PHASE_MAX = 24;   // game phase with all the pieces on the board
+
+// material plus the square bonus for one piece, from white's point of view
+int pieceSquareMg(PieceType pt, bool isWhite, int col, int row);
+int pieceSquareEg(PieceType pt, bool isWhite, int col, int row);
+
+// how much this piece counts towards the middlegame
+int piecePhase(PieceType pt);
+
+// passed, isolated and doubled pawns, from white's point of view.
+// Each set has bit (row * 8 + col) on for every pawn of that color
+void pawnStructure(uint64_t pawnsWhite, uint64_t pawnsBlack, int & mg, int & eg);
+
+// blend the middlegame and endgame scores according to the phase
+int taper(int scoreMg, int scoreEg, int phase);
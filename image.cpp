@@ -0,0 +1,610 @@
+/***********************************************************************
+ * Source File:
+ *    IMAGE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The software rasterizer and the PPM and PNG writers. We need no
+ *    zlib: a board is big flat squares, so deflate with the fixed codes
+ *    that only looks back one pixel or one row shrinks it plenty.
+ ************************************************************************/
+
+#include "image.h"
+#include <fstream>    // for OFSTREAM
+#include <cmath>      // for FLOOR and CEIL
+#include <cstdlib>    // for ABS
+#include <cstring>    // for MEMCPY
+#include <cassert>
+using namespace std;
+
+const int GLYPH_WIDTH   = 5;
+const int GLYPH_HEIGHT  = 7;
+const int GLYPH_ADVANCE = GLYPH_WIDTH + 1;
+
+/*************************************************
+ * GLYPHS
+ * Seven rows, top first, with the left column in
+ * the 0x10 bit
+ *************************************************/
+struct Glyph
+{
+   char letter;
+   uint8_t rows[GLYPH_HEIGHT];
+};
+
+static const Glyph glyphs[] =
+{
+   { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+   { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+   { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+   { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+   { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+   { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+   { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+   { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+   { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+   { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+   { 'a', { 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F } },
+   { 'b', { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E } },
+   { 'c', { 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E } },
+   { 'd', { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F } },
+   { 'e', { 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E } },
+   { 'f', { 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 } },
+   { 'g', { 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E } },
+   { 'h', { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 } },
+   { 'i', { 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E } },
+   { 'j', { 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C } },
+   { 'k', { 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 } },
+   { 'l', { 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+   { 'm', { 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 } },
+   { 'n', { 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 } },
+   { 'o', { 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E } },
+   { 'p', { 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 } },
+   { 'q', { 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 } },
+   { 'r', { 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 } },
+   { 's', { 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E } },
+   { 't', { 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 } },
+   { 'u', { 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D } },
+   { 'v', { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+   { 'w', { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A } },
+   { 'x', { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 } },
+   { 'y', { 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E } },
+   { 'z', { 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F } },
+   { ':', { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+   { '-', { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 } },
+   { '.', { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } }
+};
+
+static const Glyph * findGlyph(char letter)
+{
+   if ('A' <= letter && letter <= 'Z')
+      letter = (char)(letter - 'A' + 'a');
+   for (const Glyph & glyph : glyphs)
+      if (glyph.letter == letter)
+         return &glyph;
+   return nullptr;
+}
+
+/*************************************************
+ * IMAGE : CONSTRUCT
+ * Black and opaque
+ *************************************************/
+Image::Image(int width, int height) :
+   width(width), height(height),
+   pixels((size_t)width * height * 4, 0)
+{
+   assert(width > 0 && height > 0);
+   for (size_t i = 3; i < pixels.size(); i += 4)
+      pixels[i] = 255;
+   clipNone();
+}
+
+/*************************************************
+ * IMAGE : GET PIXEL
+ *************************************************/
+uint32_t Image::getPixel(int x, int y) const
+{
+   if (x < 0 || x >= width || y < 0 || y >= height)
+      return 0;
+   const uint8_t * p = &pixels[((size_t)(height - 1 - y) * width + x) * 4];
+   return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+          ((uint32_t)p[2] << 8)  |  (uint32_t)p[3];
+}
+
+/*************************************************
+ * IMAGE : SET PIXEL
+ * Nothing outside the clip
+ *************************************************/
+inline void Image::setPixel(int x, int y, const int * rgb)
+{
+   if (x < clipX0 || x >= clipX1 || y < clipY0 || y >= clipY1)
+      return;
+   uint8_t * p = &pixels[((size_t)(height - 1 - y) * width + x) * 4];
+   p[0] = (uint8_t)rgb[0];
+   p[1] = (uint8_t)rgb[1];
+   p[2] = (uint8_t)rgb[2];
+   p[3] = 255;
+}
+
+/*************************************************
+ * IMAGE : CLEAR
+ *************************************************/
+void Image::clear(const int * rgb)
+{
+   // the first row, then copies of it
+   size_t sizeRow = (size_t)width * 4;
+   for (size_t i = 0; i < sizeRow; i += 4)
+   {
+      pixels[i + 0] = (uint8_t)rgb[0];
+      pixels[i + 1] = (uint8_t)rgb[1];
+      pixels[i + 2] = (uint8_t)rgb[2];
+      pixels[i + 3] = 255;
+   }
+   for (int y = 1; y < height; y++)
+      memcpy(&pixels[y * sizeRow], &pixels[0], sizeRow);
+}
+
+/*************************************************
+ * IMAGE : CLIP
+ *************************************************/
+void Image::clip(int x0, int y0, int x1, int y1)
+{
+   clipX0 = x0 < 0 ? 0 : x0;
+   clipY0 = y0 < 0 ? 0 : y0;
+   clipX1 = x1 > width  ? width  : x1;
+   clipY1 = y1 > height ? height : y1;
+}
+
+void Image::clipNone()
+{
+   clip(0, 0, width, height);
+}
+
+/*************************************************
+ * IMAGE : FILL RECT
+ * The pixels whose centers are in [x0, x1) by [y0, y1)
+ *************************************************/
+void Image::fillRect(double x0, double y0, double x1, double y1, const int * rgb)
+{
+   int xBegin = (int)ceil(x0 - 0.5);
+   int xEnd   = (int)ceil(x1 - 0.5);
+   int yBegin = (int)ceil(y0 - 0.5);
+   int yEnd   = (int)ceil(y1 - 0.5);
+   if (xBegin < clipX0) xBegin = clipX0;
+   if (xEnd   > clipX1) xEnd   = clipX1;
+   if (yBegin < clipY0) yBegin = clipY0;
+   if (yEnd   > clipY1) yEnd   = clipY1;
+
+   const uint8_t pixel[4] = { (uint8_t)rgb[0], (uint8_t)rgb[1], (uint8_t)rgb[2], 255 };
+   for (int y = yBegin; y < yEnd; y++)
+   {
+      uint8_t * p = &pixels[((size_t)(height - 1 - y) * width + xBegin) * 4];
+      for (int x = xBegin; x < xEnd; x++, p += 4)
+         memcpy(p, pixel, 4);
+   }
+}
+
+/*************************************************
+ * IMAGE : FILL TRIANGLE
+ * Every pixel center on the inside of all three
+ * edges, whichever way the corners go around
+ *************************************************/
+void Image::fillTriangle(const double x[3], const double y[3], const int * rgb)
+{
+   double area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+   if (area == 0.0)
+      return;
+   double sign = area > 0.0 ? 1.0 : -1.0;
+
+   int xBegin = (int)floor(fmin(x[0], fmin(x[1], x[2])));
+   int xEnd   = (int)ceil (fmax(x[0], fmax(x[1], x[2])));
+   int yBegin = (int)floor(fmin(y[0], fmin(y[1], y[2])));
+   int yEnd   = (int)ceil (fmax(y[0], fmax(y[1], y[2])));
+   if (xBegin < clipX0) xBegin = clipX0;
+   if (xEnd   > clipX1) xEnd   = clipX1;
+   if (yBegin < clipY0) yBegin = clipY0;
+   if (yEnd   > clipY1) yEnd   = clipY1;
+
+   for (int py = yBegin; py < yEnd; py++)
+      for (int px = xBegin; px < xEnd; px++)
+      {
+         double cx = px + 0.5;
+         double cy = py + 0.5;
+         bool inside = true;
+         for (int i = 0; i < 3 && inside; i++)
+         {
+            int j = (i + 1) % 3;
+            double edge = (x[j] - x[i]) * (cy - y[i]) - (y[j] - y[i]) * (cx - x[i]);
+            inside = edge * sign >= 0.0;
+         }
+         if (inside)
+            setPixel(px, py, rgb);
+      }
+}
+
+/*************************************************
+ * IMAGE : FILL QUAD
+ * Two triangles, as OpenGL draws GL_QUADS
+ *************************************************/
+void Image::fillQuad(const double x[4], const double y[4], const int * rgb)
+{
+   const double xFirst[3]  = { x[0], x[1], x[2] };
+   const double yFirst[3]  = { y[0], y[1], y[2] };
+   const double xSecond[3] = { x[0], x[2], x[3] };
+   const double ySecond[3] = { y[0], y[2], y[3] };
+   fillTriangle(xFirst,  yFirst,  rgb);
+   fillTriangle(xSecond, ySecond, rgb);
+}
+
+/*************************************************
+ * IMAGE : DRAW LINE
+ * One pixel wide, both ends included
+ *************************************************/
+void Image::drawLine(double x0, double y0, double x1, double y1, const int * rgb)
+{
+   int xa = (int)floor(x0);
+   int ya = (int)floor(y0);
+   int xb = (int)floor(x1);
+   int yb = (int)floor(y1);
+   int dx = abs(xb - xa);
+   int dy = -abs(yb - ya);
+   int sx = xa < xb ? 1 : -1;
+   int sy = ya < yb ? 1 : -1;
+   int error = dx + dy;
+
+   for (;;)
+   {
+      setPixel(xa, ya, rgb);
+      if (xa == xb && ya == yb)
+         break;
+      int error2 = 2 * error;
+      if (error2 >= dy)
+      {
+         error += dy;
+         xa += sx;
+      }
+      if (error2 <= dx)
+      {
+         error += dx;
+         ya += sy;
+      }
+   }
+}
+
+/*************************************************
+ * IMAGE : DRAW TEXT
+ *************************************************/
+void Image::drawText(double x, double y, const char * text, const int * rgb)
+{
+   int xPen = (int)floor(x);
+   int yBase = (int)floor(y);
+   for (const char * p = text; *p; p++, xPen += GLYPH_ADVANCE)
+   {
+      const Glyph * pGlyph = findGlyph(*p);
+      if (!pGlyph)
+         continue;
+      for (int row = 0; row < GLYPH_HEIGHT; row++)
+         for (int col = 0; col < GLYPH_WIDTH; col++)
+            if (pGlyph->rows[row] & (0x10 >> col))
+               setPixel(xPen + col, yBase + GLYPH_HEIGHT - 1 - row, rgb);
+   }
+}
+
+int Image::getTextWidth(const char * text)
+{
+   int width = 0;
+   for (const char * p = text; *p; p++)
+      width += GLYPH_ADVANCE;
+   return width;
+}
+
+/*************************************************
+ * IMAGE : WRITE PPM
+ * Binary RGB, the alpha is always opaque anyway
+ *************************************************/
+void Image::writePpm(ostream & out) const
+{
+   out << "P6\n" << width << " " << height << "\n255\n";
+   vector <char> row((size_t)width * 3);
+   for (int y = 0; y < height; y++)
+   {
+      const uint8_t * p = &pixels[(size_t)y * width * 4];
+      for (int x = 0; x < width; x++)
+      {
+         row[x * 3 + 0] = (char)p[x * 4 + 0];
+         row[x * 3 + 1] = (char)p[x * 4 + 1];
+         row[x * 3 + 2] = (char)p[x * 4 + 2];
+      }
+      out.write(row.data(), row.size());
+   }
+}
+
+/*************************************************
+ * CRC 32
+ * The checksum of every PNG chunk
+ *************************************************/
+static uint32_t crc32(const uint8_t * data, size_t size, uint32_t crc)
+{
+   static uint32_t table[256];
+   static bool fTable = false;
+   if (!fTable)
+   {
+      for (uint32_t n = 0; n < 256; n++)
+      {
+         uint32_t c = n;
+         for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+         table[n] = c;
+      }
+      fTable = true;
+   }
+
+   crc = ~crc;
+   for (size_t i = 0; i < size; i++)
+      crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+   return ~crc;
+}
+
+static void put32(vector <uint8_t> & bytes, uint32_t value)
+{
+   bytes.push_back((uint8_t)(value >> 24));
+   bytes.push_back((uint8_t)(value >> 16));
+   bytes.push_back((uint8_t)(value >> 8));
+   bytes.push_back((uint8_t)(value));
+}
+
+/*************************************************
+ * WRITE CHUNK
+ * Length, type, data, and the CRC of the type and data
+ *************************************************/
+static void writeChunk(ostream & out, const char * type, const vector <uint8_t> & data)
+{
+   vector <uint8_t> bytes;
+   put32(bytes, (uint32_t)data.size());
+   bytes.insert(bytes.end(), type, type + 4);
+   bytes.insert(bytes.end(), data.begin(), data.end());
+   put32(bytes, crc32(&bytes[4], bytes.size() - 4, 0));
+   out.write((const char *)bytes.data(), bytes.size());
+}
+
+/*************************************************
+ * BIT WRITER
+ * Deflate packs its bits starting from the low bit
+ * of each byte
+ *************************************************/
+class BitWriter
+{
+public:
+   BitWriter(vector <uint8_t> & bytes) : bytes(bytes), bits(0), numBits(0) {}
+
+   void put(uint32_t value, int num)
+   {
+      bits |= value << numBits;
+      numBits += num;
+      while (numBits >= 8)
+      {
+         bytes.push_back((uint8_t)bits);
+         bits >>= 8;
+         numBits -= 8;
+      }
+   }
+
+   // Huffman codes go in from their high bit
+   void putCode(uint32_t code, int num)
+   {
+      uint32_t reversed = 0;
+      for (int i = 0; i < num; i++)
+         reversed |= ((code >> i) & 1) << (num - 1 - i);
+      put(reversed, num);
+   }
+
+   void finish()
+   {
+      if (numBits > 0)
+         bytes.push_back((uint8_t)bits);
+      bits = 0;
+      numBits = 0;
+   }
+
+private:
+   vector <uint8_t> & bytes;
+   uint32_t bits;
+   int numBits;
+};
+
+/*************************************************
+ * PUT LITERAL
+ * A byte or a length symbol in the fixed code
+ *************************************************/
+static void putLiteral(BitWriter & out, int symbol)
+{
+   if (symbol < 144)
+      out.putCode(0x30 + symbol, 8);
+   else if (symbol < 256)
+      out.putCode(0x190 + symbol - 144, 9);
+   else if (symbol < 280)
+      out.putCode(symbol - 256, 7);
+   else
+      out.putCode(0xC0 + symbol - 280, 8);
+}
+
+/*************************************************
+ * PUT MATCH
+ * "Copy length bytes from distance back"
+ *************************************************/
+static void putMatch(BitWriter & out, int length, int distance)
+{
+   static const int lengthBase[29] =
+   {
+      3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+   };
+   static const int lengthExtra[29] =
+   {
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+   };
+   static const int distanceBase[30] =
+   {
+      1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+      257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+      8193, 12289, 16385, 24577
+   };
+   static const int distanceExtra[30] =
+   {
+      0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+      7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+   };
+
+   int code = 28;
+   while (lengthBase[code] > length)
+      code--;
+   putLiteral(out, 257 + code);
+   out.put(length - lengthBase[code], lengthExtra[code]);
+
+   code = 29;
+   while (distanceBase[code] > distance)
+      code--;
+   out.putCode(code, 5);
+   out.put(distance - distanceBase[code], distanceExtra[code]);
+}
+
+/*************************************************
+ * DEFLATE
+ * One block with the fixed codes. The only matches
+ * we look for are the pixel above and the pixel to
+ * the left, which is where a picture repeats
+ *************************************************/
+static void deflate(const vector <uint8_t> & raw, size_t sizeRow, vector <uint8_t> & bytes)
+{
+   const int MAX_LENGTH = 258;
+   const size_t MAX_DISTANCE = 32768;
+   const size_t distances[2] = { sizeRow, 4 };
+
+   BitWriter out(bytes);
+   out.put(1, 1);          // the last block
+   out.put(1, 2);          // with the fixed codes
+   size_t size = raw.size();
+   size_t i = 0;
+   while (i < size)
+   {
+      int lengthBest = 0;
+      size_t distanceBest = 0;
+      for (size_t distance : distances)
+      {
+         if (lengthBest == MAX_LENGTH || distance > i || distance > MAX_DISTANCE)
+            continue;
+         // eight bytes at a time, then one at a time
+         int lengthMax = size - i < (size_t)MAX_LENGTH ? (int)(size - i) : MAX_LENGTH;
+         const uint8_t * p = &raw[i];
+         int length = 0;
+         uint64_t word;
+         uint64_t wordBack;
+         while (length + 8 <= lengthMax)
+         {
+            memcpy(&word,     p + length,            8);
+            memcpy(&wordBack, p + length - distance, 8);
+            if (word != wordBack)
+               break;
+            length += 8;
+         }
+         while (length < lengthMax && p[length] == p[(ptrdiff_t)length - (ptrdiff_t)distance])
+            length++;
+         if (length > lengthBest)
+         {
+            lengthBest = length;
+            distanceBest = distance;
+         }
+      }
+
+      if (lengthBest >= 3)
+      {
+         putMatch(out, lengthBest, (int)distanceBest);
+         i += lengthBest;
+      }
+      else
+         putLiteral(out, raw[i++]);
+   }
+   putLiteral(out, 256);   // end of the block
+   out.finish();
+}
+
+/*************************************************
+ * ADLER 32
+ * The zlib checksum, taking the modulus only as
+ * often as the sums could overflow
+ *************************************************/
+static uint32_t adler32(const vector <uint8_t> & data)
+{
+   const size_t MAX_RUN = 5552;
+   uint32_t a = 1;
+   uint32_t b = 0;
+   for (size_t i = 0; i < data.size(); )
+   {
+      size_t end = data.size() - i < MAX_RUN ? data.size() : i + MAX_RUN;
+      for (; i < end; i++)
+      {
+         a += data[i];
+         b += a;
+      }
+      a %= 65521;
+      b %= 65521;
+   }
+   return (b << 16) | a;
+}
+
+/*************************************************
+ * IMAGE : WRITE PNG
+ * 8-bit RGBA with no filtering, in one zlib stream
+ *************************************************/
+void Image::writePng(ostream & out) const
+{
+   const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+   out.write((const char *)signature, sizeof(signature));
+
+   vector <uint8_t> header;
+   put32(header, (uint32_t)width);
+   put32(header, (uint32_t)height);
+   header.push_back(8);      // bits per channel
+   header.push_back(6);      // RGBA
+   header.push_back(0);      // deflate
+   header.push_back(0);      // adaptive filtering
+   header.push_back(0);      // not interlaced
+   writeChunk(out, "IHDR", header);
+
+   // each row starts with its filter, none
+   size_t sizeRow = (size_t)width * 4;
+   vector <uint8_t> raw;
+   raw.reserve((sizeRow + 1) * height);
+   for (int y = 0; y < height; y++)
+   {
+      raw.push_back(0);
+      raw.insert(raw.end(), pixels.begin() + y * sizeRow, pixels.begin() + (y + 1) * sizeRow);
+   }
+
+   vector <uint8_t> zlib;
+   zlib.push_back(0x78);     // deflate, 32K window
+   zlib.push_back(0x01);     // no preset dictionary, fastest
+   deflate(raw, sizeRow + 1, zlib);
+   put32(zlib, adler32(raw));
+   writeChunk(out, "IDAT", zlib);
+
+   writeChunk(out, "IEND", vector <uint8_t> ());
+}
+
+/*************************************************
+ * IMAGE : WRITE
+ * A PPM if the name ends in ".ppm", otherwise a PNG
+ *************************************************/
+bool Image::write(const string & fileName) const
+{
+   ofstream fout(fileName.c_str(), ios::binary);
+   if (fout.fail())
+      return false;
+   size_t size = fileName.size();
+   if (size >= 4 && fileName.compare(size - 4, 4, ".ppm") == 0)
+      writePpm(fout);
+   else
+      writePng(fout);
+   return !fout.fail();
+}
@@ -0,0 +1,70 @@
+/***********************************************************************
+ * Header File:
+ *    IMAGE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A picture in memory, one RGBA pixel at a time, that we can draw
+ *    quads, lines, and text into and save as PPM or PNG. It knows
+ *    nothing of OpenGL, so a board can be drawn without a window.
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>     // for VECTOR of pixels
+#include <string>     // for STRING file names
+#include <iostream>   // for OSTREAM
+#include <cstdint>    // for UINT8_T
+
+class TestImage;
+
+/***************************************************
+ * IMAGE
+ * Like OpenGL, x goes right and y goes up from the
+ * bottom-left corner, and a pixel is covered when
+ * its center is inside what is drawn
+ ***************************************************/
+class Image
+{
+   friend TestImage;
+public:
+   Image(int width, int height);
+
+   int getWidth()  const { return width;  }
+   int getHeight() const { return height; }
+
+   // 0xRRGGBBAA, or 0 off the image
+   uint32_t getPixel(int x, int y) const;
+
+   // fill everything, ignoring the clip
+   void clear(const int * rgb);
+
+   // only draw inside x0 <= x < x1, y0 <= y < y1 until clipNone()
+   void clip(int x0, int y0, int x1, int y1);
+   void clipNone();
+
+   // drawing, with the colors as 0...255 red, green, and blue
+   void fillRect(double x0, double y0, double x1, double y1, const int * rgb);
+   void fillQuad(const double x[4], const double y[4], const int * rgb);
+   void drawLine(double x0, double y0, double x1, double y1, const int * rgb);
+
+   // a line of text in a 5x7 font with its baseline at y. Capitals
+   // are drawn as small letters, and what we have no glyph for is
+   // left blank
+   void drawText(double x, double y, const char * text, const int * rgb);
+   static int getTextWidth(const char * text);
+
+   // save it, top row first
+   void writePpm(std::ostream & out) const;
+   void writePng(std::ostream & out) const;
+   bool write(const std::string & fileName) const;   // by its extension
+
+private:
+   void setPixel(int x, int y, const int * rgb);
+   void fillTriangle(const double x[3], const double y[3], const int * rgb);
+
+   int width;
+   int height;
+   std::vector <uint8_t> pixels;   // RGBA, the top row first
+   int clipX0, clipY0, clipX1, clipY1;
+};
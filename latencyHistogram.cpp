@@ -0,0 +1,101 @@
+/***********************************************************************
+ * Source File:
+ *    LATENCY HISTOGRAM
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Times counted in buckets that get wider as the times get longer
+ ************************************************************************/
+
+#include "latencyHistogram.h"
+#include <cassert>
+using namespace std;
+
+/*************************************************
+ * LATENCY HISTOGRAM : CONSTRUCT
+ *************************************************/
+LatencyHistogram::LatencyHistogram() : count(0), sum(0), max(0)
+{
+   for (int i = 0; i < NUM_BUCKETS; i++)
+      buckets[i] = 0;
+}
+
+/*************************************************
+ * LATENCY HISTOGRAM : BUCKET
+ * Under NUM_LINEAR, the time itself. Above, which
+ * power of two and which eighth of it
+ *************************************************/
+int LatencyHistogram::bucket(uint64_t ns)
+{
+   if (ns < (uint64_t)NUM_LINEAR)
+      return (int)ns;
+
+   int exponent = 63;
+   while (!(ns >> exponent))
+      exponent--;
+   int split = (int)((ns >> (exponent - 3)) & (NUM_SPLIT - 1));
+   int i = NUM_LINEAR + (exponent - 4) * NUM_SPLIT + split;
+   assert(0 <= i && i < NUM_BUCKETS);
+   return i;
+}
+
+/*************************************************
+ * LATENCY HISTOGRAM : BUCKET MIDDLE
+ *************************************************/
+double LatencyHistogram::bucketMiddle(int i)
+{
+   if (i < NUM_LINEAR)
+      return (double)i;
+
+   int exponent = (i - NUM_LINEAR) / NUM_SPLIT + 4;
+   int split    = (i - NUM_LINEAR) % NUM_SPLIT;
+   double width = (double)(1ull << (exponent - 3));
+   double low   = (double)(1ull << exponent) + split * width;
+   return low + width / 2.0;
+}
+
+/*************************************************
+ * LATENCY HISTOGRAM : RECORD
+ *************************************************/
+void LatencyHistogram::record(uint64_t ns)
+{
+   buckets[bucket(ns)].fetch_add(1, memory_order_relaxed);
+   count.fetch_add(1, memory_order_relaxed);
+   sum.fetch_add(ns, memory_order_relaxed);
+
+   uint64_t maxSoFar = max.load(memory_order_relaxed);
+   while (ns > maxSoFar && !max.compare_exchange_weak(maxSoFar, ns, memory_order_relaxed))
+      ;
+}
+
+/*************************************************
+ * LATENCY HISTOGRAM : GET MEAN
+ *************************************************/
+double LatencyHistogram::getMean() const
+{
+   uint64_t num = getCount();
+   return num ? (double)sum.load(memory_order_relaxed) / (double)num : 0.0;
+}
+
+/*************************************************
+ * LATENCY HISTOGRAM : PERCENTILE
+ * Walk up the buckets until we pass p of the count
+ *************************************************/
+double LatencyHistogram::percentile(double p) const
+{
+   uint64_t num = getCount();
+   if (num == 0)
+      return 0.0;
+
+   uint64_t rank = (uint64_t)(p * (double)num + 0.5);
+   if (rank < 1)
+      rank = 1;
+   uint64_t seen = 0;
+   for (int i = 0; i < NUM_BUCKETS; i++)
+   {
+      seen += buckets[i].load(memory_order_relaxed);
+      if (seen >= rank)
+         return bucketMiddle(i);
+   }
+   return (double)getMax();
+}
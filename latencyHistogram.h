@@ -0,0 +1,56 @@
+/***********************************************************************
+ * Header File:
+ *    LATENCY HISTOGRAM
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Count how long things took in buckets that get wider as the times
+ *    get longer, so any thread can add a time with one atomic add and
+ *    we can still read off the median and the 99th percentile to within
+ *    an eighth of their value.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>     // for ATOMIC counts
+#include <cstdint>    // for UINT64_T
+
+class TestLatencyHistogram;
+
+/***************************************************
+ * LATENCY HISTOGRAM
+ * Times in nanoseconds. Under 16ns each has its own
+ * bucket, then every power of two is split in eight
+ ***************************************************/
+class LatencyHistogram
+{
+   friend TestLatencyHistogram;
+public:
+   LatencyHistogram();
+
+   // safe from any thread
+   void record(uint64_t ns);
+
+   // what was recorded so far. Another thread may be recording, so
+   // these are only as exact as the moment they are read
+   uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+   uint64_t getMax()   const { return max.load(std::memory_order_relaxed);   }
+   double   getMean()  const;
+
+   // the time p (0...1) of the recorded times are at or under, as the
+   // middle of its bucket. 0 when nothing was recorded
+   double percentile(double p) const;
+
+private:
+   static const int NUM_LINEAR = 16;   // one bucket per nanosecond under this
+   static const int NUM_SPLIT  = 8;    // buckets in each power of two above it
+   static const int NUM_BUCKETS = NUM_LINEAR + (64 - 4) * NUM_SPLIT;
+
+   static int bucket(uint64_t ns);
+   static double bucketMiddle(int i);
+
+   std::atomic <uint64_t> buckets[NUM_BUCKETS];
+   std::atomic <uint64_t> count;
+   std::atomic <uint64_t> sum;
+   std::atomic <uint64_t> max;
+};
@@ -0,0 +1,131 @@
+/***********************************************************************
+ * Source File:
+ *    LOAD GENERATOR
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Keep a session server busy with batches of moves to validate from
+ *    a few clients at once, and say how many it got through a second.
+ ************************************************************************/
+
+#ifndef _WIN32
+
+#include "loadGenerator.h"
+#include "sessionSocket.h"
+#include "latencyHistogram.h"
+#include "board.h"
+#include <vector>       // for VECTOR of items and threads
+#include <thread>       // for THREAD per client
+#include <atomic>       // for ATOMIC totals
+#include <chrono>       // for STEADY_CLOCK
+#include <iomanip>      // for SETPRECISION
+using namespace std;
+
+/*************************************************
+ * LOAD ITEMS
+ * Every move the side to move has in a few
+ * positions, and one in eight that is no move at
+ * all, so the server says no now and then too
+ *************************************************/
+static vector <BatchItem> loadItems()
+{
+   const char * fens[] =
+   {
+      "1n4n1/8/8/8/8/8/8/1N4N1 w - - 0 1",
+      "8/8/2n1n3/8/3N4/8/1N3n2/8 w - - 0 1",
+      "8/8/2n1n3/8/3N4/8/1N3n2/8 b - - 0 1",
+      "n6n/8/8/3NN3/3nn3/8/8/N6N w - - 0 1"
+   };
+   vector <BatchItem> items;
+   Board board(nullptr, true /*noreset*/);
+   for (const char * fen : fens)
+   {
+      board.setFen(fen);
+      MoveList moves;
+      board.getMoves(moves, board.whiteTurn());
+      for (const Move & move : moves)
+      {
+         int source = move.getSource().getLocation();
+         int dest   = move.getDest().getLocation();
+         string smith = { char('a' + source % 8), char('1' + source / 8),
+                          char('a' + dest % 8),   char('1' + dest / 8) };
+         items.push_back({ 0, fen, smith });
+         if (items.size() % 8 == 0)
+            items.push_back({ 0, fen, "a1a1" });
+      }
+   }
+   return items;
+}
+
+/*************************************************
+ * LOAD GENERATE
+ *************************************************/
+double loadGenerate(const string & path, int numClients, int sizeBatch,
+                    double seconds, ostream & out)
+{
+   const vector <BatchItem> items = loadItems();
+   LatencyHistogram latency;
+   atomic <uint64_t> numValidated(0);
+   atomic <uint64_t> numLegal(0);
+   atomic <int> numConnected(0);
+
+   auto start = chrono::steady_clock::now();
+   auto end = start + chrono::duration_cast <chrono::steady_clock::duration>
+                      (chrono::duration <double> (seconds));
+   vector <thread> clients;
+   for (int c = 0; c < numClients; c++)
+      clients.push_back(thread([&, c]()
+      {
+         SessionClient client;
+         if (!client.connect(path))
+            return;
+         numConnected++;
+
+         vector <BatchItem> batch(sizeBatch);
+         vector <uint8_t> payload;
+         vector <BatchResult> results;
+         Response response;
+         size_t next = size_t(c) * 7;     // each client starts somewhere else
+         while (chrono::steady_clock::now() < end)
+         {
+            for (BatchItem & item : batch)
+               item = items[next++ % items.size()];
+            encodeBatch(payload, batch);
+
+            auto sent = chrono::steady_clock::now();
+            if (!client.call(REQUEST_BATCH, 0, response, payload.data(), payload.size()) ||
+                response.status != STATUS_OK ||
+                !decodeBatchResults(response.payload.data(), response.payload.size(), results))
+               return;
+            latency.record(uint64_t(chrono::duration_cast <chrono::nanoseconds>
+                                    (chrono::steady_clock::now() - sent).count()));
+
+            uint64_t legal = 0;
+            for (const BatchResult & result : results)
+               legal += result.status == STATUS_OK ? 1 : 0;
+            numValidated += results.size();
+            numLegal += legal;
+         }
+      }));
+   for (thread & client : clients)
+      client.join();
+
+   double elapsed = chrono::duration <double> (chrono::steady_clock::now() - start).count();
+   if (numConnected == 0)
+   {
+      out << "cannot connect to " << path << '\n';
+      return 0.0;
+   }
+
+   double perSecond = double(numValidated) / elapsed;
+   out << fixed << setprecision(1)
+       << numConnected << " clients, batches of " << sizeBatch << ", "
+       << elapsed << "s\n"
+       << "   " << numValidated << " validated, " << numLegal << " legal\n"
+       << "   " << setprecision(0) << perSecond << " validations/sec\n"
+       << "   batch round trip p50 " << setprecision(1) << latency.percentile(0.50) / 1000.0
+       << "us, p99 " << latency.percentile(0.99) / 1000.0 << "us\n";
+   return perSecond;
+}
+
+#endif // !_WIN32
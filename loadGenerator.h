@@ -0,0 +1,25 @@
+/***********************************************************************
+ * Header File:
+ *    LOAD GENERATOR
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Keep a session server busy with batches of moves to validate from
+ *    a few clients at once, and say how many it got through a second.
+ ************************************************************************/
+
+#pragma once
+
+#ifndef _WIN32
+
+#include <string>       // for STRING path
+#include <iostream>     // for OSTREAM
+
+// each client sends a batch of sizeBatch moves on FENs, waits for the
+// answer, and sends the next, for the given seconds. Up to NUM_BATCH_MAX
+// moves fit in a frame. The report goes to out; the validations per
+// second come back, or 0 if we could not connect
+double loadGenerate(const std::string & path, int numClients, int sizeBatch,
+                    double seconds, std::ostream & out);
+
+#endif // !_WIN32
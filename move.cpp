@@ -156,18 +156,45 @@ Move::Move(string smith, bool white)
 	text = smith;
 }
 
-//Move::Move(Position s, Position d, MoveType m, PieceType cap, PieceType pro, bool white)
-//{
-//	isWhite = white;
-//	source = s;
-//	dest = d;
-//	promote = pro;
-//	capture = cap;
-//	moveType = m;
-//	//text = source + dest; //+ if cap, pro, move;
-//}
-
-Position Move::getSource()
+/***************************************************
+ * MOVE : POSITION CONSTRUCTOR
+ * Build a move from its parts, as the pieces do when
+ * they generate their possible moves
+ ***************************************************/
+Move::Move(const Position & s, const Position & d, MoveType m, PieceType cap, PieceType pro, bool white)
+{
+	isWhite = white;
+	source = s;
+	dest = d;
+	promote = pro;
+	capture = cap;
+	moveType = m;
+	getText(s, d, m, cap, pro);
+}
+
+/***************************************************
+ * MOVE : LESS THAN
+ * Order moves by source, then destination, then promotion
+ * so they can live in a std::set
+ ***************************************************/
+bool Move::operator<(const Move& rhs) const
+{
+	if (source != rhs.source)
+		return source < rhs.source;
+	if (dest != rhs.dest)
+		return dest < rhs.dest;
+	return promote < rhs.promote;
+}
+
+/***************************************************
+ * MOVE : EQUALS
+ ***************************************************/
+bool Move::operator==(const Move& rhs) const
+{
+	return source == rhs.source && dest == rhs.dest && promote == rhs.promote;
+}
+
+Position Move::getSource() const
 {
 	return source;
 }
@@ -177,7 +204,7 @@ void Move::setSource(Position s)
 	source = s;
 }
 
-Position Move::getDest()
+Position Move::getDest() const
 {
 	return dest;
 }
@@ -188,7 +215,7 @@ void Move::setDest(Position d)
 	//text += d;
 }
 
-PieceType Move::getPromote()
+PieceType Move::getPromote() const
 {
 	return promote;
 }
@@ -198,7 +225,7 @@ void Move::setPromote(PieceType pro)
 	promote = pro;
 }
 
-PieceType Move::getCapture()
+PieceType Move::getCapture() const
 {
 	return capture;
 }
@@ -208,7 +235,7 @@ void Move::setCapture(PieceType cap)
 	capture = cap;
 }
 
-Move::MoveType Move::getMoveType()
+Move::MoveType Move::getMoveType() const
 {
 	return moveType;
 }
@@ -218,7 +245,7 @@ void Move::setMoveType(MoveType m)
 	moveType = m;
 }
 
-bool Move::getIsWhite()
+bool Move::getIsWhite() const
 {
 	return isWhite;
 }
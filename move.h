@@ -33,25 +33,26 @@ public:
    // constructors
    Move();
    Move(string smith, bool white = true);
+   Move(const Position & s, const Position & d, MoveType m = MOVE,
+        PieceType cap = SPACE, PieceType pro = SPACE, bool white = true);
    //Move(const string& rhs) {}
-   bool operator<(const Move& rhs) const { return true; }
-   bool operator==(const Move& rhs) const { return true; }
+   bool operator<(const Move& rhs) const;
+   bool operator==(const Move& rhs) const;
    void read(const string& rhs) {}
    //string getText() const { return std::string(""); }
-   //Move(Position s, Position d, MoveType m, PieceType cap, PieceType pro, bool white);
 
    // methods
-   Position getSource();
+   Position getSource() const;
    void setSource(Position s);
-   Position getDest();
+   Position getDest() const;
    void setDest(Position d);
-   PieceType getPromote();
+   PieceType getPromote() const;
    void setPromote(PieceType pro);
-   PieceType getCapture();
+   PieceType getCapture() const;
    void setCapture(PieceType cap);
-   MoveType getMoveType();
+   MoveType getMoveType() const;
    void setMoveType(MoveType m);
-   bool getIsWhite();
+   bool getIsWhite() const;
    void setIsWhite(bool w);
    string getText();
    string getText(Position sour, Position des, MoveType type, PieceType cap = SPACE, PieceType pro = SPACE);
@@ -0,0 +1,400 @@
+/***********************************************************************
+ * Source File:
+ *    NNUE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A small efficiently updatable neural network evaluation. The first
+ *    layer is a sum of weight columns, one per (king square, piece,
+ *    square) feature, so a move only adds and subtracts a few columns.
+ *    The vector work is done by AVX2, SSE4.1, or plain C++ kernels,
+ *    picked when the program starts according to what the CPU can do.
+ ************************************************************************/
+
+#include "nnue.h"
+#include <cstdio>      // for FOPEN
+#include <cstring>     // for STRCMP and MEMCMP
+#include <random>      // for MT19937
+#include <cassert>
+using namespace std;
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NNUE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#define TARGET_SSE41
+#else // !_MSC_VER
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#endif // !_MSC_VER
+#endif // NNUE_X86
+
+const char     NNUE_MAGIC[4] = { 'N', 'N', 'U', 'E' };
+const uint32_t NNUE_VERSION  = 1;
+const int      NNUE_CLIP     = 127;   // clipped ReLU ceiling
+const int      NNUE_SCALE    = 64;    // output units per centipawn
+
+/*************************************************
+ * KERNEL
+ * The three vector operations the network needs
+ *************************************************/
+struct Kernel
+{
+   const char * name;
+   void (*add)(int16_t * acc, const int16_t * column);
+   void (*sub)(int16_t * acc, const int16_t * column);
+   int32_t (*dot)(const int16_t * acc, const int16_t * weights);
+};
+
+/*************************************************
+ * SCALAR KERNEL
+ * Works everywhere
+ *************************************************/
+static void addScalar(int16_t * acc, const int16_t * column)
+{
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+      acc[i] += column[i];
+}
+static void subScalar(int16_t * acc, const int16_t * column)
+{
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+      acc[i] -= column[i];
+}
+static int32_t dotScalar(const int16_t * acc, const int16_t * weights)
+{
+   int32_t sum = 0;
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+   {
+      int value = acc[i] < 0 ? 0 : (acc[i] > NNUE_CLIP ? NNUE_CLIP : acc[i]);
+      sum += value * weights[i];
+   }
+   return sum;
+}
+
+#ifdef NNUE_X86
+/*************************************************
+ * SSE4.1 KERNEL
+ * Eight values at a time
+ *************************************************/
+TARGET_SSE41 static void addSse41(int16_t * acc, const int16_t * column)
+{
+   for (int i = 0; i < NNUE_HIDDEN; i += 8)
+   {
+      __m128i a = _mm_loadu_si128((const __m128i *)(acc + i));
+      __m128i c = _mm_loadu_si128((const __m128i *)(column + i));
+      _mm_storeu_si128((__m128i *)(acc + i), _mm_add_epi16(a, c));
+   }
+}
+TARGET_SSE41 static void subSse41(int16_t * acc, const int16_t * column)
+{
+   for (int i = 0; i < NNUE_HIDDEN; i += 8)
+   {
+      __m128i a = _mm_loadu_si128((const __m128i *)(acc + i));
+      __m128i c = _mm_loadu_si128((const __m128i *)(column + i));
+      _mm_storeu_si128((__m128i *)(acc + i), _mm_sub_epi16(a, c));
+   }
+}
+TARGET_SSE41 static int32_t dotSse41(const int16_t * acc, const int16_t * weights)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i clip = _mm_set1_epi16(NNUE_CLIP);
+   __m128i sum = _mm_setzero_si128();
+   for (int i = 0; i < NNUE_HIDDEN; i += 8)
+   {
+      __m128i a = _mm_loadu_si128((const __m128i *)(acc + i));
+      __m128i w = _mm_loadu_si128((const __m128i *)(weights + i));
+      a = _mm_min_epi16(_mm_max_epi16(a, zero), clip);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(a, w));
+   }
+   return _mm_extract_epi32(sum, 0) + _mm_extract_epi32(sum, 1) +
+          _mm_extract_epi32(sum, 2) + _mm_extract_epi32(sum, 3);
+}
+
+/*************************************************
+ * AVX2 KERNEL
+ * Sixteen values at a time
+ *************************************************/
+TARGET_AVX2 static void addAvx2(int16_t * acc, const int16_t * column)
+{
+   for (int i = 0; i < NNUE_HIDDEN; i += 16)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i *)(acc + i));
+      __m256i c = _mm256_loadu_si256((const __m256i *)(column + i));
+      _mm256_storeu_si256((__m256i *)(acc + i), _mm256_add_epi16(a, c));
+   }
+}
+TARGET_AVX2 static void subAvx2(int16_t * acc, const int16_t * column)
+{
+   for (int i = 0; i < NNUE_HIDDEN; i += 16)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i *)(acc + i));
+      __m256i c = _mm256_loadu_si256((const __m256i *)(column + i));
+      _mm256_storeu_si256((__m256i *)(acc + i), _mm256_sub_epi16(a, c));
+   }
+}
+TARGET_AVX2 static int32_t dotAvx2(const int16_t * acc, const int16_t * weights)
+{
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i clip = _mm256_set1_epi16(NNUE_CLIP);
+   __m256i sum = _mm256_setzero_si256();
+   for (int i = 0; i < NNUE_HIDDEN; i += 16)
+   {
+      __m256i a = _mm256_loadu_si256((const __m256i *)(acc + i));
+      __m256i w = _mm256_loadu_si256((const __m256i *)(weights + i));
+      a = _mm256_min_epi16(_mm256_max_epi16(a, zero), clip);
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, w));
+   }
+   __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                _mm256_extracti128_si256(sum, 1));
+   half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+   half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+   return _mm_cvtsi128_si32(half);
+}
+
+/*************************************************
+ * CPU SUPPORTS
+ * Can this processor run the instructions?
+ *************************************************/
+static bool cpuSupports(const char * name)
+{
+#ifdef _MSC_VER
+   int info[4];
+   __cpuid(info, 0);
+   int idMax = info[0];
+   __cpuid(info, 1);
+   bool fSse41   = (info[2] & (1 << 19)) != 0;
+   bool fOsxsave = (info[2] & (1 << 27)) != 0;
+   bool fAvx     = (info[2] & (1 << 28)) != 0;
+   if (strcmp(name, "sse4.1") == 0)
+      return fSse41;
+   if (idMax < 7 || !fOsxsave || !fAvx || (_xgetbv(0) & 0x6) != 0x6)
+      return false;
+   __cpuidex(info, 7, 0);
+   return (info[1] & (1 << 5)) != 0;
+#else // !_MSC_VER
+   __builtin_cpu_init();
+   if (strcmp(name, "sse4.1") == 0)
+      return __builtin_cpu_supports("sse4.1");
+   return __builtin_cpu_supports("avx2");
+#endif // !_MSC_VER
+}
+#endif // NNUE_X86
+
+const Kernel KERNEL_SCALAR = { "scalar", addScalar, subScalar, dotScalar };
+#ifdef NNUE_X86
+const Kernel KERNEL_SSE41  = { "sse4.1", addSse41,  subSse41,  dotSse41  };
+const Kernel KERNEL_AVX2   = { "avx2",   addAvx2,   subAvx2,   dotAvx2   };
+#endif // NNUE_X86
+
+/*************************************************
+ * BEST KERNEL
+ * The fastest kernel this CPU can run
+ *************************************************/
+static const Kernel * bestKernel()
+{
+#ifdef NNUE_X86
+   if (cpuSupports("avx2"))
+      return &KERNEL_AVX2;
+   if (cpuSupports("sse4.1"))
+      return &KERNEL_SSE41;
+#endif // NNUE_X86
+   return &KERNEL_SCALAR;
+}
+
+static const Kernel * pKernel = bestKernel();
+
+/*************************************************
+ * NETWORK : GET KERNEL
+ *************************************************/
+const char * Network::getKernel()
+{
+   return pKernel->name;
+}
+
+/*************************************************
+ * NETWORK : SET KERNEL
+ * Force a kernel, for benchmarking. Refuses a kernel the
+ * CPU cannot run.
+ *************************************************/
+bool Network::setKernel(const char * name)
+{
+   if (strcmp(name, KERNEL_SCALAR.name) == 0)
+   {
+      pKernel = &KERNEL_SCALAR;
+      return true;
+   }
+#ifdef NNUE_X86
+   if (strcmp(name, KERNEL_SSE41.name) == 0 && cpuSupports("sse4.1"))
+   {
+      pKernel = &KERNEL_SSE41;
+      return true;
+   }
+   if (strcmp(name, KERNEL_AVX2.name) == 0 && cpuSupports("avx2"))
+   {
+      pKernel = &KERNEL_AVX2;
+      return true;
+   }
+#endif // NNUE_X86
+   return false;
+}
+
+/*************************************************
+ * NETWORK : CONSTRUCT
+ * All zeros until we load or randomize
+ *************************************************/
+Network::Network() : weights((size_t)NNUE_INPUTS * NNUE_HIDDEN, 0), outputBias(0)
+{
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+      biases[i] = 0;
+   for (int i = 0; i < 2 * NNUE_HIDDEN; i++)
+      outputWeights[i] = 0;
+}
+
+/*************************************************
+ * NETWORK : LOAD
+ * The file is little-endian:
+ *    "NNUE", version, hidden size   (4 bytes each)
+ *    biases          int16[hidden]
+ *    weights         int16[inputs][hidden]
+ *    output weights  int16[2 * hidden]
+ *    output bias     int32
+ *************************************************/
+bool Network::load(const char * fileName)
+{
+   FILE * fIn = fopen(fileName, "rb");
+   if (!fIn)
+      return false;
+
+   char magic[4];
+   uint32_t version = 0;
+   uint32_t hidden = 0;
+   bool fOK =
+      fread(magic,    sizeof(magic),   1, fIn) == 1 &&
+      memcmp(magic, NNUE_MAGIC, sizeof(magic)) == 0 &&
+      fread(&version, sizeof(version), 1, fIn) == 1 && version == NNUE_VERSION &&
+      fread(&hidden,  sizeof(hidden),  1, fIn) == 1 && hidden == NNUE_HIDDEN;
+
+   // read into a copy so a bad file leaves us as we were
+   Network network;
+   fOK = fOK &&
+      fread(network.biases, sizeof(int16_t), NNUE_HIDDEN, fIn) == (size_t)NNUE_HIDDEN &&
+      fread(network.weights.data(), sizeof(int16_t), network.weights.size(), fIn) ==
+         network.weights.size() &&
+      fread(network.outputWeights, sizeof(int16_t), 2 * NNUE_HIDDEN, fIn) ==
+         (size_t)(2 * NNUE_HIDDEN) &&
+      fread(&network.outputBias, sizeof(int32_t), 1, fIn) == 1 &&
+      fgetc(fIn) == EOF;
+   fclose(fIn);
+
+   if (fOK)
+      *this = network;
+   return fOK;
+}
+
+/*************************************************
+ * NETWORK : SAVE
+ *************************************************/
+bool Network::save(const char * fileName) const
+{
+   FILE * fOut = fopen(fileName, "wb");
+   if (!fOut)
+      return false;
+
+   uint32_t version = NNUE_VERSION;
+   uint32_t hidden = NNUE_HIDDEN;
+   bool fOK =
+      fwrite(NNUE_MAGIC, sizeof(NNUE_MAGIC), 1, fOut) == 1 &&
+      fwrite(&version, sizeof(version), 1, fOut) == 1 &&
+      fwrite(&hidden,  sizeof(hidden),  1, fOut) == 1 &&
+      fwrite(biases, sizeof(int16_t), NNUE_HIDDEN, fOut) == (size_t)NNUE_HIDDEN &&
+      fwrite(weights.data(), sizeof(int16_t), weights.size(), fOut) == weights.size() &&
+      fwrite(outputWeights, sizeof(int16_t), 2 * NNUE_HIDDEN, fOut) ==
+         (size_t)(2 * NNUE_HIDDEN) &&
+      fwrite(&outputBias, sizeof(int32_t), 1, fOut) == 1;
+   return fclose(fOut) == 0 && fOK;
+}
+
+/*************************************************
+ * NETWORK : RANDOMIZE
+ *************************************************/
+void Network::randomize(unsigned int seed)
+{
+   mt19937 random(seed);
+   uniform_int_distribution <int> small(-8, 8);
+   for (int16_t & weight : weights)
+      weight = (int16_t)small(random);
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+      biases[i] = (int16_t)(small(random) * 4);
+   for (int i = 0; i < 2 * NNUE_HIDDEN; i++)
+      outputWeights[i] = (int16_t)small(random);
+   outputBias = 0;
+}
+
+/*************************************************
+ * NETWORK : FEATURE
+ * Squares are 0...63, a1 = 0. Black sees the board
+ * upside down so both sides share the same weights.
+ *************************************************/
+int Network::feature(bool perspectiveWhite, int squareKing,
+                     PieceType pt, bool isWhite, int square)
+{
+   assert(pt != KING && pt != SPACE && pt != INVALID);
+   if (!perspectiveWhite)
+   {
+      squareKing ^= 56;
+      square     ^= 56;
+   }
+
+   // QUEEN...PAWN become 0...4, then theirs follow ours
+   int piece = (pt - QUEEN) * 2 + (isWhite == perspectiveWhite ? 0 : 1);
+   return (squareKing * NNUE_PIECES + piece) * 64 + square;
+}
+
+/*************************************************
+ * NETWORK : REFRESH
+ *************************************************/
+void Network::refresh(Accumulator & acc, bool perspectiveWhite,
+                      const int * features, int numFeatures) const
+{
+   int16_t * values = acc.values[perspectiveWhite ? 0 : 1];
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+      values[i] = biases[i];
+   for (int i = 0; i < numFeatures; i++)
+      pKernel->add(values, &weights[(size_t)features[i] * NNUE_HIDDEN]);
+}
+
+/*************************************************
+ * NETWORK : ADD FEATURE
+ *************************************************/
+void Network::addFeature(Accumulator & acc, bool perspectiveWhite, int feature) const
+{
+   assert(0 <= feature && feature < NNUE_INPUTS);
+   pKernel->add(acc.values[perspectiveWhite ? 0 : 1],
+                &weights[(size_t)feature * NNUE_HIDDEN]);
+}
+
+/*************************************************
+ * NETWORK : SUB FEATURE
+ *************************************************/
+void Network::subFeature(Accumulator & acc, bool perspectiveWhite, int feature) const
+{
+   assert(0 <= feature && feature < NNUE_INPUTS);
+   pKernel->sub(acc.values[perspectiveWhite ? 0 : 1],
+                &weights[(size_t)feature * NNUE_HIDDEN]);
+}
+
+/*************************************************
+ * NETWORK : EVALUATE
+ * The side to move's half goes first
+ *************************************************/
+int Network::evaluate(const Accumulator & acc, bool whiteToMove) const
+{
+   const int16_t * us   = acc.values[whiteToMove ? 0 : 1];
+   const int16_t * them = acc.values[whiteToMove ? 1 : 0];
+   int32_t sum = outputBias +
+                 pKernel->dot(us,   outputWeights) +
+                 pKernel->dot(them, outputWeights + NNUE_HIDDEN);
+   return sum / NNUE_SCALE;
+}
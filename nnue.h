@@ -0,0 +1,78 @@
+/***********************************************************************
+ * Header File:
+ *    NNUE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A small efficiently updatable neural network evaluation. The first
+ *    layer is a sum of weight columns, one per (king square, piece,
+ *    square) feature, so a move only adds and subtracts a few columns.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>       // for INT16_T
+#include <vector>        // for VECTOR to hold the weights
+#include "pieceType.h"   // for PIECE TYPE
+
+class TestNnue;
+
+const int NNUE_PIECES   = 10;                       // 5 kinds x 2 colors, no kings
+const int NNUE_INPUTS   = 64 * NNUE_PIECES * 64;    // half-KP features
+const int NNUE_HIDDEN   = 64;                       // accumulator width
+const int NNUE_ACTIVE   = 32;                       // most features ever on at once
+
+/***************************************************
+ * ACCUMULATOR
+ * The first layer for both perspectives. Index 0 is white's
+ * point of view, index 1 is black's.
+ ***************************************************/
+struct Accumulator
+{
+   int16_t values[2][NNUE_HIDDEN];
+};
+
+/***************************************************
+ * NETWORK
+ * The weights, loaded from a file, and the kernels that use them
+ ***************************************************/
+class Network
+{
+   friend TestNnue;
+public:
+   Network();
+
+   // read or write a weights file. Returns false if the file is
+   // missing, the wrong size, or not a weights file at all
+   bool load(const char * fileName);
+   bool save(const char * fileName) const;
+
+   // small random weights, for the benchmark and the tests
+   void randomize(unsigned int seed);
+
+   // which input is on for a piece, as seen by one side
+   static int feature(bool perspectiveWhite, int squareKing,
+                      PieceType pt, bool isWhite, int square);
+
+   // build one side of the accumulator from the active features
+   void refresh(Accumulator & acc, bool perspectiveWhite,
+                const int * features, int numFeatures) const;
+
+   // turn one feature on or off
+   void addFeature(Accumulator & acc, bool perspectiveWhite, int feature) const;
+   void subFeature(Accumulator & acc, bool perspectiveWhite, int feature) const;
+
+   // score in centipawns from the point of view of the side to move
+   int evaluate(const Accumulator & acc, bool whiteToMove) const;
+
+   // which SIMD kernel we are using: "avx2", "sse4.1" or "scalar".
+   // setKernel() returns false if this CPU cannot run it.
+   static const char * getKernel();
+   static bool setKernel(const char * name);
+
+private:
+   std::vector <int16_t> weights;        // [NNUE_INPUTS][NNUE_HIDDEN]
+   int16_t biases[NNUE_HIDDEN];
+   int16_t outputWeights[2 * NNUE_HIDDEN];
+   int32_t outputBias;
+};
@@ -0,0 +1,70 @@
+/***********************************************************************
+ * Source File:
+ *    PAWN TABLE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A small hash table of pawn structure scores
+ ************************************************************************/
+
+#include "pawnTable.h"
+#include "trace.h"
+#include <cassert>
+using namespace std;
+
+/*************************************************
+ * PAWN TABLE : CONSTRUCT
+ *************************************************/
+PawnTable::PawnTable(int numEntries) : mask(0), probes(0), hits(0)
+{
+   assert(numEntries > 0);
+   int size = 1;
+   while (size * 2 <= numEntries)
+      size *= 2;
+   entries.resize(size);
+   mask = size - 1;
+   clear();
+}
+
+/*************************************************
+ * PAWN TABLE : PROBE
+ *************************************************/
+bool PawnTable::probe(uint64_t key, int & mg, int & eg)
+{
+   TRACE_SCOPE("pawn_probe");
+   probes++;
+   const Entry & entry = entries[key & mask];
+   if (!entry.fUsed || entry.key != key)
+      return false;
+
+   hits++;
+   mg = entry.mg;
+   eg = entry.eg;
+   return true;
+}
+
+/*************************************************
+ * PAWN TABLE : STORE
+ *************************************************/
+void PawnTable::store(uint64_t key, int mg, int eg)
+{
+   Entry & entry = entries[key & mask];
+   entry.key = key;
+   entry.mg = (int16_t)mg;
+   entry.eg = (int16_t)eg;
+   entry.fUsed = true;
+}
+
+/*************************************************
+ * PAWN TABLE : CLEAR
+ *************************************************/
+void PawnTable::clear()
+{
+   for (Entry & entry : entries)
+   {
+      entry.key = 0;
+      entry.mg = entry.eg = 0;
+      entry.fUsed = false;
+   }
+   probes = hits = 0;
+}
@@ -0,0 +1,64 @@
+/***********************************************************************
+ * Header File:
+ *    PAWN TABLE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A small hash table of pawn structure scores. The pawns rarely
+ *    move, so most positions the search visits have a pawn structure
+ *    it has already scored. Each search thread has its own.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>   // for UINT64_T
+#include <vector>    // for VECTOR to hold the entries
+
+class TestPawnTable;
+
+/***************************************************
+ * PAWN TABLE
+ * Pawn key -> middlegame and endgame score
+ ***************************************************/
+class PawnTable
+{
+   friend TestPawnTable;
+public:
+   // the number of entries is rounded down to a power of two
+   PawnTable(int numEntries = 1 << 14);
+
+   // is this pawn structure in the table?
+   bool probe(uint64_t key, int & mg, int & eg);
+
+   // remember a pawn structure, replacing whatever was there
+   void store(uint64_t key, int mg, int eg);
+
+   // forget everything, including the statistics
+   void clear();
+
+   // start counting probes and hits again, keeping the entries
+   void clearStatistics() { probes = hits = 0; }
+
+   // statistics
+   long   getProbes()  const { return probes;                                   }
+   long   getHits()    const { return hits;                                     }
+   double getHitRate() const { return probes ? (double)hits / probes : 0.0;    }
+
+private:
+   /***************************************************
+    * ENTRY
+    * One pawn structure
+    ***************************************************/
+   struct Entry
+   {
+      uint64_t key;
+      int16_t  mg;
+      int16_t  eg;
+      bool     fUsed;
+   };
+
+   std::vector <Entry> entries;
+   uint64_t mask;     // numEntries - 1
+   long probes;
+   long hits;
+};
@@ -0,0 +1,165 @@
+/***********************************************************************
+ * Source File:
+ *    PERF COUNTERS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Hardware counters through Linux perf_event_open(). Each counter
+ *    is opened on its own so one the CPU lacks does not cost us the
+ *    others, and each is scaled for the time the kernel had to share
+ *    it with someone else.
+ ************************************************************************/
+
+#include "perfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>   // for PERF_EVENT_ATTR
+#include <sys/ioctl.h>          // for IOCTL
+#include <sys/syscall.h>        // for SYSCALL
+#include <unistd.h>             // for READ and CLOSE
+#include <cstring>              // for MEMSET
+#endif
+
+#ifdef __linux__
+/*************************************************
+ * OPEN COUNTER
+ * Count one event for this thread on any CPU, in
+ * user space only, which is all an unprivileged
+ * process is usually allowed
+ *************************************************/
+static int openCounter(unsigned int type, unsigned long long config)
+{
+   perf_event_attr attr;
+   memset(&attr, 0, sizeof(attr));
+   attr.size           = sizeof(attr);
+   attr.type           = type;
+   attr.config         = config;
+   attr.disabled       = 1;
+   attr.exclude_kernel = 1;
+   attr.exclude_hv     = 1;
+   attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                         PERF_FORMAT_TOTAL_TIME_RUNNING;
+   return (int)syscall(SYS_perf_event_open, &attr, 0 /*this thread*/,
+                       -1 /*any cpu*/, -1 /*no group*/, 0);
+}
+#endif
+
+/*************************************************
+ * PERF COUNTERS : CONSTRUCT
+ *************************************************/
+PerfCounters::PerfCounters()
+{
+   for (int i = 0; i < COUNTER_NUM; i++)
+   {
+      fds[i] = -1;
+      values[i] = -1;
+   }
+
+#ifdef __linux__
+   const unsigned long long l1dMiss = PERF_COUNT_HW_CACHE_L1D |
+      (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+   fds[COUNTER_CYCLES]        = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+   fds[COUNTER_INSTRUCTIONS]  = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+   fds[COUNTER_L1D_MISSES]    = openCounter(PERF_TYPE_HW_CACHE, l1dMiss);
+   fds[COUNTER_LLC_MISSES]    = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+   fds[COUNTER_BRANCH_MISSES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+}
+
+/*************************************************
+ * PERF COUNTERS : DESTRUCT
+ *************************************************/
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+   for (int i = 0; i < COUNTER_NUM; i++)
+      if (fds[i] >= 0)
+         close(fds[i]);
+#endif
+}
+
+/*************************************************
+ * PERF COUNTERS : IS AVAILABLE
+ *************************************************/
+bool PerfCounters::isAvailable() const
+{
+   for (int i = 0; i < COUNTER_NUM; i++)
+      if (fds[i] >= 0)
+         return true;
+   return false;
+}
+
+/*************************************************
+ * PERF COUNTERS : START
+ *************************************************/
+void PerfCounters::start()
+{
+#ifdef __linux__
+   for (int i = 0; i < COUNTER_NUM; i++)
+      if (fds[i] >= 0)
+      {
+         ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+         ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+}
+
+/*************************************************
+ * PERF COUNTERS : STOP
+ * When the kernel multiplexed a counter, it only
+ * counted part of the time, so scale it up
+ *************************************************/
+void PerfCounters::stop()
+{
+#ifdef __linux__
+   for (int i = 0; i < COUNTER_NUM; i++)
+   {
+      values[i] = -1;
+      if (fds[i] < 0)
+         continue;
+      ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+      unsigned long long data[3];   // value, time enabled, time running
+      if (read(fds[i], data, sizeof(data)) != (ssize_t)sizeof(data))
+         continue;
+      if (data[2] == 0)
+         values[i] = 0;
+      else if (data[2] < data[1])
+         values[i] = (long long)((double)data[0] * data[1] / data[2]);
+      else
+         values[i] = (long long)data[0];
+   }
+#endif
+}
+
+/*************************************************
+ * PERF COUNTERS : GET IPC
+ *************************************************/
+double PerfCounters::getIpc() const
+{
+   if (values[COUNTER_CYCLES] <= 0 || values[COUNTER_INSTRUCTIONS] < 0)
+      return -1.0;
+   return (double)values[COUNTER_INSTRUCTIONS] / (double)values[COUNTER_CYCLES];
+}
+
+/*************************************************
+ * PERF COUNTERS : GET NAME
+ *************************************************/
+const char * PerfCounters::getName(Counter counter)
+{
+   switch (counter)
+   {
+      case COUNTER_CYCLES:
+         return "cycles";
+      case COUNTER_INSTRUCTIONS:
+         return "instructions";
+      case COUNTER_L1D_MISSES:
+         return "l1d_misses";
+      case COUNTER_LLC_MISSES:
+         return "llc_misses";
+      case COUNTER_BRANCH_MISSES:
+         return "branch_misses";
+      default:
+         return "unknown";
+   }
+}
@@ -0,0 +1,65 @@
+/***********************************************************************
+ * Header File:
+ *    PERF COUNTERS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The CPU's own hardware counters: cycles, instructions, cache
+ *    misses and branch misses. On Linux these come from perf_event;
+ *    anywhere else, or when the kernel will not let us have them,
+ *    every counter reads as unavailable and the rest of the program
+ *    carries on with wall-clock time alone.
+ ************************************************************************/
+
+#pragma once
+
+class TestPerfCounters;
+
+/***************************************************
+ * COUNTER
+ * Which hardware counter
+ ***************************************************/
+enum Counter
+{
+   COUNTER_CYCLES,
+   COUNTER_INSTRUCTIONS,
+   COUNTER_L1D_MISSES,
+   COUNTER_LLC_MISSES,
+   COUNTER_BRANCH_MISSES,
+   COUNTER_NUM
+};
+
+/***************************************************
+ * PERF COUNTERS
+ * Count what happens between start() and stop()
+ * on this thread
+ ***************************************************/
+class PerfCounters
+{
+   friend TestPerfCounters;
+public:
+   PerfCounters();
+   ~PerfCounters();
+   PerfCounters(const PerfCounters &) = delete;
+   PerfCounters & operator = (const PerfCounters &) = delete;
+
+   // did we get any counter, or this one?
+   bool isAvailable() const;
+   bool isAvailable(Counter counter) const { return fds[counter] >= 0; }
+
+   // zero the counters and count until stop()
+   void start();
+   void stop();
+
+   // what was counted between start() and stop(), -1 if we could not
+   long long get(Counter counter) const { return values[counter]; }
+
+   // instructions per cycle, -1.0 if we do not know
+   double getIpc() const;
+
+   static const char * getName(Counter counter);
+
+private:
+   int fds[COUNTER_NUM];              // -1 when not available
+   long long values[COUNTER_NUM];
+};
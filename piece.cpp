@@ -14,15 +14,60 @@
 #include "pieceKnight.h"
 #include "board.h"     // for BOARD
 #include "uiDraw.h"    // for draw*()
+#include "arena.h"     // for ARENA
+#include <cstddef>     // for MAX_ALIGN_T
 #include <cassert>     // because we are paranoid
 using namespace std;
 
+// every piece is preceded by a header saying where it came from. It is
+// as big as the strictest alignment so the piece after it is aligned
+const size_t SIZE_HEADER = alignof(max_align_t);
+const unsigned char FROM_HEAP  = 0x48;
+const unsigned char FROM_ARENA = 0x41;
+
+/************************************************
+ * PIECE : NEW
+ ***********************************************/
+void * Piece::operator new(size_t size)
+{
+	unsigned char * p = (unsigned char *)::operator new(SIZE_HEADER + size);
+	*p = FROM_HEAP;
+	return p + SIZE_HEADER;
+}
+void * Piece::operator new(size_t size, Arena & arena)
+{
+	unsigned char * p = (unsigned char *)arena.allocate(SIZE_HEADER + size);
+	*p = FROM_ARENA;
+	return p + SIZE_HEADER;
+}
+
+/************************************************
+ * PIECE : DELETE
+ * Only a heap piece gives its memory back now
+ ***********************************************/
+void Piece::operator delete(void * p)
+{
+	if (!p)
+		return;
+	unsigned char * pHeader = (unsigned char *)p - SIZE_HEADER;
+	assert(*pHeader == FROM_HEAP || *pHeader == FROM_ARENA);
+	if (*pHeader == FROM_HEAP)
+		::operator delete(pHeader);
+}
+void Piece::operator delete(void * p, Arena & arena)
+{
+}
+
 
 /************************************************
  * PIECE : ASSIGN
  ***********************************************/
 const Piece& Piece::operator = (const Piece& rhs)
 {
+	nMoves   = rhs.nMoves;
+	fWhite   = rhs.fWhite;
+	position = rhs.position;
+	lastMove = rhs.lastMove;
 
 	return *this;
 }
@@ -16,6 +16,7 @@
 #include "position.h"  // Because Position is a member variable
 #include "move.h"      // Because we return a set of Move
 #include "pieceType.h" // A piece type.
+#include "allocCount.h" // for COUNTED, with ALLOC_COUNT
 using std::set;
 
 // forward declaration because one of the Piece methods takes a Board
@@ -23,6 +24,7 @@ using std::set;
 class ogstream;
 class Board;
 class MoveType;
+class Arena;
 
 class TestPiece;
 class TestKing;
@@ -32,13 +34,14 @@ class TestRook;
 class TestBishop;
 class TestKnight;
 class TestBoard;
+class TestSearch;
 
 
 /***************************************************
  * PIECE
  * The abstract piece type
  ***************************************************/
-class Piece
+class Piece : public Counted<Piece>
 {
 public:
    friend TestPiece;
@@ -49,31 +52,42 @@ public:
    friend TestKnight;
    friend TestPawn;
    friend TestBoard;
+   friend TestSearch;
+   friend Board;
    
    // constructors and stuff
-   Piece(const Position & pos, bool isWhite = true)   {}
-   Piece(int c, int r, bool isWhite = true)           {}
-   Piece(const Piece & piece)                         {}
+   Piece(const Position & pos, bool isWhite = true) 
+      : nMoves(0), fWhite(isWhite), position(pos), lastMove(-1)       {}
+   Piece(int c, int r, bool isWhite = true)
+      : nMoves(0), fWhite(isWhite), position(c, r), lastMove(-1)      {}
+   Piece(const Piece & piece) : Counted<Piece>(piece) { *this = piece;  }
    virtual ~Piece()                                   {}
    virtual const Piece& operator = (const Piece& rhs);
 
+   // the board makes its pieces in its arena; anyone else gets the heap.
+   // delete works on either, though the arena only reclaims on reset
+   static void * operator new   (size_t size);
+   static void * operator new   (size_t size, Arena & arena);
+   static void   operator delete(void * p);
+   static void   operator delete(void * p, Arena & arena);
+
    // getters
-   virtual bool operator == (PieceType pt) const { return true;         }
-   virtual bool operator != (PieceType pt) const { return true;         }
-   virtual bool isWhite()                  const { return true;         }
-   virtual bool isMoved()                  const { return true;         }
-   virtual int  getNMoves()                const { return 9999;         }
-   virtual void decrementNMoves()                {                      }
-   virtual const Position & getPosition()  const { return Position();   }
-   virtual bool justMoved(int currentMove) const { return true;         }
+   virtual bool operator == (PieceType pt) const { return getType() == pt; }
+   virtual bool operator != (PieceType pt) const { return getType() != pt; }
+   virtual bool isWhite()                  const { return fWhite;          }
+   virtual bool isMoved()                  const { return nMoves > 0;      }
+   virtual int  getNMoves()                const { return nMoves;          }
+   virtual void decrementNMoves()                { nMoves--;               }
+   virtual const Position & getPosition()  const { return position;        }
+   virtual bool justMoved(int currentMove) const { return lastMove == currentMove - 1; }
 
    // setter
-   virtual void setLastMove(int currentMove)     {                      }
+   virtual void setLastMove(int currentMove)     { lastMove = currentMove; nMoves++; }
 
    // overwritten by the various pieces
    virtual PieceType getType()                                    const = 0;
    virtual void display(ogstream * pgout)                         const = 0;
-   void getMoves(set <Move> & moves, const Board & board) const;
+   virtual void getMoves(set <Move> & moves, const Board & board) const;
 
 protected:
 
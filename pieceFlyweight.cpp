@@ -0,0 +1,36 @@
+/***********************************************************************
+ * Source File:
+ *    PIECE FLYWEIGHT
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The table of flyweights, one per PieceType
+ ************************************************************************/
+
+#include "pieceFlyweight.h"
+#include "pieceKnight.h"   // for KNIGHT FLYWEIGHT
+#include <cassert>
+
+// every type without its own class shares the one that cannot move
+static const PieceFlyweight  flyweightNone;
+static const KnightFlyweight flyweightKnight;
+static const PieceFlyweight * const flyweights[] =
+{
+   &flyweightNone,     // INVALID
+   &flyweightNone,     // SPACE
+   &flyweightNone,     // KING
+   &flyweightNone,     // QUEEN
+   &flyweightNone,     // ROOK
+   &flyweightNone,     // BISHOP
+   &flyweightKnight,   // KNIGHT
+   &flyweightNone      // PAWN
+};
+
+/*************************************************
+ * PIECE FLYWEIGHT : GET
+ *************************************************/
+const PieceFlyweight & PieceFlyweight::get(PieceType pt)
+{
+   assert(INVALID <= pt && pt <= PAWN);
+   return *flyweights[pt];
+}
@@ -0,0 +1,58 @@
+/***********************************************************************
+ * Header File:
+ *    PIECE FLYWEIGHT
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The board keeps one byte per square: the piece type and the
+ *    color. What a type of piece can do lives in one shared, static
+ *    flyweight per PieceType, so generating moves needs no Piece
+ *    objects at all, only the 64 bytes.
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>       // for VECTOR of moves
+#include <cstdint>      // for UINT8_T
+#include "pieceType.h"  // for PIECETYPE
+#include "move.h"       // for MOVE
+#include "arena.h"      // for POOL ALLOCATOR
+
+// the moves the flyweights generate, in no particular order. The
+// search gives each ply's list a slot from its pool
+typedef std::vector <Move, PoolAllocator <Move>> MoveList;
+
+/***************************************************
+ * SQUARE CODE
+ * The low three bits are the PieceType, then one bit
+ * for white. An empty square is SPACE, and a square
+ * with no piece at all (only in the unit tests) is
+ * INVALID. Squares are numbered row * 8 + col
+ ***************************************************/
+const uint8_t SQUARE_WHITE = 0x08;
+
+inline uint8_t squareCode(PieceType pt, bool isWhite)
+{
+   return (uint8_t)(pt | (isWhite && pt != SPACE ? SQUARE_WHITE : 0));
+}
+inline PieceType squareType(uint8_t code)  { return (PieceType)(code & 0x07);   }
+inline bool      squareWhite(uint8_t code) { return (code & SQUARE_WHITE) != 0; }
+
+/***************************************************
+ * PIECE FLYWEIGHT
+ * The behavior of one type of piece. By default a
+ * piece cannot move; the types we have classes for
+ * say otherwise
+ ***************************************************/
+class PieceFlyweight
+{
+public:
+   virtual ~PieceFlyweight() {}
+
+   // the moves for the isWhite piece on square
+   virtual void getMoves(MoveList & /*moves*/, const uint8_t /*squares*/[64],
+                         int /*square*/, bool /*isWhite*/) const { }
+
+   // the flyweight for a type of piece
+   static const PieceFlyweight & get(PieceType pt);
+};
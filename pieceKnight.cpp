@@ -10,6 +10,7 @@
 #include "pieceKnight.h"
 #include "board.h"
 #include "uiDraw.h"    // for draw*()
+#include <cassert>
 
  /***************************************************
  * PIECE DRAW
@@ -17,14 +18,105 @@
  ***************************************************/
 void Knight::display(ogstream* pgout) const
 {
+   pgout->drawKnight(position, !fWhite);
+}
+
 
+/**********************************************
+ * KNIGHT JUMPS
+ * Where a knight on each square can land, worked
+ * out once from the eight deltas. The flyweight
+ * reads the squares, BoardState the bitboards
+ *********************************************/
+struct KnightJumps
+{
+   uint64_t attacks[64];      // one bit per destination
+   uint8_t  dests[64][8];     // the same destinations, in delta order
+   uint8_t  numDests[64];
+
+   KnightJumps()
+   {
+      const Delta delta[] =
+      {
+         {  2, -1 }, {  2,  1 },
+         {  1, -2 }, {  1,  2 },
+         { -1, -2 }, { -1,  2 },
+         { -2, -1 }, { -2,  1 }
+      };
+      for (int square = 0; square < 64; square++)
+      {
+         attacks[square]  = 0;
+         numDests[square] = 0;
+         Position pos(square % 8, square / 8);
+         for (int i = 0; i < 8; i++)
+         {
+            Position posDest(pos, delta[i]);
+            if (posDest.isInvalid())
+               continue;
+            int squareDest = posDest.getRow() * 8 + posDest.getCol();
+            attacks[square] |= 1ull << squareDest;
+            dests[square][numDests[square]++] = (uint8_t)squareDest;
+         }
+      }
+   }
+};
+
+static const KnightJumps & knightJumps()
+{
+   static const KnightJumps jumps;
+   return jumps;
 }
 
+uint64_t knightAttacks(int square)
+{
+   assert(0 <= square && square < 64);
+   return knightJumps().attacks[square];
+}
 
 /**********************************************
  * KNIGHT : GET POSITIONS
+ * The same jumps as the flyweight, asking the
+ * board's pieces what is on each square
  *********************************************/
 void Knight::getMoves(set <Move>& moves, const Board& board) const
 {
+   const KnightJumps & jumps = knightJumps();
+   int square = position.getRow() * 8 + position.getCol();
+   for (int i = 0; i < jumps.numDests[square]; i++)
+   {
+      int squareDest = jumps.dests[square][i];
+      Position posDest(squareDest % 8, squareDest / 8);
+
+      // we can move to a space or capture the other team
+      const Piece & pieceDest = board[posDest];
+      if (pieceDest.getType() == SPACE)
+         moves.insert(Move(position, posDest, Move::MOVE, SPACE, SPACE, fWhite));
+      else if (pieceDest.isWhite() != fWhite)
+         moves.insert(Move(position, posDest, Move::MOVE,
+                           pieceDest.getType(), SPACE, fWhite));
+   }
+}
+
+/**********************************************
+ * KNIGHT FLYWEIGHT : GET MOVES
+ * Every move a knight has, from the board's bytes
+ *********************************************/
+void KnightFlyweight::getMoves(MoveList& moves, const uint8_t squares[64],
+                               int square, bool isWhite) const
+{
+   const KnightJumps & jumps = knightJumps();
+   Position pos(square % 8, square / 8);
+   for (int i = 0; i < jumps.numDests[square]; i++)
+   {
+      int squareDest = jumps.dests[square][i];
+      Position posDest(squareDest % 8, squareDest / 8);
 
-}
\ No newline at end of file
+      // we can move to a space or capture the other team
+      uint8_t codeDest = squares[squareDest];
+      PieceType ptDest = squareType(codeDest);
+      if (ptDest == SPACE)
+         moves.push_back(Move(pos, posDest, Move::MOVE, SPACE, SPACE, isWhite));
+      else if (ptDest != INVALID && squareWhite(codeDest) != isWhite)
+         moves.push_back(Move(pos, posDest, Move::MOVE, ptDest, SPACE, isWhite));
+   }
+}
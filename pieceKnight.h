@@ -10,6 +10,10 @@
 #pragma once
 
 #include "piece.h"
+#include "pieceFlyweight.h"
+
+// where a knight on square can jump, one bit per square
+uint64_t knightAttacks(int square);
 
  /***************************************************
   * KNIGHT
@@ -18,10 +22,21 @@
 class Knight : public Piece
 {
 public:
-   Knight(const Position& pos, bool isWhite) : Piece(10,10,true) { }
-   Knight(int c, int r, bool isWhite) : Piece(10, 10, true) { }
+   Knight(const Position& pos, bool isWhite) : Piece(pos, isWhite)  { }
+   Knight(int c, int r, bool isWhite) : Piece(c, r, isWhite)        { }
    ~Knight() {                }
-   PieceType getType()            const { return SPACE; }
+   PieceType getType()            const { return KNIGHT; }
    void getMoves(set <Move>& moves, const Board& board) const;
    void display(ogstream* pgout)  const;
-};
\ No newline at end of file
+};
+
+ /***************************************************
+  * KNIGHT FLYWEIGHT
+  * How every knight moves, from the board's bytes
+  ***************************************************/
+class KnightFlyweight : public PieceFlyweight
+{
+public:
+   void getMoves(MoveList& moves, const uint8_t squares[64],
+                 int square, bool isWhite) const;
+};
@@ -9,6 +9,8 @@
 
 #include "position.h"
 #include <iostream>
+#include <cstring>     // for STRLEN
+
 
 /******************************************
  * POSITION INSERTION OPERATOR
@@ -134,7 +136,7 @@ const Position& Position:: operator=(const string& rhs)
    return *this;
 }
 
-void Position::setXY(double x, double y)
+void Position::setXY(double x, double y, double squareWidth, double squareHeight)
 {
    if (squareWidth > 0 && squareHeight > 0) {
       int col = static_cast<int>(x / squareWidth);
@@ -98,15 +98,13 @@ public:
 
 
    // Pixels:    The Position class can work with screen coordinates,
-   //            a.k.a. Pixels, these are X and Y coordinates. Note that
-   //            we need to scale them according to the size of the board.
-   int getX()   const { return getCol() * getSquareWidth(); }
-   int getY()   const { return getRow() * getSquareHeight(); }
-   void setXY(double x, double y);
-   double getSquareWidth()  const { return squareWidth; }
-   double getSquareHeight() const { return squareHeight; }
-   void setSquareWidth(double width = 0) { this->squareWidth = width; }
-   void setSquareHeight(double height = 0) { this->squareHeight = height; }
+   //            a.k.a. Pixels, these are X and Y coordinates. We draw in
+   //            SIZE_SQUARE units, but the mouse is in the pixels of a
+   //            window of whatever size, so each window says how big its
+   //            squares are.
+   int getX()   const { return getCol() * SIZE_SQUARE; }
+   int getY()   const { return getRow() * SIZE_SQUARE; }
+   void setXY(double x, double y, double squareWidth, double squareHeight);
 
    // Delta:    The Position class can work with deltas, which are
    //           offsets from a given location. This helps pieces move
@@ -121,8 +119,6 @@ private:
    void set(uint8_t colRowNew) { }
 
    uint8_t colRow;
-   static double squareWidth;
-   static double squareHeight;
 };
 
 
@@ -0,0 +1,339 @@
+/***********************************************************************
+ * Source File:
+ *    SEARCH
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    An alpha-beta search that finds the best move for the side to
+ *    move. Null-move pruning and late-move reductions can be turned
+ *    on and off so we can compare the two.
+ ************************************************************************/
+
+#include "search.h"
+#include "board.h"
+#include "piece.h"
+#include "evaluate.h"
+#include "trace.h"
+#include <set>         // for SET, what the pieces give us
+#include <vector>      // for VECTOR, so we can sort the moves
+#include <algorithm>   // for STABLE_SORT
+#include <cmath>       // for LOG
+#include <cassert>
+using namespace std;
+
+const int SCORE_MATE     = 100000;   // we captured the king
+const int SCORE_INFINITE = 1000000;  // bigger than any score
+
+int  Search::reductions[MAX_PLY][MAX_MOVES];
+bool Search::reductionsInitialized = false;
+
+/*************************************************
+ * PIECE VALUE
+ * How much each piece is worth when ordering captures
+ *************************************************/
+static int pieceValue(PieceType pt)
+{
+   switch (pt)
+   {
+   case PAWN:   return 100;
+   case KNIGHT: return 300;
+   case BISHOP: return 300;
+   case ROOK:   return 500;
+   case QUEEN:  return 900;
+   case KING:   return SCORE_MATE;
+   default:     return 0;
+   }
+}
+
+/*************************************************
+ * SEARCH : CONSTRUCT
+ *************************************************/
+Search::Search(Board & board) :
+   useNullMove(true),
+   useLateMoveReductions(true),
+   board(board),
+   depthCompleted(0),
+   score(0),
+   nodes(0),
+   fStop(false),
+   pTime(nullptr),
+   poolMoves(MAX_LIST * sizeof(Move), 8 /*slotsPerBlock*/),
+   report(nullptr),
+   pReport(nullptr)
+{
+   initReductions();
+}
+
+/*************************************************
+ * SEARCH : INIT REDUCTIONS
+ * The reduction grows with the log of the depth and
+ * the log of how late in the move list we are
+ *************************************************/
+void Search::initReductions()
+{
+   if (reductionsInitialized)
+      return;
+
+   for (int depth = 0; depth < MAX_PLY; depth++)
+      for (int moveNumber = 0; moveNumber < MAX_MOVES; moveNumber++)
+         reductions[depth][moveNumber] = (depth == 0 || moveNumber == 0) ? 0 :
+            (int)(0.75 + log((double)depth) * log((double)moveNumber) / 2.25);
+
+   reductionsInitialized = true;
+}
+
+/*************************************************
+ * SEARCH : REDUCTION
+ *************************************************/
+int Search::reduction(int depth, int moveNumber)
+{
+   initReductions();
+   depth      = min(max(depth, 0),      MAX_PLY - 1);
+   moveNumber = min(max(moveNumber, 0), MAX_MOVES - 1);
+   return reductions[depth][moveNumber];
+}
+
+/*************************************************
+ * SEARCH : EVALUATE
+ * The board keeps its own score; we add the pawn structure,
+ * which we look up in the pawn table when we can, and give
+ * it from the point of view of the side to move. A network
+ * already knows about pawn structure. With no pawns (a key
+ * of 0) there is no structure, so there is nothing to look
+ * up. setFen() knows no pawns yet, so only boards set up by
+ * hand use the table.
+ *************************************************/
+int Search::evaluate()
+{
+   TRACE_SCOPE("evaluate");
+   int value = board.evaluate();
+   uint64_t key = board.getPawnKey();
+   if (!board.hasNetwork() && key != 0)
+   {
+      int mg;
+      int eg;
+      if (!pawnTable.probe(key, mg, eg))
+      {
+         uint64_t pawnsWhite;
+         uint64_t pawnsBlack;
+         board.getPawns(pawnsWhite, pawnsBlack);
+         pawnStructure(pawnsWhite, pawnsBlack, mg, eg);
+         pawnTable.store(key, mg, eg);
+      }
+      value += taper(mg, eg, board.getPhase());
+   }
+   return board.whiteTurn() ? value : -value;
+}
+
+/*************************************************
+ * ORDER MOVES
+ * Captures of big pieces first, then everything else,
+ * each in the order a set of moves would be in. No
+ * two moves are equal, so sort() needs no buffer
+ * the way stable_sort() would
+ *************************************************/
+static void orderMoves(MoveList & moves)
+{
+   sort(moves.begin(), moves.end(), [](const Move & lhs, const Move & rhs)
+   {
+      int valueLhs = pieceValue(lhs.getCapture());
+      int valueRhs = pieceValue(rhs.getCapture());
+      if (valueLhs != valueRhs)
+         return valueLhs > valueRhs;
+      return lhs < rhs;
+   });
+}
+
+/*************************************************
+ * SEARCH : ALPHA BETA
+ * Negamax with a null-window search on all but the
+ * first move, null-move pruning, and late-move reductions
+ *************************************************/
+int Search::alphaBeta(int depth, int alpha, int beta, int ply, bool fNullOk)
+{
+   nodes++;
+   if (isTimeUp())
+   {
+      fStop = true;
+      return 0;
+   }
+   if (depth <= 0 || ply >= MAX_PLY - 1)
+      return evaluate();
+
+   bool isWhite = board.whiteTurn();
+   bool fInCheck = board.isInCheck(isWhite);
+
+   // null move: if passing still beats beta, so will a real move.
+   // Never in check and never with only pawns, where passing
+   // may be the best move (zugzwang)
+   if (useNullMove && fNullOk && !fInCheck && depth >= 3 &&
+       board.hasNonPawnMaterial(isWhite) && evaluate() >= beta)
+   {
+      int r = 2 + depth / 6;
+      board.moveNull();
+      int value = -alphaBeta(depth - 1 - r, -beta, -beta + 1, ply + 1, false);
+      board.undoNull();
+      if (fStop)
+         return 0;
+      if (value >= beta && value < SCORE_MATE - MAX_PLY)
+         return beta;
+   }
+
+   MoveList moves(PoolAllocator <Move> {poolMoves});
+   moves.reserve(MAX_LIST);
+   board.getMoves(moves, isWhite);
+   orderMoves(moves);
+
+   // taking the king ends the game
+   if (!moves.empty() && moves.front().getCapture() == KING)
+      return SCORE_MATE - ply;
+
+   int moveNumber = 0;
+   for (const Move & move : moves)
+   {
+      board.move(move);
+      if (board.isInCheck(isWhite))
+      {
+         board.undo();
+         continue;
+      }
+      moveNumber++;
+
+      int value;
+      if (moveNumber == 1)
+         value = -alphaBeta(depth - 1, -beta, -alpha, ply + 1, true);
+      else
+      {
+         // quiet moves late in the list are probably bad: look at them
+         // with less depth and only search again if they surprise us
+         int r = 0;
+         if (useLateMoveReductions && depth >= 3 && moveNumber > 3 && !fInCheck &&
+             move.getCapture() == SPACE && move.getPromote() == SPACE)
+            r = min(reduction(depth, moveNumber), depth - 2);
+
+         value = -alphaBeta(depth - 1 - r, -alpha - 1, -alpha, ply + 1, true);
+         if (r > 0 && value > alpha)
+            value = -alphaBeta(depth - 1, -alpha - 1, -alpha, ply + 1, true);
+         if (value > alpha && value < beta)
+            value = -alphaBeta(depth - 1, -beta, -alpha, ply + 1, true);
+      }
+      board.undo();
+
+      if (fStop)
+         return 0;
+      if (value >= beta)
+         return beta;
+      if (value > alpha)
+         alpha = value;
+   }
+
+   // no legal moves: checkmate or stalemate
+   if (moveNumber == 0)
+      return fInCheck ? -SCORE_MATE + ply : 0;
+
+   return alpha;
+}
+
+/*************************************************
+ * SEARCH : THINK
+ * Think for a fixed amount of time
+ *************************************************/
+Move Search::think(int maxDepth, double msLimit)
+{
+   TimeManager timeManager;
+   timeManager.startFixed(msLimit);
+   return think(maxDepth, timeManager);
+}
+
+/*************************************************
+ * SEARCH : THINK
+ * Iterative deepening: search one ply deeper each time
+ * until we reach maxDepth or the time manager stops us
+ *************************************************/
+Move Search::think(int maxDepth, TimeManager & timeManager)
+{
+   pTime = &timeManager;
+   fStop = false;
+   nodes = 0;
+   pawnTable.clearStatistics();
+   depthCompleted = 0;
+   score = 0;
+   bestMove = Move();
+
+   bool isWhite = board.whiteTurn();
+   MoveList moves(PoolAllocator <Move> {poolMoves});
+   moves.reserve(MAX_LIST);
+   board.getMoves(moves, isWhite);
+   orderMoves(moves);
+
+   // if we are stopped before the first iteration finishes, any
+   // legal move is better than none
+   for (const Move & move : moves)
+   {
+      board.move(move);
+      bool fLegal = !board.isInCheck(isWhite);
+      board.undo();
+      if (fLegal)
+      {
+         bestMove = move;
+         break;
+      }
+   }
+
+   for (int depth = 1; depth <= maxDepth && depth < MAX_PLY; depth++)
+   {
+      int alpha = -SCORE_INFINITE;
+      Move bestThisDepth;
+      bool fFound = false;
+
+      for (const Move & move : moves)
+      {
+         board.move(move);
+         if (board.isInCheck(isWhite))
+         {
+            board.undo();
+            continue;
+         }
+         int value = -alphaBeta(depth - 1, -SCORE_INFINITE, -alpha, 1, true);
+         board.undo();
+
+         if (fStop)
+            break;
+         if (!fFound || value > alpha)
+         {
+            alpha = value;
+            bestThisDepth = move;
+            fFound = true;
+         }
+      }
+
+      // a partial iteration is not trustworthy
+      if (fStop || !fFound)
+         break;
+
+      bool fBestMoveChanged = depthCompleted > 0 && !(bestThisDepth == bestMove);
+      bestMove = bestThisDepth;
+      score = alpha;
+      depthCompleted = depth;
+      TRACE_COUNT("depth", depth);
+      TRACE_COUNT("nodes", nodes);
+      if (report)
+         report(*this, pReport);
+
+      // an unstable best move earns more time; otherwise, do not start
+      // an iteration we probably cannot finish
+      timeManager.update(fBestMoveChanged);
+      if (timeManager.isSoftLimit())
+         break;
+
+      // try the best move first next time
+      for (size_t i = 0; i < moves.size(); i++)
+         if (moves[i] == bestMove)
+         {
+            rotate(moves.begin(), moves.begin() + i, moves.begin() + i + 1);
+            break;
+         }
+   }
+
+   return bestMove;
+}
@@ -0,0 +1,86 @@
+/***********************************************************************
+ * Header File:
+ *    SEARCH
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    An alpha-beta search that finds the best move for the side to
+ *    move. Null-move pruning and late-move reductions can be turned
+ *    on and off so we can compare the two.
+ ************************************************************************/
+
+#pragma once
+
+#include "move.h"     // because we return the best Move
+#include "timeManager.h"
+#include "pawnTable.h"
+#include "arena.h"      // for POOL of move lists
+
+class Board;
+class TestSearch;
+
+/***************************************************
+ * SEARCH
+ * Iterative deepening alpha-beta on a Board
+ ***************************************************/
+class Search
+{
+   friend TestSearch;
+public:
+   Search(Board & board);
+
+   // find the best move, stopping at maxDepth or after msLimit
+   Move think(int maxDepth, double msLimit);
+
+   // find the best move, stopping at maxDepth or when the clock says so
+   Move think(int maxDepth, TimeManager & timeManager);
+
+   // called after every completed iteration, for example to print
+   // the progress of the search. Pass nullptr to turn it off.
+   void setReport(void (*report)(const Search & search, void * p), void * p)
+   {
+      this->report = report;
+      this->pReport = p;
+   }
+
+   // selective search switches, on by default
+   bool useNullMove;
+   bool useLateMoveReductions;
+
+   // statistics from the last call to think()
+   int    getDepth()       const { return depthCompleted;          }
+   long   getNodes()       const { return nodes;                   }
+   int    getScore()       const { return score;                   }
+   Move   getBestMove()    const { return bestMove;                }
+   double getElapsed()     const { return pTime ? pTime->elapsed() : 0.0; }
+   long   getPawnProbes()  const { return pawnTable.getProbes();   }
+   double getPawnHitRate() const { return pawnTable.getHitRate();  }
+   const Pool & getPool()  const { return poolMoves;               }
+
+   // how much to reduce a late move at a given depth and move number
+   static int reduction(int depth, int moveNumber);
+
+private:
+   int alphaBeta(int depth, int alpha, int beta, int ply, bool fNullOk);
+   int evaluate();
+   bool isTimeUp() { return pTime->isHardLimit(nodes); }
+
+   static const int MAX_PLY   = 64;
+   static const int MAX_MOVES = 64;
+   static const int MAX_LIST  = 256;   // more moves than any position has
+   static int  reductions[MAX_PLY][MAX_MOVES];
+   static bool reductionsInitialized;
+   static void initReductions();
+
+   Board & board;
+   Move bestMove;           // best move found at the root
+   int  depthCompleted;     // deepest iteration that finished
+   int  score;              // score of the best move
+   long nodes;              // positions visited
+   bool fStop;              // did we run out of time?
+   TimeManager * pTime;     // how long we are allowed to think
+   PawnTable pawnTable;     // pawn structure scores, one per search thread
+   Pool poolMoves;          // a move list for each ply we are in
+   void (*report)(const Search & search, void * p);   // progress callback
+   void * pReport;          // handed back to report()
+};
@@ -0,0 +1,103 @@
+/**********************************************************************
+* Source File:
+*    SERVER MAIN
+* Author:
+*    <your name here>
+* Summary:
+*    The headless session server: many games at once, played through
+*    the binary requests in session.h on a Unix domain socket:
+*       server --socket path [--threads n]
+*    Stop it with Ctrl-C to see how long each type of request took.
+*    Or be the clients of one, and see how many moves it validates:
+*       server --load path [--clients n] [--batch n] [--seconds s]
+************************************************************************/
+
+#include "session.h"        // for SESSION SERVER
+#include "sessionSocket.h"  // for SOCKET SERVER
+#include "loadGenerator.h"  // for LOAD GENERATE
+#include <iostream>         // for COUT and CERR
+#include <cstring>          // for STRCMP
+#include <cstdlib>          // for ATOI and ATOF
+#include <csignal>          // for SIGNAL
+using namespace std;
+
+#ifndef _WIN32
+static SocketServer * pSocketServer = nullptr;
+
+/*********************************
+ * ON SIGNAL - Ctrl-C or kill
+ *********************************/
+static void onSignal(int)
+{
+   if (pSocketServer)
+      pSocketServer->stop();
+}
+#endif
+
+/*********************************
+ * MAIN - Where it all begins...
+ *********************************/
+int main(int argc, char** argv)
+{
+   const char * path = nullptr;
+   bool fLoad = false;
+   int numThreads = 0;
+   int numClients = 4;
+   int sizeBatch = 64;
+   double seconds = 5.0;
+   for (int i = 1; i < argc; i++)
+   {
+      if ((strcmp(argv[i], "--socket") == 0 || strcmp(argv[i], "--load") == 0) && i + 1 < argc)
+      {
+         fLoad = strcmp(argv[i], "--load") == 0;
+         path = argv[++i];
+      }
+      else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+         numThreads = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc)
+         numClients = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+         sizeBatch = atoi(argv[++i]);
+      else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+         seconds = atof(argv[++i]);
+      else
+         path = nullptr, i = argc;
+   }
+   if (!path || numThreads < 0 || numClients < 1 || sizeBatch < 1 || size_t(sizeBatch) > NUM_BATCH_MAX || seconds <= 0.0)
+   {
+      cerr << "usage: " << argv[0] << " --socket path [--threads n]\n"
+           << "       " << argv[0] << " --load path [--clients n] [--batch n] [--seconds s]\n";
+      return 1;
+   }
+
+#ifdef _WIN32
+   cerr << "the session server needs Unix domain sockets\n";
+   return 1;
+#else
+   if (fLoad)
+   {
+      signal(SIGPIPE, SIG_IGN);
+      return loadGenerate(path, numClients, sizeBatch, seconds, cout) > 0.0 ? 0 : 1;
+   }
+
+   SessionServer server;
+   SocketServer socketServer(server, numThreads);
+   if (!socketServer.listen(path))
+   {
+      cerr << "cannot listen on " << path << '\n';
+      return 1;
+   }
+
+   pSocketServer = &socketServer;
+   signal(SIGINT, onSignal);
+   signal(SIGTERM, onSignal);
+   signal(SIGPIPE, SIG_IGN);
+   cout << "listening on " << path << endl;
+
+   socketServer.run();
+
+   pSocketServer = nullptr;
+   server.report(cout);
+   return 0;
+#endif
+}
@@ -0,0 +1,569 @@
+/***********************************************************************
+ * Source File:
+ *    SESSION
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Many games in one process: a table of boards by session id, and
+ *    the compact binary requests that create them, make and check moves
+ *    on them, and read them back.
+ ************************************************************************/
+
+#include "session.h"
+#include "threadPool.h"
+#include <cstring>    // for MEMCPY
+#include <condition_variable>   // for CONDITION_VARIABLE, waiting on helpers
+#include <sstream>    // for OSTRINGSTREAM of the report
+#include <iomanip>    // for SETW
+#include <cassert>
+using namespace std;
+
+/*************************************************
+ * little-endian numbers in and out of bytes
+ *************************************************/
+static void put16(vector <uint8_t> & bytes, uint16_t value)
+{
+   bytes.push_back(uint8_t(value));
+   bytes.push_back(uint8_t(value >> 8));
+}
+static void put32(vector <uint8_t> & bytes, uint32_t value)
+{
+   for (int i = 0; i < 32; i += 8)
+      bytes.push_back(uint8_t(value >> i));
+}
+static uint16_t get16(const uint8_t * bytes)
+{
+   return uint16_t(bytes[0] | (bytes[1] << 8));
+}
+static uint32_t get32(const uint8_t * bytes)
+{
+   return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) |
+          (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+}
+
+/*************************************************
+ * PLAY MOVE
+ * Find source and dest among the moves of the side
+ * to move, as Uci::findMove() does, then make it
+ * or, when only validating, take it back
+ *************************************************/
+static uint8_t playMove(Board & board, int source, int dest, bool fMove)
+{
+   MoveList moves;
+   board.getMoves(moves, board.whiteTurn());
+   for (const Move & candidate : moves)
+      if (candidate.getSource().getLocation() == source &&
+          candidate.getDest().getLocation()   == dest)
+      {
+         // moving into check is not legal
+         board.move(candidate);
+         bool fInCheck = board.isInCheck(!board.whiteTurn());
+         if (fInCheck || !fMove)
+            board.undo();
+         return fInCheck ? STATUS_ILLEGAL : STATUS_OK;
+      }
+   return STATUS_ILLEGAL;
+}
+
+/*************************************************
+ * PARSE SMITH
+ * The squares of a move like g1f3. A fifth letter,
+ * what was captured or promoted to, is not checked
+ *************************************************/
+static bool parseSmith(const string & smith, int & source, int & dest)
+{
+   if (smith.size() != 4 && smith.size() != 5)
+      return false;
+   for (int i = 0; i < 4; i += 2)
+      if (smith[i] < 'a' || smith[i] > 'h' || smith[i + 1] < '1' || smith[i + 1] > '8')
+         return false;
+   source = (smith[1] - '1') * 8 + (smith[0] - 'a');
+   dest   = (smith[3] - '1') * 8 + (smith[2] - 'a');
+   return true;
+}
+
+/*************************************************
+ * FRAME SIZE
+ *************************************************/
+size_t frameSize(const uint8_t * bytes, size_t size)
+{
+   return size < 2 ? 0 : 2 + size_t(get16(bytes));
+}
+
+/*************************************************
+ * ENCODE REQUEST
+ *************************************************/
+void encodeRequest(vector <uint8_t> & bytes, uint8_t type, uint32_t tag,
+                   uint32_t session, const void * payload, size_t sizePayload)
+{
+   assert(SIZE_REQUEST_HEADER + sizePayload <= SIZE_FRAME_MAX);
+   bytes.clear();
+   put16(bytes, uint16_t(SIZE_REQUEST_HEADER - 2 + sizePayload));
+   bytes.push_back(type);
+   put32(bytes, tag);
+   put32(bytes, session);
+   const uint8_t * p = static_cast <const uint8_t *> (payload);
+   bytes.insert(bytes.end(), p, p + sizePayload);
+}
+
+/*************************************************
+ * DECODE REQUEST
+ *************************************************/
+bool decodeRequest(const uint8_t * bytes, size_t size, Request & request)
+{
+   if (size < SIZE_REQUEST_HEADER || frameSize(bytes, size) != size)
+      return false;
+   request.type        = bytes[2];
+   request.tag         = get32(bytes + 3);
+   request.session     = get32(bytes + 7);
+   request.payload     = bytes + SIZE_REQUEST_HEADER;
+   request.sizePayload = size - SIZE_REQUEST_HEADER;
+   return true;
+}
+
+/*************************************************
+ * ENCODE RESPONSE
+ *************************************************/
+void encodeResponse(vector <uint8_t> & bytes, uint8_t type, uint8_t status,
+                    uint32_t tag, const void * payload, size_t sizePayload)
+{
+   assert(SIZE_RESPONSE_HEADER + sizePayload <= SIZE_FRAME_MAX);
+   bytes.clear();
+   put16(bytes, uint16_t(SIZE_RESPONSE_HEADER - 2 + sizePayload));
+   bytes.push_back(type);
+   bytes.push_back(status);
+   put32(bytes, tag);
+   const uint8_t * p = static_cast <const uint8_t *> (payload);
+   bytes.insert(bytes.end(), p, p + sizePayload);
+}
+
+/*************************************************
+ * DECODE RESPONSE
+ *************************************************/
+bool decodeResponse(const uint8_t * bytes, size_t size, Response & response)
+{
+   if (size < SIZE_RESPONSE_HEADER || frameSize(bytes, size) != size)
+      return false;
+   response.type   = bytes[2];
+   response.status = bytes[3];
+   response.tag    = get32(bytes + 4);
+   response.payload.assign(bytes + SIZE_RESPONSE_HEADER, bytes + size);
+   return true;
+}
+
+/*************************************************
+ * a string with a one byte length
+ *************************************************/
+static bool putString(vector <uint8_t> & bytes, const string & text)
+{
+   if (text.size() > 0xFF)
+      return false;
+   bytes.push_back(uint8_t(text.size()));
+   bytes.insert(bytes.end(), text.begin(), text.end());
+   return true;
+}
+static bool getString(const uint8_t * & p, const uint8_t * pEnd, string & text)
+{
+   if (p >= pEnd || size_t(pEnd - p) < size_t(1 + p[0]))
+      return false;
+   text.assign(reinterpret_cast <const char *> (p + 1), p[0]);
+   p += 1 + p[0];
+   return true;
+}
+
+/*************************************************
+ * ENCODE BATCH
+ *************************************************/
+void encodeBatch(vector <uint8_t> & payload, const vector <BatchItem> & items)
+{
+   payload.clear();
+   put16(payload, uint16_t(items.size()));
+   for (const BatchItem & item : items)
+   {
+      put32(payload, item.session);
+      putString(payload, item.fen);
+      putString(payload, item.move);
+   }
+}
+
+/*************************************************
+ * DECODE BATCH
+ *************************************************/
+bool decodeBatch(const uint8_t * payload, size_t size, vector <BatchItem> & items)
+{
+   items.clear();
+   if (size < 2)
+      return false;
+   const uint8_t * p = payload + 2;
+   const uint8_t * pEnd = payload + size;
+   if (get16(payload) > NUM_BATCH_MAX)
+      return false;
+   items.resize(get16(payload));
+   for (BatchItem & item : items)
+   {
+      if (pEnd - p < 4)
+         return false;
+      item.session = get32(p);
+      p += 4;
+      if (!getString(p, pEnd, item.fen) || !getString(p, pEnd, item.move))
+         return false;
+   }
+   return p == pEnd;
+}
+
+/*************************************************
+ * ENCODE BATCH RESULTS
+ *************************************************/
+bool encodeBatchResults(vector <uint8_t> & payload, const vector <BatchResult> & results)
+{
+   payload.clear();
+   put16(payload, uint16_t(results.size()));
+   for (const BatchResult & result : results)
+   {
+      payload.push_back(result.status);
+      if (!putString(payload, result.fen))
+         return false;
+   }
+   return SIZE_RESPONSE_HEADER + payload.size() <= SIZE_FRAME_MAX;
+}
+
+/*************************************************
+ * DECODE BATCH RESULTS
+ *************************************************/
+bool decodeBatchResults(const uint8_t * payload, size_t size, vector <BatchResult> & results)
+{
+   results.clear();
+   if (size < 2)
+      return false;
+   const uint8_t * p = payload + 2;
+   const uint8_t * pEnd = payload + size;
+   results.resize(get16(payload));
+   for (BatchResult & result : results)
+   {
+      if (p >= pEnd)
+         return false;
+      result.status = *p++;
+      if (!getString(p, pEnd, result.fen))
+         return false;
+   }
+   return p == pEnd;
+}
+
+/*************************************************
+ * REQUEST NAME
+ *************************************************/
+const char * requestName(int type)
+{
+   static const char * names[REQUEST_NUM] =
+      { "new", "move", "validate", "query", "close", "stats", "batch" };
+   return (type >= 0 && type < REQUEST_NUM) ? names[type] : "unknown";
+}
+
+/*************************************************
+ * SESSION TABLE : CREATE
+ * Set the board up before it goes in the table so
+ * nobody can see it half made
+ *************************************************/
+uint32_t SessionTable::create(const string & fen)
+{
+   shared_ptr <Session> pSession = make_shared <Session> ();
+   if (!fen.empty() && !pSession->board.setFen(fen))
+      return 0;
+
+   uint32_t id;
+   do
+      id = idNext.fetch_add(1, memory_order_relaxed);
+   while (id == 0);   // 0 is never a game, even after wrapping around
+
+   Shard & s = shard(id);
+   lock_guard <mutex> lock(s.mutexShard);
+   s.sessions[id] = pSession;
+   return id;
+}
+
+/*************************************************
+ * SESSION TABLE : FIND
+ *************************************************/
+shared_ptr <Session> SessionTable::find(uint32_t id)
+{
+   Shard & s = shard(id);
+   lock_guard <mutex> lock(s.mutexShard);
+   auto it = s.sessions.find(id);
+   return it == s.sessions.end() ? nullptr : it->second;
+}
+
+/*************************************************
+ * SESSION TABLE : ERASE
+ *************************************************/
+bool SessionTable::erase(uint32_t id)
+{
+   // let the last holder, not us, free the board outside the lock
+   shared_ptr <Session> pSession;
+   Shard & s = shard(id);
+   lock_guard <mutex> lock(s.mutexShard);
+   auto it = s.sessions.find(id);
+   if (it == s.sessions.end())
+      return false;
+   pSession.swap(it->second);
+   s.sessions.erase(it);
+   return true;
+}
+
+/*************************************************
+ * SESSION TABLE : SIZE
+ *************************************************/
+size_t SessionTable::size()
+{
+   size_t num = 0;
+   for (Shard & s : shards)
+   {
+      lock_guard <mutex> lock(s.mutexShard);
+      num += s.sessions.size();
+   }
+   return num;
+}
+
+/*************************************************
+ * SESSION SERVER : HANDLE
+ *************************************************/
+void SessionServer::handle(const uint8_t * bytes, size_t size, vector <uint8_t> & response,
+                           chrono::steady_clock::time_point received)
+{
+   Request request;
+   if (!decodeRequest(bytes, size, request))
+   {
+      // we do not even know the tag; answer what we can
+      encodeResponse(response, size > 2 ? bytes[2] : 0, STATUS_BAD_REQUEST, 0, nullptr, 0);
+      return;
+   }
+
+   vector <uint8_t> payload;
+   uint8_t status;
+   switch (request.type)
+   {
+      case REQUEST_NEW:
+         status = create(request, payload);
+         break;
+      case REQUEST_MOVE:
+      case REQUEST_VALIDATE:
+         status = move(request, request.type == REQUEST_MOVE);
+         break;
+      case REQUEST_QUERY:
+         status = query(request, payload);
+         break;
+      case REQUEST_CLOSE:
+         status = request.sizePayload != 0           ? STATUS_BAD_REQUEST :
+                  sessions.erase(request.session)    ? STATUS_OK : STATUS_NO_SESSION;
+         break;
+      case REQUEST_STATS:
+      {
+         ostringstream out;
+         report(out);
+         string text = out.str();
+         payload.assign(text.begin(), text.end());
+         status = STATUS_OK;
+         break;
+      }
+      case REQUEST_BATCH:
+         status = batch(request, payload);
+         break;
+      default:
+         status = STATUS_BAD_REQUEST;
+   }
+   encodeResponse(response, request.type, status, request.tag, payload.data(), payload.size());
+
+   if (request.type < REQUEST_NUM)
+      latency[request.type].record(uint64_t(chrono::duration_cast <chrono::nanoseconds>
+                                   (chrono::steady_clock::now() - received).count()));
+}
+
+/*************************************************
+ * SESSION SERVER : CREATE
+ *************************************************/
+uint8_t SessionServer::create(const Request & request, vector <uint8_t> & payload)
+{
+   string fen(reinterpret_cast <const char *> (request.payload), request.sizePayload);
+   uint32_t id = sessions.create(fen);
+   if (id == 0)
+      return STATUS_ILLEGAL;
+   put32(payload, id);
+   return STATUS_OK;
+}
+
+/*************************************************
+ * SESSION SERVER : MOVE
+ *************************************************/
+uint8_t SessionServer::move(const Request & request, bool fMove)
+{
+   if (request.sizePayload != 2 || request.payload[0] > 63 || request.payload[1] > 63)
+      return STATUS_BAD_REQUEST;
+   shared_ptr <Session> pSession = sessions.find(request.session);
+   if (!pSession)
+      return STATUS_NO_SESSION;
+
+   lock_guard <mutex> lock(pSession->mutexBoard);
+   return playMove(pSession->board, request.payload[0], request.payload[1], fMove);
+}
+
+/*************************************************
+ * SESSION SERVER : QUERY
+ *************************************************/
+uint8_t SessionServer::query(const Request & request, vector <uint8_t> & payload)
+{
+   if (request.sizePayload != 0)
+      return STATUS_BAD_REQUEST;
+   shared_ptr <Session> pSession = sessions.find(request.session);
+   if (!pSession)
+      return STATUS_NO_SESSION;
+
+   lock_guard <mutex> lock(pSession->mutexBoard);
+   const Board & board = pSession->board;
+   payload.assign(board.getSquares(), board.getSquares() + 64);
+   payload.push_back(board.whiteTurn() ? 1 : 0);
+   put16(payload, uint16_t(board.getCurrentMove()));
+   return STATUS_OK;
+}
+
+/*************************************************
+ * SESSION SERVER : BATCH
+ * The bytes in and out; the work is below. A batch
+ * too big to answer is refused by decodeBatch before
+ * any of its moves are played, so the answer to one
+ * we take always fits
+ *************************************************/
+uint8_t SessionServer::batch(const Request & request, vector <uint8_t> & payload)
+{
+   vector <BatchItem> items;
+   if (!decodeBatch(request.payload, request.sizePayload, items))
+      return STATUS_BAD_REQUEST;
+
+   vector <BatchResult> results;
+   batch(items, results);
+   bool fEncoded = encodeBatchResults(payload, results);
+   assert(fEncoded);
+   (void)fEncoded;
+   return STATUS_OK;
+}
+
+/*************************************************
+ * BATCH WORK
+ * What the threads of one batch share. The helpers
+ * may start after the batch is done, so they hold
+ * it with a shared_ptr and only touch the items for
+ * an index they got below num
+ *************************************************/
+struct BatchWork
+{
+   BatchWork(const vector <BatchItem> & items, vector <BatchResult> & results) :
+      items(items), results(results), next(0), done(0) {}
+
+   const vector <BatchItem> & items;
+   vector <BatchResult> & results;
+   atomic <size_t> next;                // the next item for anybody to take
+   size_t done;
+   mutex mutexDone;
+   condition_variable allDone;
+};
+
+/*************************************************
+ * SESSION SERVER : BATCH
+ * The pool's threads help, but this one works too,
+ * so a batch finishes even when every worker is
+ * busy, and it never waits on a worker that has
+ * not started. Each thread takes a few items at a
+ * time and sets them up on one scratch board
+ *************************************************/
+void SessionServer::batch(const vector <BatchItem> & items, vector <BatchResult> & results)
+{
+   const size_t SIZE_CHUNK = 8;
+   size_t num = items.size();
+   results.assign(num, BatchResult());
+   if (num == 0)
+      return;
+
+   shared_ptr <BatchWork> pWork = make_shared <BatchWork> (items, results);
+   auto work = [this, pWork, num]()
+   {
+      Board scratch(nullptr, true /*noreset*/);
+      size_t first;
+      while ((first = pWork->next.fetch_add(SIZE_CHUNK)) < num)
+      {
+         size_t last = first + SIZE_CHUNK < num ? first + SIZE_CHUNK : num;
+         for (size_t i = first; i < last; i++)
+            play(pWork->items[i], pWork->results[i], scratch);
+
+         lock_guard <mutex> lock(pWork->mutexDone);
+         pWork->done += last - first;
+         if (pWork->done == num)
+            pWork->allDone.notify_one();
+      }
+   };
+
+   if (pPool)
+      for (size_t i = 1; i < (num + SIZE_CHUNK - 1) / SIZE_CHUNK && int(i) <= pPool->size(); i++)
+         pPool->submit(work);
+   work();
+
+   unique_lock <mutex> lock(pWork->mutexDone);
+   pWork->allDone.wait(lock, [&pWork, num]() { return pWork->done == num; });
+}
+
+/*************************************************
+ * SESSION SERVER : PLAY
+ * One batch item: on the game if it names one,
+ * otherwise on the scratch board
+ *************************************************/
+void SessionServer::play(const BatchItem & item, BatchResult & result, Board & scratch)
+{
+   result.fen.clear();
+   int source;
+   int dest;
+   if (!parseSmith(item.move, source, dest))
+   {
+      result.status = STATUS_BAD_REQUEST;
+      return;
+   }
+
+   if (item.session == 0)
+   {
+      if (!scratch.setFen(item.fen))
+         result.status = STATUS_BAD_REQUEST;
+      else if ((result.status = playMove(scratch, source, dest, true /*fMove*/)) == STATUS_OK)
+         result.fen = scratch.getFen();
+      return;
+   }
+
+   shared_ptr <Session> pSession = sessions.find(item.session);
+   if (!pSession)
+   {
+      result.status = STATUS_NO_SESSION;
+      return;
+   }
+   lock_guard <mutex> lock(pSession->mutexBoard);
+   if ((result.status = playMove(pSession->board, source, dest, true /*fMove*/)) == STATUS_OK)
+      result.fen = pSession->board.getFen();
+}
+
+/*************************************************
+ * SESSION SERVER : REPORT
+ *************************************************/
+void SessionServer::report(ostream & out) const
+{
+   out << left << setw(10) << "request" << right
+       << setw(10) << "count"
+       << setw(10) << "p50 us"
+       << setw(10) << "p99 us"
+       << setw(10) << "max us" << '\n';
+   out << fixed << setprecision(1);
+   for (int type = 0; type < REQUEST_NUM; type++)
+   {
+      const LatencyHistogram & h = latency[type];
+      if (h.getCount() == 0)
+         continue;
+      out << left << setw(10) << requestName(type) << right
+          << setw(10) << h.getCount()
+          << setw(10) << h.percentile(0.50) / 1000.0
+          << setw(10) << h.percentile(0.99) / 1000.0
+          << setw(10) << h.getMax() / 1000.0 << '\n';
+   }
+}
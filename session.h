@@ -0,0 +1,252 @@
+/***********************************************************************
+ * Header File:
+ *    SESSION
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Many games in one process: a table of boards by session id, and
+ *    the compact binary requests that create them, make and check moves
+ *    on them, and read them back. Any number of threads may handle
+ *    requests at once; two requests for the same game take turns.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>        // for UINT32_T
+#include <vector>         // for VECTOR of bytes
+#include <string>         // for STRING of a FEN
+#include <memory>         // for SHARED_PTR of a session
+#include <mutex>          // for MUTEX per session and per shard
+#include <unordered_map>  // for UNORDERED_MAP of sessions
+#include <atomic>         // for ATOMIC next id
+#include <chrono>         // for STEADY_CLOCK, when a request came in
+#include <iostream>       // for OSTREAM
+#include "board.h"
+#include "latencyHistogram.h"
+
+class TestSession;
+class ThreadPool;
+
+/***************************************************
+ * PROTOCOL
+ * Every number is little-endian. A request is
+ *    u16 size   bytes after this field
+ *    u8  type   a RequestType
+ *    u32 tag    anything; handed back in the response
+ *    u32 session
+ *    payload
+ * and its response is
+ *    u16 size   bytes after this field
+ *    u8  type   the request's
+ *    u8  status a ResponseStatus
+ *    u32 tag    the request's
+ *    payload
+ * Payloads, request -> response:
+ *    NEW       FEN, empty for the start -> u32 session
+ *    MOVE      u8 source, u8 dest       -> nothing
+ *    VALIDATE  u8 source, u8 dest       -> nothing
+ *    QUERY     nothing -> 64 squareCode()s, u8 white to move, u16 moves
+ *    CLOSE     nothing                  -> nothing
+ *    STATS     nothing                  -> the latency report as text
+ *    BATCH     u16 count up to NUM_BATCH_MAX, then each item u32
+ *              session, u8 length, FEN, u8 length, Smith move
+ *                -> u16 count, then each u8 status, u8 length, FEN after
+ * Squares are row * 8 + col, a1 is 0. Responses may come back in any
+ * order; match them up with the tag.
+ * A batch item with session 0 plays its move on its FEN and forgets it;
+ * any other plays it on that game. The session of the request itself is
+ * not used. Items run in parallel, so two items on one game in the same
+ * batch may be played in either order
+ ***************************************************/
+enum RequestType
+{
+   REQUEST_NEW,
+   REQUEST_MOVE,
+   REQUEST_VALIDATE,
+   REQUEST_QUERY,
+   REQUEST_CLOSE,
+   REQUEST_STATS,
+   REQUEST_BATCH,
+   REQUEST_NUM
+};
+
+enum ResponseStatus
+{
+   STATUS_OK,
+   STATUS_ILLEGAL,        // not a legal move, or not a FEN we can set up
+   STATUS_NO_SESSION,     // no game with that id
+   STATUS_BAD_REQUEST     // an unknown type, or the wrong payload
+};
+
+const size_t SIZE_REQUEST_HEADER  = 2 + 1 + 4 + 4;
+const size_t SIZE_RESPONSE_HEADER = 2 + 1 + 1 + 4;
+const size_t SIZE_FRAME_MAX       = 2 + 0xFFFF;
+
+// the most items in one BATCH: the answer to each is at most a status
+// and a full length FEN, and all of them must fit in one frame
+const size_t NUM_BATCH_MAX = (SIZE_FRAME_MAX - SIZE_RESPONSE_HEADER - 2) / (1 + 1 + 0xFF);
+
+/***************************************************
+ * REQUEST
+ * A request read out of its bytes. The payload
+ * points into them
+ ***************************************************/
+struct Request
+{
+   uint8_t  type;
+   uint32_t tag;
+   uint32_t session;
+   const uint8_t * payload;
+   size_t   sizePayload;
+};
+
+/***************************************************
+ * RESPONSE
+ ***************************************************/
+struct Response
+{
+   uint8_t  type;
+   uint8_t  status;
+   uint32_t tag;
+   std::vector <uint8_t> payload;
+};
+
+// the size of the whole frame starting at bytes, or 0 if we do not
+// have all of the size field yet
+size_t frameSize(const uint8_t * bytes, size_t size);
+
+// a whole frame to and from its parts. decode returns false when the
+// frame is too short for its header or its size field is wrong
+void encodeRequest(std::vector <uint8_t> & bytes, uint8_t type, uint32_t tag,
+                   uint32_t session, const void * payload, size_t sizePayload);
+bool decodeRequest(const uint8_t * bytes, size_t size, Request & request);
+void encodeResponse(std::vector <uint8_t> & bytes, uint8_t type, uint8_t status,
+                    uint32_t tag, const void * payload, size_t sizePayload);
+bool decodeResponse(const uint8_t * bytes, size_t size, Response & response);
+
+/***************************************************
+ * BATCH ITEM
+ * Is move legal in the game, or in fen when session
+ * is 0, and what is the position after it
+ ***************************************************/
+struct BatchItem
+{
+   uint32_t session;
+   std::string fen;
+   std::string move;     // Smith notation, like g1f3
+};
+
+struct BatchResult
+{
+   uint8_t status;
+   std::string fen;      // after the move, or empty if it was not made
+};
+
+// a BATCH payload to and from its items. decode returns false when the
+// payload is cut short, has bytes left over, or has more than
+// NUM_BATCH_MAX items. encodeBatchResults returns false when they do
+// not fit in one frame
+void encodeBatch(std::vector <uint8_t> & payload, const std::vector <BatchItem> & items);
+bool decodeBatch(const uint8_t * payload, size_t size, std::vector <BatchItem> & items);
+bool encodeBatchResults(std::vector <uint8_t> & payload, const std::vector <BatchResult> & results);
+bool decodeBatchResults(const uint8_t * payload, size_t size, std::vector <BatchResult> & results);
+
+// "new", "move", ...
+const char * requestName(int type);
+
+/***************************************************
+ * SESSION
+ * One game. Lock it while using the board
+ ***************************************************/
+struct Session
+{
+   Session() : board(nullptr) {}
+
+   std::mutex mutexBoard;
+   Board board;
+};
+
+/***************************************************
+ * SESSION TABLE
+ * The games by id. The table is split in shards by
+ * id so threads looking up different games seldom
+ * wait on each other's lock
+ ***************************************************/
+class SessionTable
+{
+   friend TestSession;
+public:
+   SessionTable() : idNext(1) {}
+
+   // a new game from fen, or the start if it is empty. 0 if we cannot
+   // set up that position
+   uint32_t create(const std::string & fen);
+
+   // the game, or nullptr. It stays alive while it is held, even if
+   // another thread erases it
+   std::shared_ptr <Session> find(uint32_t id);
+
+   // false if there was no such game
+   bool erase(uint32_t id);
+
+   size_t size();
+
+private:
+   static const int NUM_SHARDS = 16;
+
+   struct Shard
+   {
+      std::mutex mutexShard;
+      std::unordered_map <uint32_t, std::shared_ptr <Session>> sessions;
+   };
+
+   Shard & shard(uint32_t id) { return shards[id % NUM_SHARDS]; }
+
+   Shard shards[NUM_SHARDS];
+   std::atomic <uint32_t> idNext;
+};
+
+/***************************************************
+ * SESSION SERVER
+ * Answers requests on the session table and keeps
+ * how long each type of request took
+ ***************************************************/
+class SessionServer
+{
+   friend TestSession;
+public:
+   SessionServer() : pPool(nullptr) {}
+
+   // one whole request frame in, its whole response frame out.
+   // received is when the request came in, so the latency includes
+   // however long it waited for a thread
+   void handle(const uint8_t * request, size_t size, std::vector <uint8_t> & response,
+               std::chrono::steady_clock::time_point received);
+   void handle(const uint8_t * request, size_t size, std::vector <uint8_t> & response)
+   {
+      handle(request, size, response, std::chrono::steady_clock::now());
+   }
+
+   // play every item, in parallel on the pool's threads as well as
+   // this one. With no pool, only on this thread
+   void batch(const std::vector <BatchItem> & items, std::vector <BatchResult> & results);
+   void setPool(ThreadPool * pPool)                { this->pPool = pPool;  }
+
+   SessionTable & getSessions()                    { return sessions;      }
+   const LatencyHistogram & getLatency(int type) const { return latency[type]; }
+
+   // a line per type of request: how many, and the p50, p99, and max
+   // microseconds from coming in to the response being ready
+   void report(std::ostream & out) const;
+
+private:
+   uint8_t create(const Request & request, std::vector <uint8_t> & payload);
+   uint8_t move(const Request & request, bool fMove);
+   uint8_t query(const Request & request, std::vector <uint8_t> & payload);
+   uint8_t batch(const Request & request, std::vector <uint8_t> & payload);
+   void play(const BatchItem & item, BatchResult & result, Board & scratch);
+
+   SessionTable sessions;
+   LatencyHistogram latency[REQUEST_NUM];
+   ThreadPool * pPool;                  // helps with batches, if we have one
+};
@@ -0,0 +1,428 @@
+/***********************************************************************
+ * Source File:
+ *    SESSION SOCKET
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The session server on a Unix domain socket. One thread waits on
+ *    every connection at once, cuts what arrives into requests, and
+ *    writes the answers back without ever blocking on a slow client;
+ *    a pool of workers answers them, and helps with the big batches.
+ ************************************************************************/
+
+#ifndef _WIN32
+
+#include "sessionSocket.h"
+#include <sys/socket.h>   // for SOCKET, SEND, RECV
+#include <sys/un.h>       // for SOCKADDR_UN
+#include <poll.h>         // for POLL
+#include <unistd.h>       // for CLOSE, PIPE, UNLINK
+#include <fcntl.h>        // for FCNTL to not block
+#include <cerrno>         // for ERRNO
+#include <cstring>        // for MEMCPY
+using namespace std;
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0    // macOS: ignore SIGPIPE instead
+#endif
+
+/*************************************************
+ * SEND ALL
+ * Keep at it until everything is written
+ *************************************************/
+static bool sendAll(int fd, const uint8_t * bytes, size_t size)
+{
+   while (size > 0)
+   {
+      ssize_t sent = ::send(fd, bytes, size, MSG_NOSIGNAL);
+      if (sent < 0 && errno == EINTR)
+         continue;
+      if (sent <= 0)
+         return false;
+      bytes += sent;
+      size -= size_t(sent);
+   }
+   return true;
+}
+
+/*************************************************
+ * NON BLOCKING
+ *************************************************/
+static bool nonBlocking(int fd)
+{
+   int flags = fcntl(fd, F_GETFL, 0);
+   return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/*************************************************
+ * ADDRESS
+ * False if the path does not fit
+ *************************************************/
+static bool address(const string & path, sockaddr_un & addr)
+{
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   if (path.size() >= sizeof(addr.sun_path))
+      return false;
+   memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+   return true;
+}
+
+/*************************************************
+ * SOCKET SERVER : CONSTRUCT
+ *************************************************/
+SocketServer::SocketServer(SessionServer & server, int numThreads) :
+   server(server),
+   pool(numThreads),
+   fdListen(-1),
+   fStop(false)
+{
+   server.setPool(&pool);
+   if (pipe(fdWake) != 0)
+      fdWake[0] = fdWake[1] = -1;
+   else
+   {
+      // a full pipe already has run() awake
+      nonBlocking(fdWake[0]);
+      nonBlocking(fdWake[1]);
+   }
+}
+
+/*************************************************
+ * SOCKET SERVER : DESTRUCT
+ * The workers may still be answering; let them
+ * finish before the socket goes away
+ *************************************************/
+SocketServer::~SocketServer()
+{
+   pool.wait();
+   server.setPool(nullptr);
+   if (fdListen >= 0)
+   {
+      ::close(fdListen);
+      unlink(path.c_str());
+   }
+   for (int fd : fdWake)
+      if (fd >= 0)
+         ::close(fd);
+}
+
+/*************************************************
+ * SOCKET SERVER : LISTEN
+ *************************************************/
+bool SocketServer::listen(const string & path)
+{
+   sockaddr_un addr;
+   if (fdListen >= 0 || !address(path, addr))
+      return false;
+
+   int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0)
+      return false;
+   unlink(path.c_str());
+   if (::bind(fd, reinterpret_cast <sockaddr *> (&addr), sizeof(addr)) != 0 ||
+       ::listen(fd, SOMAXCONN) != 0)
+   {
+      ::close(fd);
+      return false;
+   }
+   fdListen = fd;
+   this->path = path;
+   return true;
+}
+
+/*************************************************
+ * SOCKET SERVER : STOP
+ * Only write() and an atomic, so a signal handler
+ * may call it
+ *************************************************/
+void SocketServer::stop()
+{
+   fStop = true;
+   wake();
+}
+
+/*************************************************
+ * SOCKET SERVER : WAKE
+ * Get run() out of poll() to look again
+ *************************************************/
+void SocketServer::wake()
+{
+   if (fdWake[1] >= 0)
+   {
+      char ch = 0;
+      ssize_t ignored = ::write(fdWake[1], &ch, 1);
+      (void)ignored;
+   }
+}
+
+/*************************************************
+ * SOCKET SERVER : RUN
+ * Wait on the listening socket, the wake pipe, and
+ * every connection: to read while it has fewer than
+ * NUM_IN_FLIGHT_MAX requests in flight, and to
+ * write while it has answers waiting. A connection
+ * that closes is dropped here, though the workers
+ * may hold it a little longer to finish answering.
+ * One that has only stopped sending is kept until
+ * every request it sent is answered
+ *************************************************/
+void SocketServer::run()
+{
+   vector <shared_ptr <Connection>> connections;
+   vector <pollfd> fds;
+   while (!fStop && fdListen >= 0)
+   {
+      fds.clear();
+      fds.push_back({ fdListen, POLLIN, 0 });
+      fds.push_back({ fdWake[0], POLLIN, 0 });
+      for (const shared_ptr <Connection> & pConnection : connections)
+      {
+         short events = !pConnection->fEof &&
+                        pConnection->numInFlight < NUM_IN_FLIGHT_MAX ? POLLIN : 0;
+         lock_guard <mutex> lock(pConnection->mutexOutbound);
+         if (!pConnection->outbound.empty())
+            events |= POLLOUT;
+         fds.push_back({ pConnection->fd, events, 0 });
+      }
+
+      if (poll(fds.data(), fds.size(), -1) < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         break;
+      }
+
+      if (fds[1].revents & POLLIN)
+      {
+         char buffer[256];
+         while (::read(fdWake[0], buffer, sizeof(buffer)) > 0)
+            ;
+      }
+
+      // the connections first, as accept() will add to them
+      vector <shared_ptr <Connection>> open;
+      for (size_t i = 0; i < connections.size(); i++)
+      {
+         short events = fds[i + 2].revents;
+         bool fOpen = true;
+         if (events & POLLIN)
+            fOpen = read(connections[i]);
+         if (fOpen && (events & POLLOUT))
+            fOpen = write(connections[i]);
+         if (fOpen && (events & (POLLERR | POLLHUP | POLLNVAL)) && !(events & POLLIN))
+            fOpen = false;
+         if (fOpen && connections[i]->fEof && connections[i]->numInFlight == 0)
+            fOpen = false;
+         if (fOpen)
+            open.push_back(connections[i]);
+      }
+      connections.swap(open);
+
+      if (fds[0].revents & POLLIN)
+      {
+         int fd = accept(fdListen, nullptr, nullptr);
+         if (fd >= 0 && nonBlocking(fd))
+            connections.push_back(make_shared <Connection> (fd));
+         else if (fd >= 0)
+            ::close(fd);
+      }
+   }
+}
+
+/*************************************************
+ * SOCKET SERVER : READ
+ * Take what has arrived and hand out the whole
+ * requests. At the end of what the client sends we
+ * stop reading, but what it sent is still answered.
+ * False when the connection failed
+ *************************************************/
+bool SocketServer::read(const shared_ptr <Connection> & pConnection)
+{
+   uint8_t buffer[16384];
+   ssize_t size = recv(pConnection->fd, buffer, sizeof(buffer), 0);
+   if (size < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+      return true;
+   if (size < 0)
+      return false;
+   if (size == 0)
+   {
+      pConnection->fEof = true;
+      return true;
+   }
+
+   vector <uint8_t> & bytes = pConnection->received;
+   bytes.insert(bytes.end(), buffer, buffer + size);
+   dispatch(pConnection);
+   return true;
+}
+
+/*************************************************
+ * SOCKET SERVER : DISPATCH
+ * Hand each whole request received to a worker,
+ * up to NUM_IN_FLIGHT_MAX at a time. The rest wait
+ * in received until write() makes room
+ *************************************************/
+void SocketServer::dispatch(const shared_ptr <Connection> & pConnection)
+{
+   chrono::steady_clock::time_point received = chrono::steady_clock::now();
+   vector <uint8_t> & bytes = pConnection->received;
+
+   size_t start = 0;
+   size_t sizeFrame;
+   while (pConnection->numInFlight < NUM_IN_FLIGHT_MAX &&
+          (sizeFrame = frameSize(bytes.data() + start, bytes.size() - start)) != 0 &&
+          start + sizeFrame <= bytes.size())
+   {
+      shared_ptr <vector <uint8_t>> pRequest = make_shared <vector <uint8_t>>
+         (bytes.begin() + start, bytes.begin() + start + sizeFrame);
+      start += sizeFrame;
+      pConnection->numInFlight++;
+
+      SocketServer * pSocketServer = this;
+      pool.submit([pSocketServer, pConnection, pRequest, received]()
+      {
+         vector <uint8_t> response;
+         pSocketServer->server.handle(pRequest->data(), pRequest->size(), response, received);
+         {
+            lock_guard <mutex> lock(pConnection->mutexOutbound);
+            pConnection->outbound.push_back(move(response));
+         }
+         pSocketServer->wake();
+      });
+   }
+   bytes.erase(bytes.begin(), bytes.begin() + start);
+}
+
+/*************************************************
+ * SOCKET SERVER : WRITE
+ * Write the waiting answers until the socket is
+ * full. Each one written in full makes room for
+ * another request. False when the connection is done
+ *************************************************/
+bool SocketServer::write(const shared_ptr <Connection> & pConnection)
+{
+   int numWritten = 0;
+   {
+      lock_guard <mutex> lock(pConnection->mutexOutbound);
+      deque <vector <uint8_t>> & outbound = pConnection->outbound;
+      while (!outbound.empty())
+      {
+         const vector <uint8_t> & bytes = outbound.front();
+         ssize_t sent = ::send(pConnection->fd, bytes.data() + pConnection->sizeSent,
+                               bytes.size() - pConnection->sizeSent, MSG_NOSIGNAL);
+         if (sent < 0 && errno == EINTR)
+            continue;
+         if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+         if (sent <= 0)
+            return false;
+         pConnection->sizeSent += size_t(sent);
+         if (pConnection->sizeSent == bytes.size())
+         {
+            outbound.pop_front();
+            pConnection->sizeSent = 0;
+            numWritten++;
+         }
+      }
+   }
+
+   pConnection->numInFlight -= numWritten;
+   if (numWritten > 0)
+      dispatch(pConnection);
+   return true;
+}
+
+/*************************************************
+ * CONNECTION
+ *************************************************/
+SocketServer::Connection::~Connection()
+{
+   ::close(fd);
+}
+
+/*************************************************
+ * SESSION CLIENT : CONNECT
+ *************************************************/
+bool SessionClient::connect(const string & path)
+{
+   close();
+   sockaddr_un addr;
+   if (!address(path, addr))
+      return false;
+   fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (fd < 0)
+      return false;
+   if (::connect(fd, reinterpret_cast <sockaddr *> (&addr), sizeof(addr)) != 0)
+   {
+      close();
+      return false;
+   }
+   return true;
+}
+
+/*************************************************
+ * SESSION CLIENT : CLOSE
+ *************************************************/
+void SessionClient::close()
+{
+   if (fd >= 0)
+      ::close(fd);
+   fd = -1;
+   received.clear();
+}
+
+/*************************************************
+ * SESSION CLIENT : FINISH
+ *************************************************/
+bool SessionClient::finish()
+{
+   return fd >= 0 && shutdown(fd, SHUT_WR) == 0;
+}
+
+/*************************************************
+ * SESSION CLIENT : SEND
+ *************************************************/
+uint32_t SessionClient::send(uint8_t type, uint32_t session,
+                             const void * payload, size_t sizePayload)
+{
+   uint32_t tag = tagNext++;
+   if (tagNext == 0)
+      tagNext = 1;
+   encodeRequest(bytes, type, tag, session, payload, sizePayload);
+   return (fd >= 0 && sendAll(fd, bytes.data(), bytes.size())) ? tag : 0;
+}
+
+/*************************************************
+ * SESSION CLIENT : RECEIVE
+ *************************************************/
+bool SessionClient::receive(Response & response)
+{
+   size_t sizeFrame;
+   while ((sizeFrame = frameSize(received.data(), received.size())) == 0 ||
+          sizeFrame > received.size())
+   {
+      uint8_t buffer[16384];
+      ssize_t size = fd < 0 ? 0 : recv(fd, buffer, sizeof(buffer), 0);
+      if (size < 0 && errno == EINTR)
+         continue;
+      if (size <= 0)
+         return false;
+      received.insert(received.end(), buffer, buffer + size);
+   }
+   bool fDecoded = decodeResponse(received.data(), sizeFrame, response);
+   received.erase(received.begin(), received.begin() + sizeFrame);
+   return fDecoded;
+}
+
+/*************************************************
+ * SESSION CLIENT : CALL
+ *************************************************/
+bool SessionClient::call(uint8_t type, uint32_t session, Response & response,
+                         const void * payload, size_t sizePayload)
+{
+   uint32_t tag = send(type, session, payload, sizePayload);
+   return tag != 0 && receive(response) && response.tag == tag;
+}
+
+#endif // !_WIN32
@@ -0,0 +1,117 @@
+/***********************************************************************
+ * Header File:
+ *    SESSION SOCKET
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The session server on a Unix domain socket. One thread waits on
+ *    every connection at once, cuts what arrives into requests, and
+ *    writes the answers back as each socket has room; a pool of
+ *    workers answers them. A little client to talk to it, too.
+ *    There are no Unix domain sockets here on Windows.
+ ************************************************************************/
+
+#pragma once
+
+#ifndef _WIN32
+
+#include <string>       // for STRING path
+#include <vector>       // for VECTOR of bytes
+#include <deque>        // for DEQUE of answers to write
+#include <memory>       // for SHARED_PTR of a connection
+#include <mutex>        // for MUTEX on the answers
+#include <atomic>       // for ATOMIC stop
+#include "session.h"
+#include "threadPool.h"
+
+class TestSession;
+
+/***************************************************
+ * SOCKET SERVER
+ ***************************************************/
+class SocketServer
+{
+   friend TestSession;
+public:
+   // zero threads means one per hardware thread
+   SocketServer(SessionServer & server, int numThreads = 0);
+   ~SocketServer();
+
+   // make the socket at path, replacing whatever was there
+   bool listen(const std::string & path);
+
+   // serve until stop()
+   void run();
+
+   // safe from another thread or from a signal handler
+   void stop();
+
+private:
+   // requests a connection may have taken and not yet had answered in
+   // full. Past this we stop reading it until the client catches up
+   static const int NUM_IN_FLIGHT_MAX = 64;
+
+   struct Connection
+   {
+      Connection(int fd) : fd(fd), sizeSent(0), numInFlight(0), fEof(false) {}
+      ~Connection();
+
+      int fd;                           // non-blocking
+      std::vector <uint8_t> received;   // the start of a request not all here yet
+      size_t sizeSent;                  // of the first answer in outbound
+      int numInFlight;                  // taken but not all written yet
+      bool fEof;                        // the client will send no more
+      std::mutex mutexOutbound;         // the workers add, run() writes
+      std::deque <std::vector <uint8_t>> outbound;  // answers not written yet
+   };
+
+   bool read(const std::shared_ptr <Connection> & pConnection);
+   bool write(const std::shared_ptr <Connection> & pConnection);
+   void dispatch(const std::shared_ptr <Connection> & pConnection);
+   void wake();
+
+   SessionServer & server;
+   ThreadPool pool;
+   int fdListen;
+   int fdWake[2];                       // stop() and the workers wake run() here
+   std::string path;
+   std::atomic <bool> fStop;
+};
+
+/***************************************************
+ * SESSION CLIENT
+ * Blocking calls on one connection. Send several
+ * before receiving any to keep the server busy
+ ***************************************************/
+class SessionClient
+{
+public:
+   SessionClient() : fd(-1), tagNext(1) {}
+   ~SessionClient() { close(); }
+
+   bool connect(const std::string & path);
+   void close();
+
+   // tell the server we will send no more. What we sent is still
+   // answered, then the server closes the connection
+   bool finish();
+
+   // send a request; its tag, or 0 if the connection failed
+   uint32_t send(uint8_t type, uint32_t session, const void * payload = nullptr,
+                 size_t sizePayload = 0);
+
+   // the next response, in whatever order the server finished them
+   bool receive(Response & response);
+
+   // send and receive one; false if the connection failed
+   bool call(uint8_t type, uint32_t session, Response & response,
+             const void * payload = nullptr, size_t sizePayload = 0);
+
+private:
+   int fd;
+   uint32_t tagNext;
+   std::vector <uint8_t> bytes;
+   std::vector <uint8_t> received;
+};
+
+#endif // !_WIN32
@@ -0,0 +1,69 @@
+/***********************************************************************
+ * Header File:
+ *    SPSC QUEUE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A fixed-size queue for exactly one thread putting things in and
+ *    one thread taking them out, with no locks: each side only writes
+ *    its own index, and reads the other's to see how far it may go.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>     // for ATOMIC indices
+#include <cstddef>    // for SIZE_T
+
+class TestSpscQueue;
+
+/***************************************************
+ * SPSC QUEUE
+ * Holds up to SIZE - 1 items. SIZE must be a power
+ * of two so the indices wrap with a mask
+ ***************************************************/
+template <class T, size_t SIZE>
+class SpscQueue
+{
+   friend TestSpscQueue;
+   static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0,
+                 "SpscQueue size must be a power of two");
+public:
+   SpscQueue() : head(0), tail(0) {}
+
+   // the producer: false, dropping item, when the queue is full
+   bool push(const T & item)
+   {
+      size_t t = tail.load(std::memory_order_relaxed);
+      size_t next = (t + 1) & (SIZE - 1);
+      if (next == head.load(std::memory_order_acquire))
+         return false;
+      items[t] = item;
+      tail.store(next, std::memory_order_release);
+      return true;
+   }
+
+   // the consumer: false when there is nothing to take
+   bool pop(T & item)
+   {
+      size_t h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire))
+         return false;
+      item = items[h];
+      head.store((h + 1) & (SIZE - 1), std::memory_order_release);
+      return true;
+   }
+
+   // only a hint when the other thread is busy
+   bool empty() const
+   {
+      return head.load(std::memory_order_acquire) ==
+             tail.load(std::memory_order_acquire);
+   }
+
+private:
+   // the two indices on their own cache lines so the threads do not
+   // take the line away from each other on every item
+   alignas(64) std::atomic <size_t> head;   // next to pop, the consumer's
+   alignas(64) std::atomic <size_t> tail;   // next to push, the producer's
+   alignas(64) T items[SIZE] = {};
+};
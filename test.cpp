@@ -14,19 +14,32 @@
 #include "testPosition.h"
 #include "testBoard.h"
 #include "testMove.h"
-
-// This code, and the similar IF_DEF in testRunner(), is to ensure that
-// you can see the text output (called the console window) and OpenGL's
-// graphics at the same time. It is not required on Apple's XCode, only
-// on Window's Visual Studio. If you have problems seeing the output window
-// and your team is exclusively on Visual Studio, you can safely remove
-// these two "#ifdef _WIN32" and the "#endif" below it.
-#ifdef _WIN32
-#include <windows.h>
-#include <iostream>
+#include "testSearch.h"
+#include "testTimeManager.h"
+#include "testNnue.h"
+#include "testPawnTable.h"
+#include "testUci.h"
+#include "testThreadPool.h"
+#include "testBenchHarness.h"
+#include "testAllocCount.h"
+#include "testTrace.h"
+#include "testPerfCounters.h"
+#include "testArena.h"
+#include "testBoardState.h"
+#include "testImage.h"
+#include "testSpscQueue.h"
+#include "testAnalysis.h"
+#include "testLatencyHistogram.h"
+#include "testSession.h"
+#include "testBook.h"
+#include "threadPool.h"
+#include <iostream>    // for COUT
+#include <iomanip>     // for SETW
+#include <sstream>     // for OSTRINGSTREAM, one report per test class
+#include <vector>      // for VECTOR of timings
+#include <algorithm>   // for SORT
+#include <chrono>      // for STEADY_CLOCK
 using namespace std;
-#endif
-
 
 int PieceSpy::numConstruct = 0;
 int PieceSpy::numCopy = 0;
@@ -34,24 +47,96 @@ int PieceSpy::numDelete = 0;
 int PieceSpy::numAssign = 0;
 int PieceSpy::numMove = 0;
 
+const int NUM_SLOWEST = 5;   // how many of the slowest tests to list
+
+/*****************************************************************
+ * MAKE
+ * Build one test class
+ ****************************************************************/
+template <class T>
+UnitTest * make()
+{
+   return new T;
+}
+
 /*****************************************************************
  * TEST RUNNER
- * Runs all the unit tests
+ * Runs all the unit tests. Each test class runs on its own
+ * thread from the pool; the reports are printed in order once
+ * they are all done, followed by the slowest tests.
  ****************************************************************/
-void testRunner()
+int testRunner(int numThreads)
 {
-#ifdef _WIN32
-   AllocConsole();
-   FILE* stream;
-   errno_t err;
-   err = freopen_s(&stream, "CONOUT$", "a", stdout);
-#endif // _WIN32
+   auto start = chrono::steady_clock::now();
 
    // unit tests
-   PositionTest().run();
-   TestMove().run();
-   TestBoard().run();
-   TestPiece().run();
-   TestSpace().run();
-   TestKnight().run();
+   UnitTest * (*factories[])() =
+   {
+      make <PositionTest>,
+      make <TestMove>,
+      make <TestBoard>,
+      make <TestPiece>,
+      make <TestSpace>,
+      make <TestKnight>,
+      make <TestSearch>,
+      make <TestTimeManager>,
+      make <TestNnue>,
+      make <TestPawnTable>,
+      make <TestUci>,
+      make <TestThreadPool>,
+      make <TestBenchHarness>,
+      make <TestAllocCount>,
+      make <TestTrace>,
+      make <TestPerfCounters>,
+      make <TestArena>,
+      make <TestBoardState>,
+      make <TestImage>,
+      make <TestSpscQueue>,
+      make <TestAnalysis>,
+      make <TestLatencyHistogram>,
+      make <TestSession>,
+      make <TestBook>
+   };
+   const int numTests = sizeof(factories) / sizeof(factories[0]);
+   ostringstream reports[numTests];
+
+   // build each test class on the thread that runs it, so its
+   // clock does not start while it waits in the queue
+   {
+      ThreadPool pool(numThreads);
+      for (int i = 0; i < numTests; i++)
+         pool.submit([&factories, &reports, i]
+         {
+            UnitTest * pTest = factories[i]();
+            pTest->setOutput(reports[i]);
+            pTest->run();
+            delete pTest;
+         });
+      pool.wait();
+   }
+
+   for (int i = 0; i < numTests; i++)
+      cout << reports[i].str();
+
+   // the slowest tests, so we notice when one suddenly gets slow
+   vector <UnitTest::Timing> timings = UnitTest::getTimings();
+   sort(timings.begin(), timings.end(),
+        [](const UnitTest::Timing & lhs, const UnitTest::Timing & rhs)
+        {
+           return lhs.ms > rhs.ms;
+        });
+   double msTests = 0.0;
+   for (const UnitTest::Timing & timing : timings)
+      msTests += timing.ms;
+
+   cout << "\nSlowest tests:\n";
+   for (int i = 0; i < NUM_SLOWEST && i < (int)timings.size(); i++)
+      cout << "\t" << setw(8) << setprecision(1) << fixed << timings[i].ms
+           << "ms  " << timings[i].name << "()\n";
+
+   double msWall = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+   cout << timings.size() << " tests took " << msTests << "ms, "
+        << msWall << "ms of wall time\n";
+
+   return UnitTest::numFailures();
 }
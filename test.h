@@ -9,4 +9,6 @@
 
 #pragma once
 
-void testRunner();
+// returns the number of tests that failed. The test classes run side
+// by side on numThreads threads, zero means one per hardware thread
+int testRunner(int numThreads = 0);
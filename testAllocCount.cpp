@@ -0,0 +1,153 @@
+/***********************************************************************
+ * Source File:
+ *    TEST ALLOC COUNT
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the allocation counters. The test runner
+ *    is built with ALLOC_COUNT; without it every count stays zero.
+ ************************************************************************/
+
+#include "testAllocCount.h"
+#include "allocCount.h"
+#include <cassert>
+
+// the compiler may leave out a new and delete pair it can see
+// all of, so the pointers escape through here
+static void * volatile pEscape;
+
+/*************************************
+ * ENABLED : build
+ * Input:  nothing
+ * Output: true exactly when built with ALLOC_COUNT
+ **************************************/
+void TestAllocCount::enabled_build()
+{
+#ifdef ALLOC_COUNT
+   assertUnit(allocCountEnabled() == true);
+#else
+   assertUnit(allocCountEnabled() == false);
+#endif
+}
+
+/*************************************
+ * STATS : subtract
+ * Input:  (5, 3, 100) - (2, 1, 40)
+ * Output: (3, 2, 60)
+ **************************************/
+void TestAllocCount::stats_subtract()
+{
+   // SETUP
+   AllocStats after  = { 5, 3, 100 };
+   AllocStats before = { 2, 1, 40 };
+
+   // EXERCISE
+   AllocStats diff = after - before;
+
+   // VERIFY
+   assertUnit(diff.numNew == 3);
+   assertUnit(diff.numDelete == 2);
+   assertUnit(diff.numBytes == 60);
+}
+
+/*************************************
+ * STATS : new
+ * Input:  new an int, then delete it
+ * Output: one new of at least sizeof(int), then one delete
+ **************************************/
+void TestAllocCount::stats_new()
+{
+   // SETUP
+   AllocStats before = allocStats();
+
+   // EXERCISE
+   int * p = new int(7);
+   pEscape = p;
+   AllocStats afterNew = allocStats() - before;
+   delete p;
+   AllocStats afterDelete = allocStats() - before;
+
+   // VERIFY
+   if (allocCountEnabled())
+   {
+      assertUnit(afterNew.numNew == 1);
+      assertUnit(afterNew.numDelete == 0);
+      assertUnit(afterNew.numBytes >= (long)sizeof(int));
+      assertUnit(afterDelete.numNew == 1);
+      assertUnit(afterDelete.numDelete == 1);
+   }
+   else
+   {
+      assertUnit(afterNew.numNew == 0);
+      assertUnit(afterDelete.numDelete == 0);
+   }
+}
+
+/*************************************
+ * STATS : new array
+ * Input:  new char[100], then delete it
+ * Output: one new of at least 100 bytes, then one delete
+ **************************************/
+void TestAllocCount::stats_newArray()
+{
+   // SETUP
+   AllocStats before = allocStats();
+
+   // EXERCISE
+   char * p = new char[100];
+   pEscape = p;
+   AllocStats afterNew = allocStats() - before;
+   delete [] p;
+   AllocStats afterDelete = allocStats() - before;
+
+   // VERIFY
+   if (allocCountEnabled())
+   {
+      assertUnit(afterNew.numNew == 1);
+      assertUnit(afterNew.numBytes >= 100);
+      assertUnit(afterDelete.numDelete == 1);
+   }
+   else
+      assertUnit(afterNew.numBytes == 0);
+}
+
+/*************************************
+ * COUNTED : construct, copy, delete
+ * Input:  make a widget, copy it, let both go
+ * Output: one construct, one copy, two deletes, none live
+ **************************************/
+namespace
+{
+   struct Widget : public Counted<Widget>
+   {
+      int value = 0;
+   };
+}
+void TestAllocCount::counted_constructCopyDelete()
+{
+   // SETUP
+   Counted<Widget>::counts().reset();
+
+   // EXERCISE
+   {
+      Widget widget;
+      Widget copy(widget);
+      assertUnit(Counted<Widget>::counts().getLive() ==
+                 (allocCountEnabled() ? 2 : 0));
+   }
+
+   // VERIFY
+   TypeCounts & counts = Counted<Widget>::counts();
+   if (allocCountEnabled())
+   {
+      assertUnit(counts.numConstruct == 1);
+      assertUnit(counts.numCopy == 1);
+      assertUnit(counts.numDelete == 2);
+   }
+   else
+      assertUnit(counts.numConstruct == 0);
+   assertUnit(counts.getLive() == 0);
+
+   // TEARDOWN
+   counts.reset();
+}
@@ -0,0 +1,37 @@
+/***********************************************************************
+ * Header File:
+ *    TEST ALLOC COUNT
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the allocation counters
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * ALLOC COUNT TEST
+ * Test the new and delete hooks and Counted<T>
+ ***************************************************/
+class TestAllocCount : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(enabled_build);
+      runTest(stats_subtract);
+      runTest(stats_new);
+      runTest(stats_newArray);
+      runTest(counted_constructCopyDelete);
+
+      report("AllocCount");
+   }
+private:
+   void enabled_build();
+   void stats_subtract();
+   void stats_new();
+   void stats_newArray();
+   void counted_constructCopyDelete();
+};
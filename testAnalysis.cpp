@@ -0,0 +1,168 @@
+/***********************************************************************
+ * Source File:
+ *    TEST ANALYSIS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the background analysis
+ ************************************************************************/
+
+#include "testAnalysis.h"
+#include "analysis.h"
+#include "board.h"
+#include <atomic>     // for ATOMIC notify count
+#include <chrono>     // for MILLISECONDS
+#include <thread>     // for SLEEP_FOR
+using namespace std;
+
+// how many times the analysis said it had something
+static atomic <int> numNotified(0);
+static void countNotify(void * p) { (*(atomic <int> *)p)++; }
+
+// results from the start position, until the last one or a few seconds
+static int pollUntilDone(Analysis & analysis, AnalysisResult results[], int max)
+{
+   int num = 0;
+   for (int i = 0; i < 5000; i++)
+   {
+      while (num < max && analysis.poll(results[num]))
+         if (results[num++].fDone)
+            return num;
+      this_thread::sleep_for(chrono::milliseconds(1));
+   }
+   return num;
+}
+
+// b1 or g1, where the white knights start
+static bool isWhiteKnightStart(const Position & pos)
+{
+   return pos.getRow() == 0 && (pos.getCol() == 1 || pos.getCol() == 6);
+}
+
+/*************************************
+ * START : depth limited
+ * Input:  the start position to depth 2
+ * Output: one result per depth then the last one,
+ *         a knight move, and a notify for each
+ **************************************/
+void TestAnalysis::start_depthLimited()
+{
+   // SETUP
+   Board board;
+   Analysis analysis;
+   analysis.setNotify(countNotify, &numNotified);
+   numNotified = 0;
+   AnalysisResult results[8];
+
+   // EXERCISE
+   analysis.start(board, 2);
+   int num = pollUntilDone(analysis, results, 8);
+   analysis.stop();
+
+   // VERIFY
+   assertUnit(num == 3);
+   assertUnit(results[0].depth == 1 && !results[0].fDone);
+   assertUnit(results[1].depth == 2 && !results[1].fDone);
+   assertUnit(results[2].depth == 2 &&  results[2].fDone);
+   assertUnit(results[2].nodes > 0);
+   assertUnit(isWhiteKnightStart(results[2].move.getSource()));
+   assertUnit(numNotified == 3);
+   assertUnit(analysis.isRunning() == false);
+}  // TEARDOWN
+
+/*************************************
+ * START : copies board
+ * Input:  start on the start position, then change
+ *         the board right away
+ * Output: the analysis is still of the start position
+ **************************************/
+void TestAnalysis::start_copiesBoard()
+{
+   // SETUP
+   Board board;
+   Analysis analysis;
+   AnalysisResult results[8];
+
+   // EXERCISE
+   analysis.start(board, 2);
+   board.setFen("8/8/8/8/3N4/8/8/n7 w - - 0 1");
+   int num = pollUntilDone(analysis, results, 8);
+
+   // VERIFY
+   assertUnit(num > 0);
+   if (num > 0)
+      assertUnit(isWhiteKnightStart(results[num - 1].move.getSource()));
+}  // TEARDOWN
+
+/*************************************
+ * STOP : infinite
+ * Input:  analysis with no depth limit
+ * Output: it runs until stop(), which returns
+ **************************************/
+void TestAnalysis::stop_infinite()
+{
+   // SETUP
+   Board board;
+   Analysis analysis;
+   analysis.start(board);
+   this_thread::sleep_for(chrono::milliseconds(20));
+   bool fRunning = analysis.isRunning();
+
+   // EXERCISE
+   analysis.stop();
+
+   // VERIFY
+   assertUnit(fRunning == true);
+   assertUnit(analysis.isRunning() == false);
+}  // TEARDOWN
+
+/*************************************
+ * STOP : discards results
+ * Input:  a finished analysis nobody polled
+ * Output: after stop() there is nothing to poll
+ **************************************/
+void TestAnalysis::stop_discardsResults()
+{
+   // SETUP
+   Board board;
+   Analysis analysis;
+   analysis.start(board, 1);
+   for (int i = 0; i < 5000 && analysis.isRunning(); i++)
+      this_thread::sleep_for(chrono::milliseconds(1));
+
+   // EXERCISE
+   analysis.stop();
+
+   // VERIFY
+   AnalysisResult result;
+   assertUnit(analysis.poll(result) == false);
+}  // TEARDOWN
+
+/*************************************
+ * POLL : done when full
+ * Input:  more results than the queue holds, then
+ *         the last one
+ * Output: the queue's worth, then the last one
+ **************************************/
+void TestAnalysis::poll_doneWhenFull()
+{
+   // SETUP
+   Analysis analysis;
+   for (int i = 0; i < 100; i++)
+      analysis.send(analysis.search, false /*fDone*/);
+
+   // EXERCISE
+   analysis.send(analysis.search, true /*fDone*/);
+
+   // VERIFY
+   AnalysisResult result;
+   int num = 0;
+   bool fDoneLast = false;
+   while (analysis.poll(result))
+   {
+      num++;
+      fDoneLast = result.fDone;
+   }
+   assertUnit(num == 64);   // 63 in the queue and the last one
+   assertUnit(fDoneLast == true);
+}  // TEARDOWN
@@ -0,0 +1,37 @@
+/***********************************************************************
+ * Header File:
+ *    TEST ANALYSIS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the background analysis
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * ANALYSIS TEST
+ * Test the Analysis class
+ ***************************************************/
+class TestAnalysis : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(start_depthLimited);
+      runTest(start_copiesBoard);
+      runTest(stop_infinite);
+      runTest(stop_discardsResults);
+      runTest(poll_doneWhenFull);
+
+      report("Analysis");
+   }
+private:
+   void start_depthLimited();
+   void start_copiesBoard();
+   void stop_infinite();
+   void stop_discardsResults();
+   void poll_doneWhenFull();
+};
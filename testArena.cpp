@@ -0,0 +1,224 @@
+/***********************************************************************
+ * Source File:
+ *    TEST ARENA
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the arena and the pool
+ ************************************************************************/
+
+#include "testArena.h"
+#include "arena.h"
+#include "board.h"
+#include "pieceSpace.h"
+#include "pieceKnight.h"
+#include <vector>     // for VECTOR with a pool
+#include <cstdint>    // for UINTPTR_T
+#include <cstddef>    // for MAX_ALIGN_T
+using namespace std;
+
+/*************************************
+ * ALLOCATE : aligned
+ * Input:  allocations of 1, 3, and 24 bytes
+ * Output: each aligned, one after another in one block
+ **************************************/
+void TestArena::allocate_aligned()
+{
+   // SETUP
+   Arena arena(1024);
+
+   // EXERCISE
+   char * p1 = (char *)arena.allocate(1);
+   char * p2 = (char *)arena.allocate(3);
+   char * p3 = (char *)arena.allocate(24);
+
+   // VERIFY
+   const size_t align = alignof(max_align_t);
+   assertUnit((uintptr_t)p1 % align == 0);
+   assertUnit((uintptr_t)p2 % align == 0);
+   assertUnit((uintptr_t)p3 % align == 0);
+   assertUnit(p2 == p1 + align);
+   assertUnit(p3 == p2 + align);
+   assertUnit(arena.getBlocks() == 1);
+   assertUnit(arena.getAllocations() == 3);
+}
+
+/*************************************
+ * ALLOCATE : new block
+ * Input:  three 48-byte allocations in 128-byte blocks
+ * Output: the third does not fit and starts a second block
+ **************************************/
+void TestArena::allocate_newBlock()
+{
+   // SETUP
+   Arena arena(128);
+
+   // EXERCISE
+   arena.allocate(48);
+   arena.allocate(48);
+   size_t blocksBefore = arena.getBlocks();
+   void * p = arena.allocate(48);
+
+   // VERIFY
+   assertUnit(blocksBefore == 1);
+   assertUnit(arena.getBlocks() == 2);
+   assertUnit(p == arena.blocks[1]);
+}
+
+/*************************************
+ * RESET : reuses
+ * Input:  fill two blocks, reset, allocate again
+ * Output: the same memory, with no new blocks
+ **************************************/
+void TestArena::reset_reuses()
+{
+   // SETUP
+   Arena arena(128);
+   void * pFirst = arena.allocate(64);
+   arena.allocate(64);
+   arena.allocate(64);
+
+   // EXERCISE
+   arena.reset();
+   void * pAgain = arena.allocate(64);
+
+   // VERIFY
+   assertUnit(pAgain == pFirst);
+   assertUnit(arena.getBlocks() == 2);
+   assertUnit(arena.getAllocations() == 1);
+   assertUnit(arena.getBytesUsed() == 64);
+}
+
+/*************************************
+ * PIECE : arena and heap
+ * Input:  a knight in an arena, a space on the heap
+ * Output: both work and both can be deleted
+ **************************************/
+void TestArena::piece_arenaAndHeap()
+{
+   // SETUP
+   Arena arena;
+
+   // EXERCISE
+   Piece * pKnight = new (arena) Knight(2, 3, false /*isWhite*/);
+   Piece * pSpace  = new Space(4, 5);
+
+   // VERIFY
+   assertUnit(pKnight->getType() == KNIGHT);
+   assertUnit(pKnight->getPosition() == Position(2, 3));
+   assertUnit(pKnight->isWhite() == false);
+   assertUnit(pSpace->getType() == SPACE);
+   assertUnit(arena.getAllocations() == 1);
+   assertUnit((char *)pKnight > arena.blocks[0]);
+
+   // TEARDOWN
+   delete pKnight;
+   delete pSpace;
+}
+
+/*************************************
+ * BOARD : reset reuses
+ * Input:  a board, reset twice
+ * Output: the arena holds the same 64 pieces, and a spare
+ *         space for each of the four knights, in one block
+ **************************************/
+void TestArena::board_resetReuses()
+{
+   // SETUP
+   Board board;
+   size_t bytes = board.getArena().getBytesUsed();
+
+   // EXERCISE
+   board.reset();
+   board.reset();
+
+   // VERIFY
+   assertUnit(board.getArena().getAllocations() == 64 + 4);
+   assertUnit(board.getArena().getBytesUsed() == bytes);
+   assertUnit(board.getArena().getBlocks() == 1);
+}
+
+/*************************************
+ * POOL : reuses slot
+ * Input:  allocate two, free the first, allocate
+ * Output: the freed slot comes back
+ **************************************/
+void TestArena::pool_reusesSlot()
+{
+   // SETUP
+   Pool pool(40, 4);
+   void * p1 = pool.allocate();
+   void * p2 = pool.allocate();
+
+   // EXERCISE
+   pool.deallocate(p1);
+   void * p3 = pool.allocate();
+
+   // VERIFY
+   assertUnit(p3 == p1);
+   assertUnit(p2 != p1);
+   assertUnit(pool.getInUse() == 2);
+   assertUnit(pool.getPeak() == 2);
+   assertUnit(pool.getAllocations() == 3);
+   assertUnit(pool.getBlocks() == 1);
+
+   // TEARDOWN
+   pool.deallocate(p2);
+   pool.deallocate(p3);
+}
+
+/*************************************
+ * POOL : new block
+ * Input:  five slots from blocks of four
+ * Output: two blocks, all five in use
+ **************************************/
+void TestArena::pool_newBlock()
+{
+   // SETUP
+   Pool pool(8, 4);
+   void * slots[5];
+
+   // EXERCISE
+   for (int i = 0; i < 5; i++)
+      slots[i] = pool.allocate();
+
+   // VERIFY
+   assertUnit(pool.getBlocks() == 2);
+   assertUnit(pool.getInUse() == 5);
+   assertUnit(pool.getSizeSlot() >= 8);
+
+   // TEARDOWN
+   for (int i = 0; i < 5; i++)
+      pool.deallocate(slots[i]);
+   assertUnit(pool.getInUse() == 0);
+}
+
+/*************************************
+ * POOL ALLOCATOR : vector
+ * Input:  a vector reserving what fits in a slot, then
+ *         one growing past it
+ * Output: the first uses the pool, the second the heap
+ **************************************/
+void TestArena::poolAllocator_vector()
+{
+   // SETUP
+   Pool pool(16 * sizeof(int), 2);
+
+   // EXERCISE
+   {
+      vector <int, PoolAllocator <int>> small(PoolAllocator <int> {pool});
+      small.reserve(16);
+      for (int i = 0; i < 16; i++)
+         small.push_back(i);
+      assertUnit(pool.getInUse() == 1);
+
+      vector <int, PoolAllocator <int>> big(PoolAllocator <int> {pool});
+      big.reserve(17);
+      assertUnit(pool.getInUse() == 1);
+      assertUnit(small[15] == 15);
+   }
+
+   // VERIFY
+   assertUnit(pool.getInUse() == 0);
+   assertUnit(pool.getAllocations() == 1);
+}
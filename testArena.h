@@ -0,0 +1,46 @@
+/***********************************************************************
+ * Header File:
+ *    TEST ARENA
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the arena and the pool
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * ARENA TEST
+ * Test the Arena, Pool, and PoolAllocator classes
+ ***************************************************/
+class TestArena : public UnitTest
+{
+public:
+   void run()
+   {
+      // arena
+      runTest(allocate_aligned);
+      runTest(allocate_newBlock);
+      runTest(reset_reuses);
+      runTest(piece_arenaAndHeap);
+      runTest(board_resetReuses);
+
+      // pool
+      runTest(pool_reusesSlot);
+      runTest(pool_newBlock);
+      runTest(poolAllocator_vector);
+
+      report("Arena");
+   }
+private:
+   void allocate_aligned();
+   void allocate_newBlock();
+   void reset_reuses();
+   void piece_arenaAndHeap();
+   void board_resetReuses();
+   void pool_reusesSlot();
+   void pool_newBlock();
+   void poolAllocator_vector();
+};
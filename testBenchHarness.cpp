@@ -0,0 +1,151 @@
+/***********************************************************************
+ * Source File:
+ *    TEST BENCH HARNESS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the benchmark harness
+ ************************************************************************/
+
+#include "testBenchHarness.h"
+#include "benchHarness.h"
+#include <sstream>    // for OSTRINGSTREAM
+#include <cassert>
+using namespace std;
+
+/*************************************
+ * PERCENTILE : ends
+ * Input:  {1, 2, 3, 4, 5}, 0th and 100th
+ * Output: the smallest and the largest
+ **************************************/
+void TestBenchHarness::percentile_ends()
+{
+   // SETUP
+   vector <double> sorted = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+
+   // EXERCISE
+   double low  = BenchHarness::percentile(sorted, 0.0);
+   double high = BenchHarness::percentile(sorted, 100.0);
+
+   // VERIFY
+   assertEquals(low, 1.0);
+   assertEquals(high, 5.0);
+}
+
+/*************************************
+ * PERCENTILE : median
+ * Input:  {1, 2, 3, 4, 50}, 50th
+ * Output: 3, not thrown off by the outlier
+ **************************************/
+void TestBenchHarness::percentile_median()
+{
+   // SETUP
+   vector <double> sorted = { 1.0, 2.0, 3.0, 4.0, 50.0 };
+
+   // EXERCISE
+   double median = BenchHarness::percentile(sorted, 50.0);
+
+   // VERIFY
+   assertEquals(median, 3.0);
+}
+
+/*************************************
+ * RUN : warmup and repetitions
+ * Input:  2 warmups, 5 repetitions, 10 ops each
+ * Output: called 7 times with 10 ops, one result of 5 reps
+ **************************************/
+void TestBenchHarness::run_warmupAndReps()
+{
+   // SETUP
+   BenchHarness harness(2, 5);
+   int numCalls = 0;
+   long numOps = 0;
+
+   // EXERCISE
+   harness.run("count", 10, [&](long ops) { numCalls++; numOps += ops; });
+
+   // VERIFY
+   assertUnit(numCalls == 7);
+   assertUnit(numOps == 70);
+   assertUnit(harness.getResults().size() == 1);
+   assertUnit(harness.getResults()[0].reps == 5);
+   assertUnit(harness.getResults()[0].ops == 10);
+   assertUnit(harness.getResults()[0].name == "count");
+}
+
+/*************************************
+ * RUN : ordered
+ * Input:  a small loop
+ * Output: min <= p10 <= median <= p90 <= max
+ **************************************/
+void TestBenchHarness::run_ordered()
+{
+   // SETUP
+   BenchHarness harness(1, 9);
+
+   // EXERCISE
+   const BenchResult & result = harness.run("loop", 100, [](long ops)
+   {
+      long sum = 0;
+      for (long i = 0; i < ops; i++)
+         sum += i;
+      doNotOptimize(sum);
+   });
+
+   // VERIFY
+   assertUnit(result.nsMin <= result.nsP10);
+   assertUnit(result.nsP10 <= result.nsMedian);
+   assertUnit(result.nsMedian <= result.nsP90);
+   assertUnit(result.nsP90 <= result.nsMax);
+   assertUnit(result.nsMin >= 0.0);
+}
+
+/*************************************
+ * WRITE JSON : names
+ * Input:  two benchmarks
+ * Output: both named, separated by a comma, no trailing comma
+ **************************************/
+void TestBenchHarness::writeJson_names()
+{
+   // SETUP
+   BenchHarness harness(0, 1);
+   harness.run("first", 1, [](long ops) {});
+   harness.run("second", 1, [](long ops) {});
+   ostringstream out;
+
+   // EXERCISE
+   harness.writeJson(out);
+
+   // VERIFY
+   string json = out.str();
+   assertUnit(json.find("\"cpu\": -1") != string::npos);
+   assertUnit(json.find("\"name\": \"first\"") != string::npos);
+   assertUnit(json.find("\"name\": \"second\"") != string::npos);
+   assertUnit(json.find("},\n    { \"name\": \"second\"") != string::npos);
+   assertUnit(json.find("},\n  ]") == string::npos);
+}
+
+/*************************************
+ * WRITE JSON : counters
+ * Input:  one benchmark and two counters
+ * Output: both counters with their values, after the results
+ **************************************/
+void TestBenchHarness::writeJson_counters()
+{
+   // SETUP
+   BenchHarness harness(0, 1);
+   harness.run("timed", 1, [](long ops) {});
+   harness.count("alloc_per_node", 2.5);
+   harness.count("bytes_per_node", 40.0);
+   ostringstream out;
+
+   // EXERCISE
+   harness.writeJson(out);
+
+   // VERIFY
+   string json = out.str();
+   assertUnit(harness.getCounters().size() == 2);
+   assertUnit(json.find("\"counters\": [") > json.find("\"name\": \"timed\""));
+   assertUnit(json.find("{ \"name\": \"alloc_per_node\", \"value\": 2.500 },") != string::npos);
+   assertUnit(json.find("{ \"name\": \"bytes_per_node\", \"value\": 40.000 }\n") != string::npos);
+}
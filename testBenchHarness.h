@@ -0,0 +1,39 @@
+/***********************************************************************
+ * Header File:
+ *    TEST BENCH HARNESS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the benchmark harness
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * BENCH HARNESS TEST
+ * Test the BenchHarness class
+ ***************************************************/
+class TestBenchHarness : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(percentile_ends);
+      runTest(percentile_median);
+      runTest(run_warmupAndReps);
+      runTest(run_ordered);
+      runTest(writeJson_names);
+      runTest(writeJson_counters);
+
+      report("BenchHarness");
+   }
+private:
+   void percentile_ends();
+   void percentile_median();
+   void run_warmupAndReps();
+   void run_ordered();
+   void writeJson_names();
+   void writeJson_counters();
+};
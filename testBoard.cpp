@@ -12,6 +12,10 @@
 #include "position.h"
 #include "piece.h"
 #include "board.h"
+#include "pieceSpace.h"
+#include "pieceKnight.h"
+#include "pieceFlyweight.h"
+#include "evaluate.h"
 #include <cassert>
 
 
@@ -46,6 +50,7 @@ void TestBoard::move_knightMove()
    board.board[4][4] = new PieceSpy(4, 4, true  /*isWhite*/, KNIGHT);
    board.board[2][5] = new PieceSpy(2, 5, false /*isWhite*/, SPACE);
    board.board[4][4]->nMoves = 17;
+   board.rescore();
    PieceSpy::reset();
 
    // EXERCISE
@@ -96,6 +101,7 @@ void TestBoard::move_knightAttack()
    board.board[4][4] = new PieceSpy(4, 4, true  /*isWhite*/, KNIGHT);
    board.board[2][5] = new PieceSpy(2, 5, false /*isWhite*/, ROOK);
    board.board[4][4]->nMoves = 17;
+   board.rescore();
    PieceSpy::reset();
 
    // EXERCISE
@@ -117,3 +123,364 @@ void TestBoard::move_knightAttack()
    board.board[2][5] = board.board[4][4] = nullptr;
 }
 
+
+/********************************************************
+ *    e5c6r then undo
+ * +---a-b-c-d-e-f-g-h---+       +---a-b-c-d-e-f-g-h---+
+ * |                     |       |                     |
+ * 8                     8       8                     8
+ * 7                     7       7                     7
+ * 6       R             6       6       R             6
+ * 5          (n)        5       5           n         5
+ * 4                     4  -->  4                     4
+ * 3                     3       3                     3
+ * 2                     2       2                     2
+ * 1                     1       1                     1
+ * |                     |       |                     |
+ * +---a-b-c-d-e-f-g-h---+       +---a-b-c-d-e-f-g-h---+
+ ********************************************************/
+void TestBoard::undo_knightAttack()
+{  // SETUP
+   Move move;
+   move.source.set(4, 4);
+   move.dest.set(2, 5);
+   move.capture = ROOK;
+   move.promote = SPACE;
+   move.isWhite = true;
+   move.moveType = Move::MOVE;
+   Board board(nullptr, true /*noreset*/);
+   board.numMoves = 17;
+   board.board[4][4] = new PieceSpy(4, 4, true  /*isWhite*/, KNIGHT);
+   board.board[2][5] = new PieceSpy(2, 5, false /*isWhite*/, ROOK);
+   board.board[4][4]->nMoves = 17;
+   board.rescore();
+   int score = board.evaluate();
+   board.move(move);
+
+   // EXERCISE
+   board.undo();
+
+   // VERIFY
+   assertUnit(17 == board.numMoves);
+   assertUnit(KNIGHT == (board.board[4][4])->getType());
+   assertUnit(ROOK == (board.board[2][5])->getType());
+   assertUnit(board.board[4][4]->getPosition() == Position(4, 4));
+   assertUnit(board.board[2][5]->getPosition() == Position(2, 5));
+   assertUnit(17 == board.board[4][4]->nMoves);
+   assertUnit(score == board.evaluate());
+
+   // TEARDOWN
+   delete board.board[2][5];
+   delete board.board[4][4];
+   board.board[2][5] = board.board[4][4] = nullptr;
+}
+
+/********************************************************
+ *    e2e3 then undo
+ * The pawn key changes when a pawn moves and comes back
+ * when the move is taken back
+ ********************************************************/
+void TestBoard::undo_pawnKey()
+{  // SETUP
+   Board board(nullptr, true /*noreset*/);
+   board.board[4][1] = new PieceSpy(4, 1, true /*isWhite*/, PAWN);
+   board.board[4][2] = new Space(4, 2);
+   board.rescore();
+   uint64_t keyBefore = board.getPawnKey();
+   board.move(Move(Position(4, 1), Position(4, 2)));
+   uint64_t keyMoved = board.getPawnKey();
+
+   // EXERCISE
+   board.undo();
+
+   // VERIFY
+   assertUnit(keyBefore != 0);
+   assertUnit(keyMoved != keyBefore);
+   assertUnit(board.getPawnKey() == keyBefore);
+   assertUnit(PAWN == (board.board[4][1])->getType());
+
+   // TEARDOWN
+   delete board.board[4][1];
+   delete board.board[4][2];
+   board.board[4][1] = board.board[4][2] = nullptr;
+}
+
+/********************************************************
+ * EVALUATE : starting position
+ * The knights are placed symmetrically so it is even
+ ********************************************************/
+void TestBoard::evaluate_start()
+{  // SETUP
+   Board board;
+
+   // EXERCISE
+   int score = board.evaluate();
+
+   // VERIFY
+   assertUnit(score == 0);
+   assertUnit(board.phase == 4);
+}  // TEARDOWN
+
+/********************************************************
+ *    e5c6r
+ * Capturing the rook is the same as a full recompute and
+ * better for white than before
+ ********************************************************/
+void TestBoard::evaluate_knightAttack()
+{  // SETUP
+   Move move;
+   move.source.set(4, 4);
+   move.dest.set(2, 5);
+   move.capture = ROOK;
+   move.promote = SPACE;
+   move.isWhite = true;
+   move.moveType = Move::MOVE;
+   Board board(nullptr, true /*noreset*/);
+   board.board[4][4] = new Knight(4, 4, true /*isWhite*/);
+   board.board[2][5] = new PieceSpy(2, 5, false /*isWhite*/, ROOK);
+   board.rescore();
+   int scoreBefore = board.evaluate();
+
+   // EXERCISE
+   board.move(move);
+
+   // VERIFY
+   int mg, eg, phase;
+   board.scoreAll(mg, eg, phase);
+   assertUnit(mg == board.scoreMg);
+   assertUnit(eg == board.scoreEg);
+   assertUnit(phase == board.phase);
+   assertUnit(board.evaluate() > scoreBefore);
+   assertUnit(board.scoreMg == pieceSquareMg(KNIGHT, true, 2, 5));
+
+   // TEARDOWN
+   delete board.board[2][5];
+   delete board.board[4][4];
+   board.board[2][5] = board.board[4][4] = nullptr;
+}
+
+/********************************************************
+ * SQUARES : starting position
+ * One byte per square: knights on b1, g1, b8, g8
+ ********************************************************/
+void TestBoard::squares_start()
+{  // SETUP
+   Board board;
+
+   // EXERCISE
+   const uint8_t * squares = board.getSquares();
+
+   // VERIFY
+   assertUnit(squares[1]  == squareCode(KNIGHT, true));
+   assertUnit(squares[6]  == squareCode(KNIGHT, true));
+   assertUnit(squares[57] == squareCode(KNIGHT, false));
+   assertUnit(squares[62] == squareCode(KNIGHT, false));
+   assertUnit(squares[0]  == SPACE);
+   assertUnit(squares[28] == SPACE);
+   assertUnit(squareType(squares[57]) == KNIGHT);
+   assertUnit(squareWhite(squares[57]) == false);
+}  // TEARDOWN
+
+/********************************************************
+ *    b1c3n then undo
+ * The bytes follow the pieces there and back
+ ********************************************************/
+void TestBoard::squares_moveUndo()
+{  // SETUP
+   Board board;
+   board.setFen("8/8/8/8/8/2n5/8/1N6 w - - 0 1");
+   Move move(Position(1, 0), Position(2, 2), Move::MOVE, KNIGHT, SPACE, true);
+
+   // EXERCISE
+   board.move(move);
+   uint8_t b1 = board.getSquares()[1];
+   uint8_t c3 = board.getSquares()[18];
+   board.undo();
+
+   // VERIFY
+   assertUnit(b1 == SPACE);
+   assertUnit(c3 == squareCode(KNIGHT, true));
+   assertUnit(board.getSquares()[1]  == squareCode(KNIGHT, true));
+   assertUnit(board.getSquares()[18] == squareCode(KNIGHT, false));
+}  // TEARDOWN
+
+/********************************************************
+ * GET MOVES : flyweight
+ * Generating from the bytes gives the same moves as
+ * asking each piece
+ ********************************************************/
+void TestBoard::getMoves_flyweight()
+{  // SETUP
+   Board board;
+   board.setFen("8/8/8/3n4/8/2N5/8/1N4n1 w - - 0 1");
+   set <Move> movesPieces;
+   for (int r = 0; r < 8; r++)
+      for (int c = 0; c < 8; c++)
+         if (board.board[c][r]->getType() != SPACE && board.board[c][r]->isWhite())
+            board.board[c][r]->getMoves(movesPieces, board);
+
+   // EXERCISE
+   set <Move> moves;
+   board.getMoves(moves, true /*isWhite*/);
+
+   // VERIFY
+   assertUnit(moves.size() == movesPieces.size());
+   assertUnit(moves == movesPieces);
+}  // TEARDOWN
+
+/********************************************************
+ *    b1c3n, undo, b1c3n
+ * Each capture takes one of the spares set aside for
+ * the two knights, and the second one reuses the space
+ * the undo gave back
+ ********************************************************/
+void TestBoard::move_reusesSpace()
+{  // SETUP
+   Board board;
+   board.setFen("8/8/8/8/8/2n5/8/1N6 w - - 0 1");
+   size_t numSpares = board.spaces.size();
+   Move move(Position(1, 0), Position(2, 2), Move::MOVE, KNIGHT, SPACE, true);
+   board.move(move);
+   Piece * pSpace = board.board[1][0];
+   board.undo();
+
+   // EXERCISE
+   board.move(move);
+
+   // VERIFY
+   assertUnit(numSpares == 2);
+   assertUnit(board.spaces.size() == 1);
+   assertUnit(board.board[1][0] == pSpace);
+   assertUnit(board.board[1][0]->getPosition() == Position(1, 0));
+}  // TEARDOWN
+
+
+/*************************************
+ * DIRTY : move and undo
+ * Input:  a drawn board, g1f3 then undo
+ * Output: g1 and f3 are dirty each time, and only
+ *         the frame after the move draws them
+ **************************************/
+void TestBoard::dirty_moveUndo()
+{  // SETUP
+   Board board;
+   bool fAll;
+   Position posNone(-1);
+   board.takeDirty(posNone, posNone, fAll);
+   const uint64_t g1f3 = (1ull << 6) | (1ull << 21);
+
+   // EXERCISE
+   board.move(Move(Position(6, 0), Position(5, 2)));
+   uint64_t dirtyMove = board.getDirty();
+   uint64_t drawMove = board.takeDirty(posNone, posNone, fAll);
+   uint64_t drawAfter = board.takeDirty(posNone, posNone, fAll);
+   board.undo();
+
+   // VERIFY
+   assertUnit(dirtyMove == g1f3);
+   assertUnit(drawMove == g1f3);
+   assertUnit(drawAfter == 0);
+   assertUnit(fAll == false);
+   assertUnit(board.getDirty() == g1f3);
+}  // TEARDOWN
+
+/*************************************
+ * DIRTY : highlights
+ * Input:  hover on c3, then move it to d4 and select d4
+ * Output: the old and new squares are drawn
+ **************************************/
+void TestBoard::dirty_highlights()
+{  // SETUP
+   Board board;
+   bool fAll;
+   Position posNone(-1);
+   Position c3(2, 2);
+   Position d4(3, 3);
+   board.takeDirty(posNone, posNone, fAll);
+   board.takeDirty(c3, posNone, fAll);
+
+   // EXERCISE
+   uint64_t drawHover = board.takeDirty(d4, posNone, fAll);
+   uint64_t drawSelect = board.takeDirty(d4, d4, fAll);
+
+   // VERIFY
+   assertUnit(drawHover == ((1ull << 18) | (1ull << 27)));
+   assertUnit(drawSelect == (1ull << 27));
+   assertUnit(fAll == false);
+}  // TEARDOWN
+
+/*************************************
+ * DIRTY : set FEN
+ * Input:  a drawn board, then a new position
+ * Output: the next frame draws everything, and the
+ *         one after nothing
+ **************************************/
+void TestBoard::dirty_setFen()
+{  // SETUP
+   Board board;
+   bool fAll;
+   Position posNone(-1);
+   board.takeDirty(posNone, posNone, fAll);
+   bool fAllStart = fAll;
+   board.takeDirty(posNone, posNone, fAll);
+   bool fAllDrawn = fAll;
+
+   // EXERCISE
+   board.setFen("8/8/8/8/3N4/8/8/8 w - - 0 1");
+   uint64_t drawFirst = board.takeDirty(posNone, posNone, fAll);
+   bool fAllFirst = fAll;
+   uint64_t drawSecond = board.takeDirty(posNone, posNone, fAll);
+
+   // VERIFY
+   assertUnit(fAllStart == true);
+   assertUnit(fAllDrawn == false);
+   assertUnit(drawFirst == ~0ull);
+   assertUnit(fAllFirst == true);
+   assertUnit(drawSecond == 0);
+   assertUnit(fAll == false);
+}  // TEARDOWN
+
+/*************************************
+ * DIRTY : possible
+ * Input:  a drawn board, then b1 and c3 as possible,
+ *         then only c3
+ * Output: the squares that changed are drawn again
+ **************************************/
+void TestBoard::dirty_possible()
+{  // SETUP
+   Board board;
+   bool fAll;
+   Position posNone(-1);
+   board.takeDirty(posNone, posNone, fAll);
+
+   // EXERCISE
+   board.setPossible((1ull << 1) | (1ull << 18));
+   uint64_t drawBoth = board.takeDirty(posNone, posNone, fAll);
+   board.setPossible(1ull << 18);
+   uint64_t drawOne = board.takeDirty(posNone, posNone, fAll);
+
+   // VERIFY
+   assertUnit(drawBoth == ((1ull << 1) | (1ull << 18)));
+   assertUnit(drawOne == (1ull << 1));
+   assertUnit(board.possible == (1ull << 18));
+   assertUnit(fAll == false);
+}  // TEARDOWN
+
+/*************************************
+ * GET FEN : round trip
+ * Input:  a position with black to move on move 7
+ * Output: the same text back, and the start position
+ **************************************/
+void TestBoard::getFen_roundTrip()
+{  // SETUP
+   Board board;
+   string fenStart = board.getFen();
+   string fen = "8/8/8/4N3/8/2n5/8/1N6 b - - 0 7";
+
+   // EXERCISE
+   board.setFen(fen);
+
+   // VERIFY
+   assertUnit(fenStart == "1n4n1/8/8/8/8/8/8/1N4N1 w - - 0 1");
+   assertUnit(board.getFen() == fen);
+}  // TEARDOWN
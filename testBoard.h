@@ -23,13 +23,50 @@ public:
    void run()
    {
       // move
-      move_knightMove();
-      move_knightAttack();
+      runTest(move_knightMove);
+      runTest(move_knightAttack);
+
+      // undo
+      runTest(undo_knightAttack);
+      runTest(undo_pawnKey);
+
+      // evaluate
+      runTest(evaluate_start);
+      runTest(evaluate_knightAttack);
+
+      // squares
+      runTest(squares_start);
+      runTest(squares_moveUndo);
+      runTest(getMoves_flyweight);
+      runTest(move_reusesSpace);
+
+      // dirty squares
+      runTest(dirty_moveUndo);
+      runTest(dirty_highlights);
+      runTest(dirty_setFen);
+      runTest(dirty_possible);
+
+      // FEN
+      runTest(getFen_roundTrip);
+
       report("Board");
    }
 private:
    
    void move_knightMove();
    void move_knightAttack();
+   void undo_knightAttack();
+   void undo_pawnKey();
+   void evaluate_start();
+   void evaluate_knightAttack();
+   void squares_start();
+   void squares_moveUndo();
+   void getMoves_flyweight();
+   void move_reusesSpace();
+   void dirty_moveUndo();
+   void dirty_highlights();
+   void dirty_setFen();
+   void dirty_possible();
+   void getFen_roundTrip();
 };
 
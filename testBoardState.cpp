@@ -0,0 +1,212 @@
+/***********************************************************************
+ * Source File:
+ *    TEST BOARD STATE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for BoardState
+ ************************************************************************/
+
+#include "testBoardState.h"
+#include "boardState.h"
+#include "board.h"
+#include "zobrist.h"
+#include <set>        // for SET of moves
+using namespace std;
+
+/*************************************
+ * SET : start
+ * Input:  the starting board
+ * Output: the same squares, white to move, move 1
+ **************************************/
+void TestBoardState::set_start()
+{
+   // SETUP
+   Board board;
+   BoardState state;
+
+   // EXERCISE
+   state.set(board);
+
+   // VERIFY
+   for (int square = 0; square < 64; square++)
+      assertUnit(state.getSquare(square) == board.getSquares()[square]);
+   assertUnit(state.whiteTurn());
+   assertUnit(state.fullMove == 1);
+   assertUnit(state.halfMove == 0);
+   assertUnit(state.castling == 0);
+   assertUnit(state.enPassant == -1);
+   assertUnit(state.getOccupied(true)  == ((1ull << 1) | (1ull << 6)));
+   assertUnit(state.getOccupied(false) == ((1ull << 57) | (1ull << 62)));
+   assertUnit(state.hash == state.computeHash());
+}
+
+/*************************************
+ * MOVE : quiet
+ * Input:  the start, then g1f3 and b8c6
+ * Output: the knights move, the counters count,
+ *         and the hash follows along
+ **************************************/
+void TestBoardState::move_quiet()
+{
+   // SETUP
+   Board board;
+   BoardState state;
+   state.set(board);
+   uint64_t hashStart = state.hash;
+
+   // EXERCISE
+   state.move(Move(Position(6, 0), Position(5, 2)));         // g1f3
+   bool isWhiteAfterOne = state.whiteTurn();
+   state.move(Move(Position(1, 7), Position(2, 5)));         // b8c6
+
+   // VERIFY
+   assertUnit(isWhiteAfterOne == false);
+   assertUnit(state.whiteTurn());
+   assertUnit(state.getSquare(6)  == SPACE);                 // g1
+   assertUnit(state.getSquare(21) == squareCode(KNIGHT, true));   // f3
+   assertUnit(state.getSquare(57) == SPACE);                 // b8
+   assertUnit(state.getSquare(42) == squareCode(KNIGHT, false));  // c6
+   assertUnit(state.fullMove == 2);
+   assertUnit(state.halfMove == 2);
+   assertUnit(state.hash == state.computeHash());
+   assertUnit(state.hash != hashStart);
+}
+
+/*************************************
+ * MOVE : capture
+ * Input:  white knight d4 takes the black knight on e6
+ * Output: one black piece fewer, the clock starts over
+ **************************************/
+void TestBoardState::move_capture()
+{
+   // SETUP
+   Board board;
+   board.setFen("8/8/4n3/8/3N4/8/8/8 w - - 0 1");
+   BoardState state;
+   state.set(board);
+   state.halfMove = 7;
+
+   // EXERCISE
+   state.move(Move(Position(3, 3), Position(4, 5), Move::MOVE, KNIGHT));   // d4e6
+
+   // VERIFY
+   assertUnit(state.getOccupied(false) == 0);
+   assertUnit(state.getOccupied(true) == (1ull << 44));
+   assertUnit(state.halfMove == 0);
+   assertUnit(state.hash == state.computeHash());
+}
+
+/*************************************
+ * MOVE : castling
+ * Input:  all the rights, a white knight leaves a1 and
+ *         a black knight lands on h1
+ * Output: white loses both, black keeps its own
+ **************************************/
+void TestBoardState::move_castling()
+{
+   // SETUP
+   Board board;
+   board.setFen("8/8/8/8/8/6n1/8/N7 w - - 0 1");
+   BoardState state;
+   state.set(board);
+   state.castling = CASTLE_WHITE_KING | CASTLE_WHITE_QUEEN |
+                    CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN;
+
+   // EXERCISE
+   state.move(Move(Position(0, 0), Position(1, 2)));         // a1b3
+   uint8_t afterWhite = state.castling;
+   state.move(Move(Position(6, 2), Position(7, 0)));         // g3h1
+
+   // VERIFY
+   assertUnit(afterWhite == (CASTLE_WHITE_KING | CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN));
+   assertUnit(state.castling == (CASTLE_BLACK_KING | CASTLE_BLACK_QUEEN));
+}
+
+/*************************************
+ * MOVE : copy untouched
+ * Input:  a copy of the start, moved
+ * Output: the original is what it was
+ **************************************/
+void TestBoardState::move_copyUntouched()
+{
+   // SETUP
+   Board board;
+   BoardState state;
+   state.set(board);
+
+   // EXERCISE
+   BoardState child = state;
+   child.move(Move(Position(1, 0), Position(2, 2)));         // b1c3
+
+   // VERIFY
+   assertUnit(state.getSquare(1)  == squareCode(KNIGHT, true));   // b1
+   assertUnit(state.getSquare(18) == SPACE);                 // c3
+   assertUnit(state.whiteTurn());
+   assertUnit(state.hash == state.computeHash());
+   assertUnit(child.getSquare(18) == squareCode(KNIGHT, true));
+   assertUnit(child.hash != state.hash);
+}
+
+/*************************************
+ * GET MOVES : matches board
+ * Input:  a position with captures both ways
+ * Output: the same moves the board makes
+ **************************************/
+void TestBoardState::getMoves_matchesBoard()
+{
+   // SETUP
+   Board board;
+   board.setFen("8/8/2n1n3/8/3N4/8/1N3n2/8 b - - 0 1");
+   BoardState state;
+   state.set(board);
+   set <Move> movesBoard;
+   board.getMoves(movesBoard, false /*isWhite*/);
+
+   // EXERCISE
+   MoveList moves;
+   state.getMoves(moves);
+
+   // VERIFY
+   set <Move> movesState(moves.begin(), moves.end());
+   assertUnit(moves.size() == movesBoard.size());
+   assertUnit(movesState == movesBoard);
+   bool allBlack = true;
+   bool captured = false;
+   for (const Move & move : moves)
+   {
+      allBlack = allBlack && !move.getIsWhite();
+      captured = captured || move.getCapture() == KNIGHT;
+   }
+   assertUnit(allBlack);
+   assertUnit(captured);
+}
+
+/*************************************
+ * PERFT : matches board
+ * Input:  a position with captures, three plies
+ * Output: copy-make and make/unmake count the same,
+ *         and the board is left as it was
+ **************************************/
+void TestBoardState::perft_matchesBoard()
+{
+   // SETUP
+   Board board;
+   board.setFen("8/8/2n1n3/8/3N4/8/1N3n2/8 w - - 0 1");
+   BoardState state;
+   state.set(board);
+
+   // EXERCISE
+   long nodesCopy = perftCopyMake(state, 3);
+   long nodesMake = perftMakeUnmake(board, 3);
+
+   // VERIFY
+   assertUnit(nodesCopy == nodesMake);
+   assertUnit(nodesCopy > 1000);
+   assertUnit(perftCopyMake(state, 1) == 12);
+   assertUnit(perftCopyMake(state, 0) == 1);
+   BoardState after;
+   after.set(board);
+   assertUnit(after.hash == state.hash);
+   assertUnit(board.getCurrentMove() == 0);
+}
@@ -0,0 +1,48 @@
+/***********************************************************************
+ * Header File:
+ *    TEST BOARD STATE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for BoardState
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * BOARD STATE TEST
+ * Test the BoardState struct
+ ***************************************************/
+class TestBoardState : public UnitTest
+{
+public:
+   void run()
+   {
+      // set
+      runTest(set_start);
+
+      // move
+      runTest(move_quiet);
+      runTest(move_capture);
+      runTest(move_castling);
+      runTest(move_copyUntouched);
+
+      // getMoves
+      runTest(getMoves_matchesBoard);
+
+      // perft
+      runTest(perft_matchesBoard);
+
+      report("BoardState");
+   }
+private:
+   void set_start();
+   void move_quiet();
+   void move_capture();
+   void move_castling();
+   void move_copyUntouched();
+   void getMoves_matchesBoard();
+   void perft_matchesBoard();
+};
@@ -0,0 +1,441 @@
+/***********************************************************************
+ * Source File:
+ *    TEST BOOK
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the opening book
+ ************************************************************************/
+
+#include "testBook.h"
+#include "book.h"
+#include "board.h"
+#include <fstream>    // for OFSTREAM of a book by hand
+#include <sstream>    // for ISTRINGSTREAM of PGN
+#include <cstdio>     // for REMOVE
+using namespace std;
+
+// one entry, as Polyglot writes it
+static void writeEntry(ofstream & fout, uint64_t key, uint16_t move, uint16_t weight)
+{
+   for (int i = 7; i >= 0; i--)
+      fout.put(char(uint8_t(key >> (i * 8))));
+   fout.put(char(move >> 8));
+   fout.put(char(move & 0xFF));
+   fout.put(char(weight >> 8));
+   fout.put(char(weight & 0xFF));
+   for (int i = 0; i < 4; i++)
+      fout.put(0);
+}
+
+// the text of a move, like g1f3
+static string smith(const Move & move)
+{
+   return string() + char('a' + move.getSource().getCol()) + char('1' + move.getSource().getRow()) +
+                     char('a' + move.getDest().getCol())   + char('1' + move.getDest().getRow());
+}
+
+/*************************************
+ * KEY : layout
+ * Input:  the start: white knights on b1 and g1,
+ *         black on b8 and g8, white to move
+ * Output: the numbers for kinds 3 and 2 on those
+ *         squares, and the one for white to move
+ **************************************/
+void TestBook::key_layout()
+{
+   // SETUP
+   Board board;
+   const uint64_t * random = Book::random64();
+
+   // EXERCISE
+   uint64_t key = Book::key(board);
+
+   // VERIFY
+   assertUnit(key == (random[64 * 3 + 1] ^ random[64 * 3 + 6] ^
+                      random[64 * 2 + 57] ^ random[64 * 2 + 62] ^ random[780]));
+}
+
+/*************************************
+ * KEY : published
+ * Input:  an empty board each side to move, and the
+ *         knights where they start
+ * Output: the keys any Polyglot program gives them:
+ *         white to move alone is Random64[780]
+ **************************************/
+void TestBook::key_published()
+{
+   // SETUP
+   Board boardWhite(nullptr, true /*noreset*/);
+   Board boardBlack(nullptr, true /*noreset*/);
+   boardWhite.setFen("8/8/8/8/8/8/8/8 w - - 0 1");
+   boardBlack.setFen("8/8/8/8/8/8/8/8 b - - 0 1");
+   Board board;
+
+   // EXERCISE
+   uint64_t keyWhite = Book::key(boardWhite);
+   uint64_t keyBlack = Book::key(boardBlack);
+   uint64_t keyStart = Book::key(board);
+
+   // VERIFY
+   assertUnit(keyWhite == 0xF8D626AAAF278509ull);
+   assertUnit(keyBlack == 0);
+   assertUnit(keyStart == 0x36B4A5D77F1FD721ull);
+   assertUnit(Book::random64()[0]   == 0x9D39247E33776D41ull);   // black pawn a1
+   assertUnit(Book::random64()[768] == 0x31D71DCE64B2C310ull);   // white castles short
+}
+
+/*************************************
+ * KEY : turn
+ * Input:  the same knights with each side to move,
+ *         and after a move and back again
+ * Output: the side changes the key; the round trip
+ *         does not
+ **************************************/
+void TestBook::key_turn()
+{
+   // SETUP
+   Board boardWhite;
+   Board boardBlack(nullptr, true /*noreset*/);
+   boardWhite.setFen("8/8/4n3/8/3N4/8/8/8 w - - 0 1");
+   boardBlack.setFen("8/8/4n3/8/3N4/8/8/8 b - - 0 1");
+   Board board;
+   uint64_t keyStart = Book::key(board);
+
+   // EXERCISE
+   board.setFen("1n4n1/8/8/8/8/8/8/1N4N1 w - - 0 1");
+   Move g1f3;
+   Move g8f6;
+   Move f3g1;
+   Move f6g8;
+   bool fFound = findSan(board, "Nf3", g1f3);
+   board.move(g1f3);
+   fFound = findSan(board, "Nf6", g8f6) && fFound;
+   board.move(g8f6);
+   fFound = findSan(board, "Ng1", f3g1) && fFound;
+   board.move(f3g1);
+   fFound = findSan(board, "Ng8", f6g8) && fFound;
+   board.move(f6g8);
+
+   // VERIFY
+   assertUnit(Book::key(boardWhite) != Book::key(boardBlack));
+   assertUnit(Book::key(boardWhite) == (Book::key(boardBlack) ^ Book::random64()[780]));
+   assertUnit(fFound);
+   assertUnit(Book::key(board) == keyStart);
+}
+
+/*************************************
+ * ENCODE : knight
+ * Input:  g1f3 and b8c6
+ * Output: to, then from, three bits a file or row
+ **************************************/
+void TestBook::encode_knight()
+{
+   // SETUP
+   Move g1f3(Position(6, 0), Position(5, 2));
+   Move b8c6(Position(1, 7), Position(2, 5));
+
+   // EXERCISE
+   uint16_t codeWhite = Book::encode(g1f3);
+   uint16_t codeBlack = Book::encode(b8c6);
+
+   // VERIFY
+   assertUnit(codeWhite == (5 | (2 << 3) | (6 << 6) | (0 << 9)));
+   assertUnit(codeBlack == (2 | (5 << 3) | (1 << 6) | (7 << 9)));
+}
+
+/*************************************
+ * FIND SAN : knights
+ * Input:  knights on b1, f1, and f3 that can all
+ *         reach d2, and a capture on e5 with a check mark
+ * Output: each found once it is told apart
+ **************************************/
+void TestBook::findSan_knights()
+{
+   // SETUP
+   Board board(nullptr, true /*noreset*/);
+   board.setFen("8/8/8/4n3/8/5N2/8/1N3N2 w - - 0 1");
+   Move moveB;
+   Move moveF;
+   Move moveCapture;
+   Move moveRank;
+
+   // EXERCISE
+   bool fB = findSan(board, "Nbd2", moveB);
+   bool fF = findSan(board, "Nf1d2!?", moveF);
+   bool fCapture = findSan(board, "Nxe5+", moveCapture);
+   bool fRank = findSan(board, "N3d2", moveRank);
+
+   // VERIFY
+   assertUnit(fB);
+   assertUnit(smith(moveB) == "b1d2");
+   assertUnit(fF);
+   assertUnit(smith(moveF) == "f1d2");
+   assertUnit(fCapture);
+   assertUnit(smith(moveCapture) == "f3e5");
+   assertUnit(moveCapture.getCapture() == KNIGHT);
+   assertUnit(fRank);
+   assertUnit(smith(moveRank) == "f3d2");
+}
+
+/*************************************
+ * FIND SAN : refused
+ * Input:  a move two knights could make, a pawn
+ *         move, castling, and a square off the board
+ * Output: none found
+ **************************************/
+void TestBook::findSan_refused()
+{
+   // SETUP
+   Board board(nullptr, true /*noreset*/);
+   board.setFen("8/8/8/8/8/8/8/1N3N2 w - - 0 1");
+   Move move;
+
+   // EXERCISE
+   bool fAmbiguous = findSan(board, "Nd2", move);
+   bool fPawn = findSan(board, "e4", move);
+   bool fCastle = findSan(board, "O-O", move);
+   bool fOff = findSan(board, "Ni9", move);
+   bool fNowhere = findSan(board, "Nd5", move);
+
+   // VERIFY
+   assertUnit(!fAmbiguous);
+   assertUnit(!fPawn);
+   assertUnit(!fCastle);
+   assertUnit(!fOff);
+   assertUnit(!fNowhere);
+}
+
+/*************************************
+ * OPEN : missing
+ * Input:  no such file, then a file of 15 bytes
+ * Output: neither opens
+ **************************************/
+void TestBook::open_missing()
+{
+   // SETUP
+   const char * fileName = "testBook.bin";
+   {
+      ofstream fout(fileName, ios::binary);
+      fout << "not a book at all";
+   }
+   Book book;
+
+   // EXERCISE
+   bool fMissing = book.open("testBookMissing.bin");
+   bool fShort = book.open(fileName);
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(!fMissing);
+   assertUnit(!fShort);
+   assertUnit(!book.isOpen());
+   assertUnit(book.size() == 0);
+}
+
+/*************************************
+ * OPEN : empty
+ * Input:  a file with no entries
+ * Output: open, with nothing in it
+ **************************************/
+void TestBook::open_empty()
+{
+   // SETUP
+   const char * fileName = "testBook.bin";
+   {
+      ofstream fout(fileName, ios::binary);
+   }
+   Book book;
+   Board board;
+   vector <BookMove> moves;
+   Move move;
+
+   // EXERCISE
+   bool fOpen = book.open(fileName);
+   book.getMoves(board, moves);
+   bool fPicked = book.pick(board, move, 0);
+   book.close();
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(fOpen);
+   assertUnit(moves.empty());
+   assertUnit(!fPicked);
+   assertUnit(!book.isOpen());
+}
+
+/*************************************
+ * GET MOVES : collision
+ * Input:  entries on both sides of the start's key,
+ *         and for it g1f3, g1g3, and b1c3
+ * Output: the two legal moves, heaviest first, and
+ *         nothing from the neighbors
+ **************************************/
+void TestBook::getMoves_collision()
+{
+   // SETUP
+   const char * fileName = "testBook.bin";
+   Board board;
+   uint64_t key = Book::key(board);
+   Move g1f3(Position(6, 0), Position(5, 2));
+   Move g1g3(Position(6, 0), Position(6, 2));
+   Move b1c3(Position(1, 0), Position(2, 2));
+   {
+      ofstream fout(fileName, ios::binary);
+      writeEntry(fout, key - 1, Book::encode(b1c3), 100);
+      writeEntry(fout, key, Book::encode(g1f3), 5);
+      writeEntry(fout, key, Book::encode(g1g3), 9);      // not a knight move
+      writeEntry(fout, key, Book::encode(b1c3), 7);
+      writeEntry(fout, key + 1, Book::encode(g1f3), 100);
+   }
+   Book book;
+   vector <BookMove> moves;
+
+   // EXERCISE
+   bool fOpen = book.open(fileName);
+   book.getMoves(board, moves);
+   size_t size = book.size();
+   book.close();
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(fOpen);
+   assertUnit(size == 5);
+   assertUnit(moves.size() == 2);
+   assertUnit(smith(moves[0].move) == "b1c3");
+   assertUnit(moves[0].weight == 7);
+   assertUnit(smith(moves[1].move) == "g1f3");
+   assertUnit(moves[1].weight == 5);
+   assertUnit(board.getCurrentMove() == 0);
+}
+
+/*************************************
+ * PICK : weighted
+ * Input:  g1f3 weighing 3 and b1c3 weighing 1, and
+ *         random numbers across the range
+ * Output: g1f3 for the first three quarters, b1c3
+ *         for the last
+ **************************************/
+void TestBook::pick_weighted()
+{
+   // SETUP
+   const char * fileName = "testBook.bin";
+   Board board;
+   {
+      ofstream fout(fileName, ios::binary);
+      writeEntry(fout, Book::key(board), Book::encode(Move(Position(6, 0), Position(5, 2))), 3);
+      writeEntry(fout, Book::key(board), Book::encode(Move(Position(1, 0), Position(2, 2))), 1);
+   }
+   Book book;
+   book.open(fileName);
+   Move moveLow;
+   Move moveHigh;
+   Move moveQuarter;
+   Move moveLast;
+
+   // EXERCISE
+   bool fPicked = book.pick(board, moveLow, 0);
+   fPicked = book.pick(board, moveHigh, 0xBFFFFFFF) && fPicked;
+   fPicked = book.pick(board, moveQuarter, 0xC0000000) && fPicked;
+   fPicked = book.pick(board, moveLast, 0xFFFFFFFF) && fPicked;
+   book.close();
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(fPicked);
+   assertUnit(smith(moveLow) == "g1f3");
+   assertUnit(smith(moveHigh) == "g1f3");
+   assertUnit(smith(moveQuarter) == "b1c3");
+   assertUnit(smith(moveLast) == "b1c3");
+}
+
+/*************************************
+ * ADD PGN : round trip
+ * Input:  three games with tags, comments, a
+ *         variation, NAGs, and a move we cannot play
+ * Output: the weights add up by result for the side
+ *         that moved, and read back from the file
+ **************************************/
+void TestBook::addPgn_roundTrip()
+{
+   // SETUP
+   const char * fileName = "testBook.bin";
+   istringstream pgn(
+      "[Event \"one\"]\n"
+      "[Result \"1-0\"]\n"
+      "\n"
+      "1. Nf3 {the best by test} Nf6 (1... Nc6 2. Nc3) 2. Nc3 $1 Nc6 1-0\n"
+      "\n"
+      "[Event \"two\"]\n"
+      "[Result \"1/2-1/2\"]\n"
+      "\n"
+      "1.Nf3 Nc6 2.e4 Nf6 1/2-1/2\n"
+      "\n"
+      "[Event \"three\"]\n"
+      "[Result \"0-1\"]\n"
+      "\n"
+      "1. Nc3 ; the other knight\n"
+      "Nf6 0-1\n");
+   BookBuilder builder(2);
+   Book book;
+   Board board;
+   vector <BookMove> movesStart;
+   vector <BookMove> movesAfter;
+
+   // EXERCISE
+   int numGames = builder.addPgn(pgn);
+   bool fWritten = builder.write(fileName);
+   bool fOpen = book.open(fileName);
+   book.getMoves(board, movesStart);
+   Move g1f3;
+   findSan(board, "Nf3", g1f3);
+   board.move(g1f3);
+   book.getMoves(board, movesAfter);
+   book.close();
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(numGames == 3);
+   assertUnit(builder.size() == 5);        // Nf3, Nc3; after Nf3 Nf6, Nc6; after Nc3 Nf6
+   assertUnit(fWritten);
+   assertUnit(fOpen);
+   assertUnit(movesStart.size() == 1);     // Nc3 lost, so it weighs nothing
+   assertUnit(smith(movesStart[0].move) == "g1f3");
+   assertUnit(movesStart[0].weight == 3);  // a win and a draw
+   assertUnit(movesAfter.size() == 1);     // Nf6 lost for black
+   assertUnit(smith(movesAfter[0].move) == "b8c6");
+   assertUnit(movesAfter[0].weight == 1);
+}
+
+/*************************************
+ * WRITE : scaled
+ * Input:  one move seen 200000 times and one once
+ * Output: the big one fits in 16 bits, and the
+ *         small one, now worth nothing, is left out
+ **************************************/
+void TestBook::write_scaled()
+{
+   // SETUP
+   const char * fileName = "testBook.bin";
+   BookBuilder builder;
+   Board board;
+   builder.add(board, Move(Position(6, 0), Position(5, 2)), 200000);
+   builder.add(board, Move(Position(1, 0), Position(2, 2)), 1);
+   Book book;
+   vector <BookMove> moves;
+
+   // EXERCISE
+   bool fWritten = builder.write(fileName);
+   book.open(fileName);
+   book.getMoves(board, moves);
+   size_t size = book.size();
+   book.close();
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(fWritten);
+   assertUnit(size == 1);
+   assertUnit(moves.size() == 1);
+   assertUnit(moves[0].weight == 200000 / 4);
+   assertUnit(moves[0].weight <= 0xFFFF);
+}
@@ -0,0 +1,51 @@
+/***********************************************************************
+ * Header File:
+ *    TEST BOOK
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the opening book
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * BOOK TEST
+ * Test the Book and BookBuilder classes
+ ***************************************************/
+class TestBook : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(key_layout);
+      runTest(key_published);
+      runTest(key_turn);
+      runTest(encode_knight);
+      runTest(findSan_knights);
+      runTest(findSan_refused);
+      runTest(open_missing);
+      runTest(open_empty);
+      runTest(getMoves_collision);
+      runTest(pick_weighted);
+      runTest(addPgn_roundTrip);
+      runTest(write_scaled);
+
+      report("Book");
+   }
+private:
+   void key_layout();
+   void key_published();
+   void key_turn();
+   void encode_knight();
+   void findSan_knights();
+   void findSan_refused();
+   void open_missing();
+   void open_empty();
+   void getMoves_collision();
+   void pick_weighted();
+   void addPgn_roundTrip();
+   void write_scaled();
+};
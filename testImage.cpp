@@ -0,0 +1,174 @@
+/***********************************************************************
+ * Source File:
+ *    TEST IMAGE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for Image
+ ************************************************************************/
+
+#include "testImage.h"
+#include "image.h"
+#include <sstream>    // for OSTRINGSTREAM
+#include <string>     // for STRING
+using namespace std;
+
+static const int RED[]   = { 255, 0, 0 };
+static const int BLACK[] = { 0, 0, 0 };
+const uint32_t PIXEL_RED   = 0xFF0000FF;
+const uint32_t PIXEL_BLACK = 0x000000FF;
+
+/*************************************
+ * FILL RECT : pixel centers
+ * Input:  a 4x4 black image, fill (1.0, 1.0) to (3.0, 3.0)
+ * Output: the four pixels whose centers are inside
+ **************************************/
+void TestImage::fillRect_pixelCenters()
+{
+   // SETUP
+   Image image(4, 4);
+
+   // EXERCISE
+   image.fillRect(1.0, 1.0, 3.0, 3.0, RED);
+
+   // VERIFY
+   for (int y = 0; y < 4; y++)
+      for (int x = 0; x < 4; x++)
+      {
+         bool inside = 1 <= x && x < 3 && 1 <= y && y < 3;
+         assertUnit(image.getPixel(x, y) == (inside ? PIXEL_RED : PIXEL_BLACK));
+      }
+   assertUnit(image.getPixel(4, 0) == 0);
+   assertUnit(image.getPixel(0, -1) == 0);
+}
+
+/*************************************
+ * FILL QUAD : diamond
+ * Input:  a diamond around (10, 10), clockwise and
+ *         counterclockwise
+ * Output: the same pixels either way, the middle
+ *         filled and the corners of the image not
+ **************************************/
+void TestImage::fillQuad_diamond()
+{
+   // SETUP
+   Image imageClockwise(20, 20);
+   Image imageCounter(20, 20);
+   const double x[4]        = { 10.0, 15.0, 10.0,  5.0 };
+   const double y[4]        = {  5.0, 10.0, 15.0, 10.0 };
+   const double xReverse[4] = {  5.0, 10.0, 15.0, 10.0 };
+   const double yReverse[4] = { 10.0, 15.0, 10.0,  5.0 };
+
+   // EXERCISE
+   imageClockwise.fillQuad(x, y, RED);
+   imageCounter.fillQuad(xReverse, yReverse, RED);
+
+   // VERIFY
+   assertUnit(imageClockwise.pixels == imageCounter.pixels);
+   assertUnit(imageClockwise.getPixel(9, 9)   == PIXEL_RED);
+   assertUnit(imageClockwise.getPixel(10, 10) == PIXEL_RED);
+   assertUnit(imageClockwise.getPixel(13, 9)  == PIXEL_RED);
+   assertUnit(imageClockwise.getPixel(5, 5)   == PIXEL_BLACK);
+   assertUnit(imageClockwise.getPixel(14, 14) == PIXEL_BLACK);
+}
+
+/*************************************
+ * FILL QUAD : clipped
+ * Input:  clip to (2, 2) to (4, 4), fill everything
+ * Output: only the clip is red, and clipNone() lets
+ *         the next fill reach everywhere
+ **************************************/
+void TestImage::fillQuad_clipped()
+{
+   // SETUP
+   Image image(8, 8);
+   const double x[4] = { -1.0, 9.0, 9.0, -1.0 };
+   const double y[4] = { -1.0, -1.0, 9.0, 9.0 };
+
+   // EXERCISE
+   image.clip(2, 2, 4, 4);
+   image.fillQuad(x, y, RED);
+   uint32_t inside  = image.getPixel(3, 3);
+   uint32_t outside = image.getPixel(4, 3);
+   image.clipNone();
+   image.fillQuad(x, y, BLACK);
+
+   // VERIFY
+   assertUnit(inside  == PIXEL_RED);
+   assertUnit(outside == PIXEL_BLACK);
+   assertUnit(image.getPixel(3, 3) == PIXEL_BLACK);
+   assertUnit(image.getPixel(0, 7) == PIXEL_BLACK);
+}
+
+/*************************************
+ * DRAW TEXT : digit
+ * Input:  "1" with its baseline at (10, 20)
+ * Output: the top of the stem at (12, 26), the foot
+ *         along y = 20, and nothing left of the glyph
+ **************************************/
+void TestImage::drawText_digit()
+{
+   // SETUP
+   Image image(32, 32);
+
+   // EXERCISE
+   image.drawText(10.0, 20.0, "1", RED);
+
+   // VERIFY
+   assertUnit(image.getPixel(12, 26) == PIXEL_RED);
+   assertUnit(image.getPixel(11, 26) == PIXEL_BLACK);
+   assertUnit(image.getPixel(11, 25) == PIXEL_RED);
+   assertUnit(image.getPixel(11, 20) == PIXEL_RED);
+   assertUnit(image.getPixel(13, 20) == PIXEL_RED);
+   assertUnit(image.getPixel(10, 20) == PIXEL_BLACK);
+   assertUnit(image.getPixel(12, 19) == PIXEL_BLACK);
+   assertUnit(Image::getTextWidth("12") == 12);
+}
+
+/*************************************
+ * WRITE PPM : header
+ * Input:  a 2x1 image, left red, right black
+ * Output: "P6", the size, and six bytes of RGB
+ **************************************/
+void TestImage::writePpm_header()
+{
+   // SETUP
+   Image image(2, 1);
+   image.fillRect(0.0, 0.0, 1.0, 1.0, RED);
+   ostringstream out;
+
+   // EXERCISE
+   image.writePpm(out);
+
+   // VERIFY
+   string header = "P6\n2 1\n255\n";
+   string text = out.str();
+   assertUnit(text.size() == header.size() + 6);
+   assertUnit(text.substr(0, header.size()) == header);
+   assertUnit(text.substr(header.size()) == string("\xFF\0\0\0\0\0", 6));
+}
+
+/*************************************
+ * WRITE PNG : chunks
+ * Input:  a 3x2 image
+ * Output: the signature, IHDR with the size, and it
+ *         ends with the IEND chunk and its fixed CRC
+ **************************************/
+void TestImage::writePng_chunks()
+{
+   // SETUP
+   Image image(3, 2);
+   ostringstream out;
+
+   // EXERCISE
+   image.writePng(out);
+
+   // VERIFY
+   string bytes = out.str();
+   assertUnit(bytes.size() > 8 + 25 + 12);
+   assertUnit(bytes.substr(0, 8) == "\x89PNG\r\n\x1A\n");
+   assertUnit(bytes.substr(12, 4) == "IHDR");
+   assertUnit(bytes.substr(16, 8) == string("\0\0\0\x03\0\0\0\x02", 8));
+   assertUnit(bytes.substr(bytes.size() - 12) ==
+              string("\0\0\0\0IEND\xAE\x42\x60\x82", 12));
+}
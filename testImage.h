@@ -0,0 +1,44 @@
+/***********************************************************************
+ * Header File:
+ *    TEST IMAGE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for Image
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * IMAGE TEST
+ * Test the Image class
+ ***************************************************/
+class TestImage : public UnitTest
+{
+public:
+   void run()
+   {
+      // fill
+      runTest(fillRect_pixelCenters);
+      runTest(fillQuad_diamond);
+      runTest(fillQuad_clipped);
+
+      // text
+      runTest(drawText_digit);
+
+      // write
+      runTest(writePpm_header);
+      runTest(writePng_chunks);
+
+      report("Image");
+   }
+private:
+   void fillRect_pixelCenters();
+   void fillQuad_diamond();
+   void fillQuad_clipped();
+   void drawText_digit();
+   void writePpm_header();
+   void writePng_chunks();
+};
@@ -22,12 +22,12 @@ public:
 
    void run()
    {
-      getMoves_blocked();
-      getMoves_capture();
-      getMoves_free();
-      getMoves_end();
+      runTest(getMoves_blocked);
+      runTest(getMoves_capture);
+      runTest(getMoves_free);
+      runTest(getMoves_end);
 
-      getType();
+      runTest(getType);
       
       report("Knight");
    }
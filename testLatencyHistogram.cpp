@@ -0,0 +1,122 @@
+/***********************************************************************
+ * Source File:
+ *    TEST LATENCY HISTOGRAM
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the latency histogram
+ ************************************************************************/
+
+#include "testLatencyHistogram.h"
+#include "latencyHistogram.h"
+#include <thread>     // for THREAD
+#include <vector>     // for VECTOR of threads
+#include <cmath>      // for FABS
+using namespace std;
+
+/*************************************
+ * CONSTRUCT : empty
+ * Input:  nothing recorded
+ * Output: zeros all around
+ **************************************/
+void TestLatencyHistogram::construct_empty()
+{
+   // SETUP
+   // EXERCISE
+   LatencyHistogram h;
+
+   // VERIFY
+   assertUnit(h.getCount() == 0);
+   assertUnit(h.getMax() == 0);
+   assertUnit(h.getMean() == 0.0);
+   assertUnit(h.percentile(0.5) == 0.0);
+   assertUnit(h.percentile(0.99) == 0.0);
+}
+
+/*************************************
+ * BUCKET : precision
+ * Input:  small times, powers of two, and huge ones
+ * Output: small times exact, the rest within an eighth,
+ *         and the buckets never go backwards
+ **************************************/
+void TestLatencyHistogram::bucket_precision()
+{
+   // SETUP
+   bool fExactSmall = true;
+   bool fClose = true;
+   bool fInOrder = true;
+
+   // EXERCISE
+   for (uint64_t ns = 0; ns < 16; ns++)
+      fExactSmall = fExactSmall && LatencyHistogram::bucketMiddle(LatencyHistogram::bucket(ns)) == (double)ns;
+   int previous = 0;
+   for (uint64_t ns = 16; ns < (1ull << 62); ns += ns / 7 + 1)
+   {
+      int i = LatencyHistogram::bucket(ns);
+      double middle = LatencyHistogram::bucketMiddle(i);
+      fClose = fClose && fabs(middle - (double)ns) <= (double)ns / 8.0;
+      fInOrder = fInOrder && i >= previous;
+      previous = i;
+   }
+
+   // VERIFY
+   assertUnit(fExactSmall);
+   assertUnit(fClose);
+   assertUnit(fInOrder);
+   assertUnit(LatencyHistogram::bucket(16) == 16);
+   assertUnit(LatencyHistogram::bucket(~0ull) == LatencyHistogram::NUM_BUCKETS - 1);
+}
+
+/*************************************
+ * PERCENTILE : uniform
+ * Input:  1000 times, 1us apart
+ * Output: p50 near 500us, p99 near 990us, the max and
+ *         mean exact
+ **************************************/
+void TestLatencyHistogram::percentile_uniform()
+{
+   // SETUP
+   LatencyHistogram h;
+
+   // EXERCISE
+   for (uint64_t us = 1; us <= 1000; us++)
+      h.record(us * 1000);
+
+   // VERIFY
+   assertUnit(h.getCount() == 1000);
+   assertUnit(h.getMax() == 1000000);
+   assertUnit(h.getMean() == 500500.0);
+   assertUnit(fabs(h.percentile(0.50) - 500000.0) <= 500000.0 / 8.0);
+   assertUnit(fabs(h.percentile(0.99) - 990000.0) <= 990000.0 / 8.0);
+   assertUnit(h.percentile(0.50) < h.percentile(0.99));
+}
+
+/*************************************
+ * RECORD : threads
+ * Input:  four threads recording at once
+ * Output: nothing lost
+ **************************************/
+void TestLatencyHistogram::record_threads()
+{
+   // SETUP
+   LatencyHistogram h;
+   vector <thread> threads;
+
+   // EXERCISE
+   for (int t = 0; t < 4; t++)
+      threads.push_back(thread([&h, t]()
+      {
+         for (uint64_t i = 0; i < 10000; i++)
+            h.record(i + t);
+      }));
+   for (thread & th : threads)
+      th.join();
+
+   // VERIFY
+   assertUnit(h.getCount() == 40000);
+   assertUnit(h.getMax() == 9999 + 3);
+   uint64_t total = 0;
+   for (int i = 0; i < LatencyHistogram::NUM_BUCKETS; i++)
+      total += h.buckets[i];
+   assertUnit(total == 40000);
+}
@@ -0,0 +1,35 @@
+/***********************************************************************
+ * Header File:
+ *    TEST LATENCY HISTOGRAM
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the latency histogram
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * LATENCY HISTOGRAM TEST
+ * Test the LatencyHistogram class
+ ***************************************************/
+class TestLatencyHistogram : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(construct_empty);
+      runTest(bucket_precision);
+      runTest(percentile_uniform);
+      runTest(record_threads);
+
+      report("LatencyHistogram");
+   }
+private:
+   void construct_empty();
+   void bucket_precision();
+   void percentile_uniform();
+   void record_threads();
+};
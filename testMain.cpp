@@ -0,0 +1,26 @@
+/**********************************************************************
+* Source File:
+*    TEST MAIN
+* Author:
+*    <your name here>
+* Summary:
+*    Run all the unit tests without starting the game. The exit code
+*    is nonzero if any test failed, so a build script can check it.
+*    "test -j1" runs the test classes one at a time.
+************************************************************************/
+
+#include "test.h"       // for TEST RUNNER
+#include <cstdlib>      // for ATOI
+#include <cstring>      // for STRNCMP
+
+/*********************************
+ * MAIN - Where it all begins...
+ *********************************/
+int main(int argc, char** argv)
+{
+   int numThreads = 0;
+   if (argc > 1 && strncmp(argv[1], "-j", 2) == 0)
+      numThreads = atoi(argv[1] + 2);
+
+   return testRunner(numThreads) == 0 ? 0 : 1;
+}
@@ -21,44 +21,44 @@ public:
    void run() 
    {
       // Constructor
-      constructor_default();
+      runTest(constructor_default);
 
       // Assign
-      read_simple();
-      read_capture();
-      read_enpassant();
-      read_castleKing();
-      read_castleQueen();
-      constructString_simple();
-      assign_simple();
-      assign_capture();
-      assign_enpassant();
-      assign_castleKing();
-      assign_castleQueen();
+      runTest(read_simple);
+      runTest(read_capture);
+      runTest(read_enpassant);
+      runTest(read_castleKing);
+      runTest(read_castleQueen);
+      runTest(constructString_simple);
+      runTest(assign_simple);
+      runTest(assign_capture);
+      runTest(assign_enpassant);
+      runTest(assign_castleKing);
+      runTest(assign_castleQueen);
 
       // Get Text
-      getText_simple();
-      getText_capture();
-      getText_enpassant();
-      getText_castleKing();
-      getText_castleQueen();
+      runTest(getText_simple);
+      runTest(getText_capture);
+      runTest(getText_enpassant);
+      runTest(getText_castleKing);
+      runTest(getText_castleQueen);
 
       // Letter from Piece Type
-      letterFromPieceType_space();
-      letterFromPieceType_pawn();
-      letterFromPieceType_bishop();
-      letterFromPieceType_knight();
-      letterFromPieceType_rook();
-      letterFromPieceType_queen();
-      letterFromPieceType_king();
+      runTest(letterFromPieceType_space);
+      runTest(letterFromPieceType_pawn);
+      runTest(letterFromPieceType_bishop);
+      runTest(letterFromPieceType_knight);
+      runTest(letterFromPieceType_rook);
+      runTest(letterFromPieceType_queen);
+      runTest(letterFromPieceType_king);
 
       // Piece Type from Letter
-      pieceTypeFromLetter_pawn();
-      pieceTypeFromLetter_knight();
-      pieceTypeFromLetter_bishop();
-      pieceTypeFromLetter_rook();
-      pieceTypeFromLetter_king();
-      pieceTypeFromLetter_queen();
+      runTest(pieceTypeFromLetter_pawn);
+      runTest(pieceTypeFromLetter_knight);
+      runTest(pieceTypeFromLetter_bishop);
+      runTest(pieceTypeFromLetter_rook);
+      runTest(pieceTypeFromLetter_king);
+      runTest(pieceTypeFromLetter_queen);
 
       report("Move");
    }
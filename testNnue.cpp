@@ -0,0 +1,226 @@
+/***********************************************************************
+ * Source File:
+ *    TEST NNUE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the network evaluation
+ ************************************************************************/
+
+#include "testNnue.h"
+#include "nnue.h"
+#include "board.h"
+#include "position.h"
+#include <cstdio>     // for REMOVE
+#include <string>     // for STRING
+#include <cassert>
+using namespace std;
+
+/*************************************
+ * FEATURE : mirror
+ * Input:  white knight b1 with the king on e1, seen by white
+ *         black knight b8 with the king on e8, seen by black
+ * Output: the same feature
+ **************************************/
+void TestNnue::feature_mirror()
+{
+   // EXERCISE
+   int white = Network::feature(true  /*perspectiveWhite*/, 4  /*e1*/,
+                                KNIGHT, true  /*isWhite*/, 1  /*b1*/);
+   int black = Network::feature(false /*perspectiveWhite*/, 60 /*e8*/,
+                                KNIGHT, false /*isWhite*/, 57 /*b8*/);
+
+   // VERIFY
+   assertUnit(white == black);
+}
+
+/*************************************
+ * FEATURE : range
+ * Input:  the first and last possible features
+ * Output: all inside the input layer, all different
+ **************************************/
+void TestNnue::feature_range()
+{
+   // EXERCISE
+   int first = Network::feature(true, 0,  QUEEN, true,  0);
+   int last  = Network::feature(true, 63, PAWN,  false, 63);
+   int ours  = Network::feature(true, 0,  PAWN,  true,  0);
+   int theirs= Network::feature(true, 0,  PAWN,  false, 0);
+
+   // VERIFY
+   assertUnit(first == 0);
+   assertUnit(last == NNUE_INPUTS - 1);
+   assertUnit(ours != theirs);
+}
+
+/*************************************
+ * KERNEL : agree
+ * Input:  the starting position, random weights
+ * Output: the scalar and the fastest kernel get the same answer
+ **************************************/
+void TestNnue::kernel_agree()
+{
+   // SETUP
+   string best = Network::getKernel();
+   Network network;
+   network.randomize(7);
+   Board board;
+   Accumulator accScalar;
+   Accumulator accBest;
+
+   // EXERCISE
+   board.setNetwork(&network);
+   accBest = board.accumulators.back();
+   int valueBest = network.evaluate(accBest, true);
+   Network::setKernel("scalar");
+   board.networkAll(accScalar);
+   int valueScalar = network.evaluate(accScalar, true);
+   Network::setKernel(best.c_str());
+
+   // VERIFY
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+   {
+      assertUnit(accScalar.values[0][i] == accBest.values[0][i]);
+      assertUnit(accScalar.values[1][i] == accBest.values[1][i]);
+   }
+   assertUnit(valueScalar == valueBest);
+   assertUnit(string(Network::getKernel()) == best);
+
+   // TEARDOWN
+   board.setNetwork(nullptr);
+}
+
+/*************************************
+ * MOVE : incremental
+ * Input:  the starting position, g1f3
+ * Output: the updated accumulator matches one built from scratch
+ **************************************/
+void TestNnue::move_incremental()
+{
+   // SETUP
+   Network network;
+   network.randomize(11);
+   Board board;
+   board.setNetwork(&network);
+   Accumulator acc;
+
+   // EXERCISE
+   board.move(Move(Position(6, 0), Position(5, 2)));
+   board.networkAll(acc);
+
+   // VERIFY
+   assertUnit(board.accumulators.size() == 2);
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+   {
+      assertUnit(acc.values[0][i] == board.accumulators.back().values[0][i]);
+      assertUnit(acc.values[1][i] == board.accumulators.back().values[1][i]);
+   }
+
+   // TEARDOWN
+   board.setNetwork(nullptr);
+}
+
+/*************************************
+ * UNDO : restores
+ * Input:  the starting position, g1f3 then undo
+ * Output: the same evaluation as before the move
+ **************************************/
+void TestNnue::undo_restores()
+{
+   // SETUP
+   Network network;
+   network.randomize(13);
+   Board board;
+   board.setNetwork(&network);
+   int valueBefore = board.evaluate();
+
+   // EXERCISE
+   board.move(Move(Position(6, 0), Position(5, 2)));
+   board.undo();
+
+   // VERIFY
+   assertUnit(board.accumulators.size() == 1);
+   assertUnit(board.evaluate() == valueBefore);
+
+   // TEARDOWN
+   board.setNetwork(nullptr);
+}
+
+/*************************************
+ * EVALUATE : symmetric
+ * Input:  the starting position, which is its own mirror image
+ * Output: both halves of the accumulator are the same, so the
+ *         side to move gets the same score either way
+ **************************************/
+void TestNnue::evaluate_symmetric()
+{
+   // SETUP
+   Network network;
+   network.randomize(17);
+   Board board;
+   board.setNetwork(&network);
+
+   // EXERCISE
+   int valueWhite = board.evaluate();
+   board.moveNull();
+   int valueBlack = board.evaluate();
+   board.undoNull();
+
+   // VERIFY
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+      assertUnit(board.accumulators.back().values[0][i] ==
+                 board.accumulators.back().values[1][i]);
+   assertUnit(valueWhite == -valueBlack);
+
+   // TEARDOWN
+   board.setNetwork(nullptr);
+}
+
+/*************************************
+ * LOAD : round trip
+ * Input:  random weights saved to a file
+ * Output: loading them back gives the same weights
+ **************************************/
+void TestNnue::load_roundTrip()
+{
+   // SETUP
+   const char * fileName = "testNnue.bin";
+   Network networkSaved;
+   networkSaved.randomize(19);
+   Network networkLoaded;
+
+   // EXERCISE
+   bool fSaved  = networkSaved.save(fileName);
+   bool fLoaded = networkLoaded.load(fileName);
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(fSaved);
+   assertUnit(fLoaded);
+   assertUnit(networkLoaded.weights == networkSaved.weights);
+   for (int i = 0; i < NNUE_HIDDEN; i++)
+      assertUnit(networkLoaded.biases[i] == networkSaved.biases[i]);
+   for (int i = 0; i < 2 * NNUE_HIDDEN; i++)
+      assertUnit(networkLoaded.outputWeights[i] == networkSaved.outputWeights[i]);
+   assertUnit(networkLoaded.outputBias == networkSaved.outputBias);
+}
+
+/*************************************
+ * LOAD : missing file
+ * Input:  a file that is not there
+ * Output: false, and the weights are left alone
+ **************************************/
+void TestNnue::load_missing()
+{
+   // SETUP
+   Network network;
+   network.randomize(23);
+   int16_t weight = network.weights[100];
+
+   // EXERCISE
+   bool fLoaded = network.load("noSuchFile.bin");
+
+   // VERIFY
+   assertUnit(fLoaded == false);
+   assertUnit(network.weights[100] == weight);
+}
@@ -0,0 +1,53 @@
+/***********************************************************************
+ * Header File:
+ *    TEST NNUE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the network evaluation
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * NNUE TEST
+ * Test the Network class and how the Board keeps it up to date
+ ***************************************************/
+class TestNnue : public UnitTest
+{
+public:
+   void run()
+   {
+      // features
+      runTest(feature_mirror);
+      runTest(feature_range);
+
+      // kernels
+      runTest(kernel_agree);
+
+      // board
+      runTest(move_incremental);
+      runTest(undo_restores);
+      runTest(evaluate_symmetric);
+
+      // file
+      runTest(load_roundTrip);
+      runTest(load_missing);
+
+      report("Nnue");
+   }
+private:
+   void feature_mirror();
+   void feature_range();
+
+   void kernel_agree();
+
+   void move_incremental();
+   void undo_restores();
+   void evaluate_symmetric();
+
+   void load_roundTrip();
+   void load_missing();
+};
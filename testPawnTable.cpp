@@ -0,0 +1,201 @@
+/***********************************************************************
+ * Source File:
+ *    TEST PAWN TABLE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the pawn hash table and the pawn structure
+ *    scores it holds
+ ************************************************************************/
+
+#include "testPawnTable.h"
+#include "pawnTable.h"
+#include "evaluate.h"
+#include <cassert>
+
+/*************************************
+ * CONSTRUCT : power of two
+ * Input:  1000 entries
+ * Output: 512 entries, so the key can be masked
+ **************************************/
+void TestPawnTable::construct_powerOfTwo()
+{
+   // EXERCISE
+   PawnTable table(1000);
+
+   // VERIFY
+   assertUnit(table.entries.size() == 512);
+   assertUnit(table.mask == 511);
+   assertUnit(table.getProbes() == 0);
+}
+
+/*************************************
+ * PROBE : empty
+ * Input:  a new table, key 0
+ * Output: a miss, even though unused entries have key 0
+ **************************************/
+void TestPawnTable::probe_empty()
+{
+   // SETUP
+   PawnTable table(16);
+   int mg = 99;
+   int eg = 99;
+
+   // EXERCISE
+   bool fHit = table.probe(0, mg, eg);
+
+   // VERIFY
+   assertUnit(fHit == false);
+   assertUnit(mg == 99);
+   assertUnit(eg == 99);
+   assertUnit(table.getProbes() == 1);
+   assertUnit(table.getHits() == 0);
+}
+
+/*************************************
+ * STORE : hit
+ * Input:  store key 0x1234 with (12, -7), probe it twice
+ * Output: two hits with the stored scores
+ **************************************/
+void TestPawnTable::store_hit()
+{
+   // SETUP
+   PawnTable table(16);
+   int mg = 0;
+   int eg = 0;
+
+   // EXERCISE
+   table.store(0x1234, 12, -7);
+   bool fHit1 = table.probe(0x1234, mg, eg);
+   bool fHit2 = table.probe(0x1234, mg, eg);
+   bool fMiss = table.probe(0x1235, mg, eg);
+
+   // VERIFY
+   assertUnit(fHit1 == true);
+   assertUnit(fHit2 == true);
+   assertUnit(fMiss == false);
+   assertUnit(mg == 12);
+   assertUnit(eg == -7);
+   assertUnit(table.getHitRate() > 0.66 && table.getHitRate() < 0.67);
+}
+
+/*************************************
+ * STORE : replace
+ * Input:  two keys that share a slot in a 16 entry table
+ * Output: the second replaces the first
+ **************************************/
+void TestPawnTable::store_replace()
+{
+   // SETUP
+   PawnTable table(16);
+   int mg = 0;
+   int eg = 0;
+
+   // EXERCISE
+   table.store(0x03, 1, 1);
+   table.store(0x13, 2, 2);
+
+   // VERIFY
+   assertUnit(table.probe(0x03, mg, eg) == false);
+   assertUnit(table.probe(0x13, mg, eg) == true);
+   assertUnit(mg == 2);
+}
+
+/*************************************
+ * CLEAR : statistics
+ * Input:  a table with an entry and some probes
+ * Output: the counts start over but the entry is still there
+ **************************************/
+void TestPawnTable::clear_statistics()
+{
+   // SETUP
+   PawnTable table(16);
+   int mg = 0;
+   int eg = 0;
+   table.store(0x42, 5, 6);
+   table.probe(0x42, mg, eg);
+
+   // EXERCISE
+   table.clearStatistics();
+
+   // VERIFY
+   assertUnit(table.getProbes() == 0);
+   assertUnit(table.getHits() == 0);
+   assertUnit(table.probe(0x42, mg, eg) == true);
+}
+
+/*************************************
+ * PAWN STRUCTURE : passed
+ * +---a-b-c-d-e-f-g-h---+
+ * |                     |
+ * 6                     6
+ * 5       p             5
+ * 4                     4
+ * 3                     3
+ * 2                   P 2
+ * |                     |
+ * +---a-b-c-d-e-f-g-h---+
+ * Output: both are passed and isolated, but black's is further
+ *         along so black is ahead
+ **************************************/
+void TestPawnTable::pawnStructure_passed()
+{
+   // SETUP
+   uint64_t pawnsWhite = 1ull << (4 * 8 + 2);   // c5
+   uint64_t pawnsBlack = 1ull << (1 * 8 + 7);   // h2 is black's 7th rank
+   int mg = 0;
+   int eg = 0;
+
+   // EXERCISE
+   pawnStructure(pawnsWhite, pawnsBlack, mg, eg);
+
+   // VERIFY
+   assertUnit(mg < 0);
+   assertUnit(eg < 0);
+}
+
+/*************************************
+ * PAWN STRUCTURE : blocked
+ * Input:  white c4, black d5
+ * Output: nobody is passed, so white does worse than with the
+ *         black pawns gone
+ **************************************/
+void TestPawnTable::pawnStructure_blocked()
+{
+   // SETUP
+   uint64_t pawnsWhite = 1ull << (3 * 8 + 2);   // c4
+   uint64_t pawnsBlack = 1ull << (4 * 8 + 3);   // d5
+   int mgBlocked = 0;
+   int egBlocked = 0;
+   int mgFree = 0;
+   int egFree = 0;
+
+   // EXERCISE
+   pawnStructure(pawnsWhite, pawnsBlack, mgBlocked, egBlocked);
+   pawnStructure(pawnsWhite, 0, mgFree, egFree);
+
+   // VERIFY
+   assertUnit(egFree > 0);
+   assertUnit(egBlocked < egFree);
+}
+
+/*************************************
+ * PAWN STRUCTURE : isolated and doubled
+ * Input:  white a2 a3, black a7 b7
+ * Output: white is worse, its pawns are doubled and isolated
+ **************************************/
+void TestPawnTable::pawnStructure_isolatedDoubled()
+{
+   // SETUP
+   uint64_t pawnsWhite = (1ull << (1 * 8 + 0)) | (1ull << (2 * 8 + 0));
+   uint64_t pawnsBlack = (1ull << (6 * 8 + 0)) | (1ull << (6 * 8 + 1));
+   int mg = 0;
+   int eg = 0;
+
+   // EXERCISE
+   pawnStructure(pawnsWhite, pawnsBlack, mg, eg);
+
+   // VERIFY
+   assertUnit(mg < 0);
+   assertUnit(eg < 0);
+}
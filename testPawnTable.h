@@ -0,0 +1,48 @@
+/***********************************************************************
+ * Header File:
+ *    TEST PAWN TABLE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the pawn hash table and the pawn structure
+ *    scores it holds
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * PAWN TABLE TEST
+ * Test the PawnTable class
+ ***************************************************/
+class TestPawnTable : public UnitTest
+{
+public:
+   void run()
+   {
+      // table
+      runTest(construct_powerOfTwo);
+      runTest(probe_empty);
+      runTest(store_hit);
+      runTest(store_replace);
+      runTest(clear_statistics);
+
+      // structure
+      runTest(pawnStructure_passed);
+      runTest(pawnStructure_blocked);
+      runTest(pawnStructure_isolatedDoubled);
+
+      report("PawnTable");
+   }
+private:
+   void construct_powerOfTwo();
+   void probe_empty();
+   void store_hit();
+   void store_replace();
+   void clear_statistics();
+
+   void pawnStructure_passed();
+   void pawnStructure_blocked();
+   void pawnStructure_isolatedDoubled();
+};
@@ -0,0 +1,114 @@
+/***********************************************************************
+ * Source File:
+ *    TEST PERF COUNTERS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the hardware counters
+ ************************************************************************/
+
+#include "testPerfCounters.h"
+#include "perfCounters.h"
+#include "benchHarness.h"
+#include <cstring>    // for STRCMP
+
+/*************************************
+ * CONSTRUCT : unread
+ * Input:  nothing
+ * Output: every counter reads -1 until stop()
+ **************************************/
+void TestPerfCounters::construct_unread()
+{
+   // EXERCISE
+   PerfCounters perf;
+
+   // VERIFY
+   for (int i = 0; i < COUNTER_NUM; i++)
+      assertUnit(perf.get((Counter)i) == -1);
+}
+
+/*************************************
+ * AVAILABLE : any
+ * Input:  whatever this machine allows
+ * Output: available if and only if one counter is
+ **************************************/
+void TestPerfCounters::available_any()
+{
+   // SETUP
+   PerfCounters perf;
+
+   // EXERCISE
+   bool fAny = false;
+   for (int i = 0; i < COUNTER_NUM; i++)
+      fAny = fAny || perf.isAvailable((Counter)i);
+
+   // VERIFY
+   assertUnit(perf.isAvailable() == fAny);
+}
+
+/*************************************
+ * STOP : counts
+ * Input:  start, a loop, stop
+ * Output: available counters read zero or more,
+ *         the rest read -1. Instructions are never zero
+ **************************************/
+void TestPerfCounters::stop_counts()
+{
+   // SETUP
+   PerfCounters perf;
+
+   // EXERCISE
+   perf.start();
+   long sum = 0;
+   for (long i = 0; i < 100000; i++)
+   {
+      sum += i;
+      doNotOptimize(sum);
+   }
+   perf.stop();
+
+   // VERIFY
+   for (int i = 0; i < COUNTER_NUM; i++)
+      if (perf.isAvailable((Counter)i))
+         assertUnit(perf.get((Counter)i) >= 0);
+      else
+         assertUnit(perf.get((Counter)i) == -1);
+   if (perf.isAvailable(COUNTER_INSTRUCTIONS))
+      assertUnit(perf.get(COUNTER_INSTRUCTIONS) > 0);
+}
+
+/*************************************
+ * IPC : unavailable
+ * Input:  no cycles counted
+ * Output: -1.0
+ **************************************/
+void TestPerfCounters::ipc_unavailable()
+{
+   // SETUP
+   PerfCounters perf;
+   perf.values[COUNTER_CYCLES] = -1;
+   perf.values[COUNTER_INSTRUCTIONS] = 500;
+
+   // EXERCISE
+   double ipcNone = perf.getIpc();
+   perf.values[COUNTER_CYCLES] = 200;
+   double ipc = perf.getIpc();
+
+   // VERIFY
+   assertEquals(ipcNone, -1.0);
+   assertEquals(ipc, 2.5);
+}
+
+/*************************************
+ * GET NAME : all
+ * Input:  each counter
+ * Output: the names used in the JSON
+ **************************************/
+void TestPerfCounters::getName_all()
+{
+   assertUnit(strcmp(PerfCounters::getName(COUNTER_CYCLES), "cycles") == 0);
+   assertUnit(strcmp(PerfCounters::getName(COUNTER_INSTRUCTIONS), "instructions") == 0);
+   assertUnit(strcmp(PerfCounters::getName(COUNTER_L1D_MISSES), "l1d_misses") == 0);
+   assertUnit(strcmp(PerfCounters::getName(COUNTER_LLC_MISSES), "llc_misses") == 0);
+   assertUnit(strcmp(PerfCounters::getName(COUNTER_BRANCH_MISSES), "branch_misses") == 0);
+}
@@ -0,0 +1,38 @@
+/***********************************************************************
+ * Header File:
+ *    TEST PERF COUNTERS
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the hardware counters. They must pass whether
+ *    or not this machine lets us read the counters.
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * PERF COUNTERS TEST
+ * Test the PerfCounters class
+ ***************************************************/
+class TestPerfCounters : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(construct_unread);
+      runTest(available_any);
+      runTest(stop_counts);
+      runTest(ipc_unavailable);
+      runTest(getName_all);
+
+      report("PerfCounters");
+   }
+private:
+   void construct_unread();
+   void available_any();
+   void stop_counts();
+   void ipc_unavailable();
+   void getName_all();
+};
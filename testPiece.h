@@ -21,26 +21,26 @@ public:
 
    void run()
    {
-      assignment();
-
-      equals_same();
-      equals_different();
-      notEquals_same();
-      notEquals_different();
-
-      isWhite_white();
-      isWhite_black();
-      isMoved_initial();
-      isMoved_hasMoved();
-      getNMoves_initial();
-      getNMoves_hasMoved();
-
-      getPosition();
-      justMoved_initial();
-      justMoved_hasMoved();
-      justMoved_justMoved();
-
-      setLastMove();
+      runTest(assignment);
+
+      runTest(equals_same);
+      runTest(equals_different);
+      runTest(notEquals_same);
+      runTest(notEquals_different);
+
+      runTest(isWhite_white);
+      runTest(isWhite_black);
+      runTest(isMoved_initial);
+      runTest(isMoved_hasMoved);
+      runTest(getNMoves_initial);
+      runTest(getNMoves_hasMoved);
+
+      runTest(getPosition);
+      runTest(justMoved_initial);
+      runTest(justMoved_hasMoved);
+      runTest(justMoved_justMoved);
+
+      runTest(setLastMove);
 
       report("Piece");
    }
@@ -878,3 +878,52 @@ void PositionTest::adjust_invalid()
 }
 
 
+
+/*************************************
+ * SET TEST XY two windows
+ * The same pixel in a window with 32 pixel squares
+ * and in one with 64 pixel squares
+ * Output: d2 (0x31) in the small one, b1 (0x10) in
+ *         the big one; both draw in SIZE_SQUARE units
+ **************************************/
+void PositionTest::set_xyTwoWindows()
+{
+   // SETUP
+   Position posSmall;
+   Position posBig;
+
+   // EXERCISE
+   posSmall.setXY(100.0, 40.0, 32.0, 32.0);
+   posBig.setXY(100.0, 40.0, 64.0, 64.0);
+
+   // VERIFY
+   assertUnit(posSmall.colRow == 0x31);
+   assertUnit(posBig.colRow == 0x10);
+   assertUnit(posSmall.getX() == 3 * SIZE_SQUARE);
+   assertUnit(posBig.getX() == 1 * SIZE_SQUARE);
+
+   // TEARDOWN
+}
+
+/*************************************
+ * SET TEST XY off
+ * Past the eighth square, or a window too small to
+ * have squares
+ * Output: invalid
+ **************************************/
+void PositionTest::set_xyOff()
+{
+   // SETUP
+   Position posPast;
+   Position posNoSquares;
+
+   // EXERCISE
+   posPast.setXY(300.0, 10.0, 32.0, 32.0);
+   posNoSquares.setXY(10.0, 10.0, 0.0, 0.0);
+
+   // VERIFY
+   assertUnit(posPast.isInvalid());
+   assertUnit(posNoSquares.isInvalid());
+
+   // TEARDOWN
+}
@@ -22,55 +22,57 @@ public:
    {
       reset();
       // get
-      getRow_zero();
-      getCol_zero();
-      getLocation_zero();
-      isValid_zero();
-      isInvalid_zero();
+      runTest(getRow_zero);
+      runTest(getCol_zero);
+      runTest(getLocation_zero);
+      runTest(isValid_zero);
+      runTest(isInvalid_zero);
       
       
-      getRow_middle();
-      getCol_middle();
-      getLocation_middle();
-      isValid_middle();
-      isInvalid_middle();
+      runTest(getRow_middle);
+      runTest(getCol_middle);
+      runTest(getLocation_middle);
+      runTest(isValid_middle);
+      runTest(isInvalid_middle);
       
-      getRow_end();
-      getCol_end();
-      getLocation_end();
-      isValid_end();
-      isInvalid_end();
+      runTest(getRow_end);
+      runTest(getCol_end);
+      runTest(getLocation_end);
+      runTest(isValid_end);
+      runTest(isInvalid_end);
       
-      getRow_invalid();
-      getCol_invalid();
-      isValid_invalid();
-      isInvalid_invalid();
+      runTest(getRow_invalid);
+      runTest(getCol_invalid);
+      runTest(isValid_invalid);
+      runTest(isInvalid_invalid);
       
-      getRow_rowInvalid();
-      getCol_rowInvalid();
-      isValid_rowInvalid();
-      isInvalid_rowInvalid();
-      getRow_colInvalid();
-      getCol_colInvalid();
-      isValid_colInvalid();
-      isInvalid_colInvalid();
+      runTest(getRow_rowInvalid);
+      runTest(getCol_rowInvalid);
+      runTest(isValid_rowInvalid);
+      runTest(isInvalid_rowInvalid);
+      runTest(getRow_colInvalid);
+      runTest(getCol_colInvalid);
+      runTest(isValid_colInvalid);
+      runTest(isInvalid_colInvalid);
 
       // set
-      set_col();
-      set_row();
-      set_both();
-      set_text();
-      set_string();
-      set_copy();
+      runTest(set_col);
+      runTest(set_row);
+      runTest(set_both);
+      runTest(set_text);
+      runTest(set_string);
+      runTest(set_copy);
+      runTest(set_xyTwoWindows);
+      runTest(set_xyOff);
          
       // adjust
-      adjust_addColumn();
-      adjust_addRow();
-      adjust_offRight();
-      adjust_offTop();
-      adjust_offLeft();
-      adjust_offBottom();
-      adjust_invalid();
+      runTest(adjust_addColumn);
+      runTest(adjust_addRow);
+      runTest(adjust_offRight);
+      runTest(adjust_offTop);
+      runTest(adjust_offLeft);
+      runTest(adjust_offBottom);
+      runTest(adjust_invalid);
       
       report("Position");
    }
@@ -113,6 +115,8 @@ private:
    void set_text();
    void set_string();
    void set_copy();
+   void set_xyTwoWindows();
+   void set_xyOff();
 
    void adjust_addColumn();
    void adjust_addRow();
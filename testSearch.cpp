@@ -0,0 +1,251 @@
+/***********************************************************************
+ * Source File:
+ *    TEST SEARCH
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the search
+ ************************************************************************/
+
+#include "testSearch.h"
+#include "search.h"
+#include "board.h"
+#include "piece.h"
+#include "pieceSpace.h"
+#include "pieceKnight.h"
+#include <cassert>
+
+/*************************************
+ * REDUCTION : early moves
+ * Input:  depth=8, moveNumber=1
+ * Output: 0, the first move is never reduced
+ **************************************/
+void TestSearch::reduction_early()
+{
+   // EXERCISE
+   int r = Search::reduction(8, 1);
+
+   // VERIFY
+   assertUnit(r == 0);
+}
+
+/*************************************
+ * REDUCTION : grows with depth and move number
+ * Input:  (3,4) (10,4) (10,30)
+ * Output: each at least as big as the last
+ **************************************/
+void TestSearch::reduction_grows()
+{
+   // EXERCISE
+   int rShallow = Search::reduction(3, 4);
+   int rDeep    = Search::reduction(10, 4);
+   int rLate    = Search::reduction(10, 30);
+
+   // VERIFY
+   assertUnit(rShallow <= rDeep);
+   assertUnit(rDeep <= rLate);
+   assertUnit(rLate > 0);
+}
+
+/*************************************
+ * HAS NON PAWN MATERIAL : pawns only
+ * +---a-b-c-d-e-f-g-h---+
+ * |                     |
+ * 8                     8
+ * 7                     7
+ * 6                     6
+ * 5                     5
+ * 4                     4
+ * 3                     3
+ * 2     p               2
+ * 1                     1
+ * |                     |
+ * +---a-b-c-d-e-f-g-h---+
+ **************************************/
+void TestSearch::hasNonPawnMaterial_pawnsOnly()
+{
+   // SETUP
+   BoardEmpty board;
+   White pawn(PAWN);
+   board.board[1][1] = &pawn;
+   board.rescore();
+
+   // EXERCISE
+   bool fWhite = board.Board::hasNonPawnMaterial(true);
+
+   // VERIFY
+   assertUnit(fWhite == false);
+
+   // TEARDOWN
+   board.board[1][1] = nullptr;
+}
+
+/*************************************
+ * HAS NON PAWN MATERIAL : knight
+ * +---a-b-c-d-e-f-g-h---+
+ * |                     |
+ * 8                     8
+ * 7                     7
+ * 6                     6
+ * 5                     5
+ * 4                     4
+ * 3                     3
+ * 2     p               2
+ * 1   n                 1
+ * |                     |
+ * +---a-b-c-d-e-f-g-h---+
+ **************************************/
+void TestSearch::hasNonPawnMaterial_knight()
+{
+   // SETUP
+   BoardEmpty board;
+   White pawn(PAWN);
+   White knight(KNIGHT);
+   board.board[1][1] = &pawn;
+   board.board[0][0] = &knight;
+   board.rescore();
+
+   // EXERCISE
+   bool fWhite = board.Board::hasNonPawnMaterial(true);
+   bool fBlack = board.Board::hasNonPawnMaterial(false);
+
+   // VERIFY
+   assertUnit(fWhite == true);
+   assertUnit(fBlack == false);
+
+   // TEARDOWN
+   board.board[1][1] = nullptr;
+   board.board[0][0] = nullptr;
+}
+
+/*************************************
+ * THINK : take the rook
+ * +---a-b-c-d-e-f-g-h---+
+ * |                     |
+ * 8     N         N     8
+ * 7             R       7
+ * 6                     6
+ * 5          (n)        5
+ * 4                     4
+ * 3                     3
+ * 2                     2
+ * 1     n         n     1
+ * |                     |
+ * +---a-b-c-d-e-f-g-h---+
+ **************************************/
+void TestSearch::think_capture()
+{
+   // SETUP
+   Board board;
+   delete board.board[4][4];
+   board.board[4][4] = new Knight(4, 4, true /*isWhite*/);
+   delete board.board[5][6];
+   board.board[5][6] = new Black(ROOK);
+   board.board[5][6]->position.set(5, 6);
+   board.rescore();
+   Search search(board);
+
+   // EXERCISE
+   Move move = search.think(3, 10000.0);
+
+   // VERIFY
+   assertUnit(move.getSource() == Position(4, 4));
+   assertUnit(move.getDest() == Position(5, 6));
+   assertUnit(search.getDepth() == 3);
+   assertUnit(search.getScore() > 0);
+}  // TEARDOWN
+
+/*************************************
+ * THINK : take the rook without the selective search
+ * Same position as think_capture
+ **************************************/
+void TestSearch::think_capturePlain()
+{
+   // SETUP
+   Board board;
+   delete board.board[4][4];
+   board.board[4][4] = new Knight(4, 4, true /*isWhite*/);
+   delete board.board[5][6];
+   board.board[5][6] = new Black(ROOK);
+   board.board[5][6]->position.set(5, 6);
+   board.rescore();
+   Search search(board);
+   search.useNullMove = false;
+   search.useLateMoveReductions = false;
+
+   // EXERCISE
+   Move move = search.think(3, 10000.0);
+
+   // VERIFY
+   assertUnit(move.getSource() == Position(4, 4));
+   assertUnit(move.getDest() == Position(5, 6));
+}  // TEARDOWN
+
+/*************************************
+ * THINK : the board is left as it was found
+ * Input:  the starting position
+ * Output: the knights are where they started, white to move
+ **************************************/
+void TestSearch::think_restoresBoard()
+{
+   // SETUP
+   Board board;
+   Search search(board);
+
+   // EXERCISE
+   search.think(4, 10000.0);
+
+   // VERIFY
+   assertUnit(board.getCurrentMove() == 0);
+   assertUnit(board.history.empty());
+   assertUnit(board.board[1][0]->getType() == KNIGHT);
+   assertUnit(board.board[6][0]->getType() == KNIGHT);
+   assertUnit(board.board[1][7]->getType() == KNIGHT);
+   assertUnit(board.board[6][7]->getType() == KNIGHT);
+   assertUnit(board.board[1][0]->getNMoves() == 0);
+}  // TEARDOWN
+
+/*************************************
+ * EVALUATE : no pawns
+ * Input:  the start position, which has no pawns
+ * Output: the pawn table is never asked
+ **************************************/
+void TestSearch::evaluate_noPawns()
+{
+   // SETUP
+   Board board;
+   Search search(board);
+
+   // EXERCISE
+   search.evaluate();
+
+   // VERIFY
+   assertUnit(search.getPawnProbes() == 0);
+}  // TEARDOWN
+
+/*************************************
+ * EVALUATE : pawn hit
+ * Input:  the start position with a white pawn on d2,
+ *         evaluated twice
+ * Output: the first misses and the second hits, with
+ *         the same value
+ **************************************/
+void TestSearch::evaluate_pawnHit()
+{
+   // SETUP
+   Board board;
+   delete board.board[3][1];
+   board.board[3][1] = new White(PAWN);
+   board.board[3][1]->position.set(3, 1);
+   board.rescore();
+   Search search(board);
+
+   // EXERCISE
+   int valueMiss = search.evaluate();
+   int valueHit  = search.evaluate();
+
+   // VERIFY
+   assertUnit(search.getPawnProbes() == 2);
+   assertUnit(search.getPawnHitRate() == 0.5);
+   assertUnit(valueMiss == valueHit);
+}  // TEARDOWN
@@ -0,0 +1,55 @@
+/***********************************************************************
+ * Header File:
+ *    TEST SEARCH
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for Search
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * SEARCH TEST
+ * Test the Search class
+ ***************************************************/
+class TestSearch : public UnitTest
+{
+public:
+   void run()
+   {
+      // reductions
+      runTest(reduction_early);
+      runTest(reduction_grows);
+
+      // null move guard
+      runTest(hasNonPawnMaterial_pawnsOnly);
+      runTest(hasNonPawnMaterial_knight);
+
+      // think
+      runTest(think_capture);
+      runTest(think_capturePlain);
+      runTest(think_restoresBoard);
+
+      // evaluate
+      runTest(evaluate_noPawns);
+      runTest(evaluate_pawnHit);
+
+      report("Search");
+   }
+private:
+   void reduction_early();
+   void reduction_grows();
+
+   void hasNonPawnMaterial_pawnsOnly();
+   void hasNonPawnMaterial_knight();
+
+   void think_capture();
+   void think_capturePlain();
+   void think_restoresBoard();
+
+   void evaluate_noPawns();
+   void evaluate_pawnHit();
+};
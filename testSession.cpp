@@ -0,0 +1,816 @@
+/***********************************************************************
+ * Source File:
+ *    TEST SESSION
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the session server
+ ************************************************************************/
+
+#include "testSession.h"
+#include "session.h"
+#include "sessionSocket.h"
+#include "loadGenerator.h"
+#include "threadPool.h"
+#include "pieceFlyweight.h"
+#include <string>     // for STRING of the FEN and report
+#include <thread>     // for THREAD running the socket
+#include <chrono>     // for MILLISECONDS waiting on a slow client
+#include <sstream>    // for OSTRINGSTREAM of the load report
+#ifndef _WIN32
+#include <unistd.h>   // for GETPID
+#endif
+using namespace std;
+
+// one request through the server, its response decoded
+static Response call(SessionServer & server, uint8_t type, uint32_t session,
+                     const void * payload = nullptr, size_t sizePayload = 0)
+{
+   vector <uint8_t> request;
+   vector <uint8_t> bytes;
+   encodeRequest(request, type, 42 /*tag*/, session, payload, sizePayload);
+   server.handle(request.data(), request.size(), bytes);
+   Response response = { 0xFF, 0xFF, 0, {} };
+   decodeResponse(bytes.data(), bytes.size(), response);
+   return response;
+}
+
+// a new game from the start
+static uint32_t start(SessionServer & server)
+{
+   Response response = call(server, REQUEST_NEW, 0);
+   return response.payload.size() == 4 ? response.payload[0] | (response.payload[1] << 8) |
+          (response.payload[2] << 16) | (uint32_t(response.payload[3]) << 24) : 0;
+}
+
+/*************************************
+ * ENCODE : round trip
+ * Input:  a request and a response with payloads
+ * Output: decoded just as they went in
+ **************************************/
+void TestSession::encode_roundTrip()
+{
+   // SETUP
+   const uint8_t payload[] = { 6, 21 };
+   vector <uint8_t> bytesRequest;
+   vector <uint8_t> bytesResponse;
+   Request request;
+   Response response;
+
+   // EXERCISE
+   encodeRequest(bytesRequest, REQUEST_MOVE, 0x01020304, 0xA0B0C0D0, payload, 2);
+   bool fRequest = decodeRequest(bytesRequest.data(), bytesRequest.size(), request);
+   encodeResponse(bytesResponse, REQUEST_QUERY, STATUS_ILLEGAL, 0xFFFFFFFF, payload, 2);
+   bool fResponse = decodeResponse(bytesResponse.data(), bytesResponse.size(), response);
+
+   // VERIFY
+   assertUnit(fRequest);
+   assertUnit(bytesRequest.size() == SIZE_REQUEST_HEADER + 2);
+   assertUnit(bytesRequest[0] == SIZE_REQUEST_HEADER);       // little-endian
+   assertUnit(bytesRequest[1] == 0);
+   assertUnit(request.type == REQUEST_MOVE);
+   assertUnit(request.tag == 0x01020304);
+   assertUnit(request.session == 0xA0B0C0D0);
+   assertUnit(request.sizePayload == 2);
+   assertUnit(request.payload[0] == 6 && request.payload[1] == 21);
+   assertUnit(fResponse);
+   assertUnit(bytesResponse.size() == SIZE_RESPONSE_HEADER + 2);
+   assertUnit(response.type == REQUEST_QUERY);
+   assertUnit(response.status == STATUS_ILLEGAL);
+   assertUnit(response.tag == 0xFFFFFFFF);
+   assertUnit(response.payload == vector <uint8_t> (payload, payload + 2));
+}
+
+/*************************************
+ * DECODE : short
+ * Input:  a request cut short, and one with extra
+ * Output: neither decodes, and the frame size says
+ *         how much is still to come
+ **************************************/
+void TestSession::decode_short()
+{
+   // SETUP
+   vector <uint8_t> bytes;
+   encodeRequest(bytes, REQUEST_QUERY, 1, 1, nullptr, 0);
+   Request request;
+
+   // EXERCISE
+   bool fShort = decodeRequest(bytes.data(), bytes.size() - 1, request);
+   size_t sizeOne = frameSize(bytes.data(), 1);
+   size_t sizeTwo = frameSize(bytes.data(), 2);
+   bytes.push_back(0);
+   bool fLong = decodeRequest(bytes.data(), bytes.size(), request);
+
+   // VERIFY
+   assertUnit(!fShort);
+   assertUnit(!fLong);
+   assertUnit(sizeOne == 0);
+   assertUnit(sizeTwo == SIZE_REQUEST_HEADER);
+}
+
+/*************************************
+ * TABLE : create find
+ * Input:  forty games, then one erased
+ * Output: each has its own id and board, spread
+ *         over the shards, and the erased is gone
+ **************************************/
+void TestSession::table_createFind()
+{
+   // SETUP
+   SessionTable table;
+   vector <uint32_t> ids;
+
+   // EXERCISE
+   for (int i = 0; i < 40; i++)
+      ids.push_back(table.create(""));
+   shared_ptr <Session> pKept = table.find(ids[3]);
+   bool fErased = table.erase(ids[3]);
+   bool fErasedAgain = table.erase(ids[3]);
+
+   // VERIFY
+   assertUnit(table.size() == 39);
+   assertUnit(fErased);
+   assertUnit(!fErasedAgain);
+   assertUnit(table.find(ids[3]) == nullptr);
+   assertUnit(pKept != nullptr);                  // still ours to finish with
+   assertUnit(pKept->board.getCurrentMove() == 0);
+   bool fAllFound = true;
+   for (int i = 0; i < 40; i++)
+      fAllFound = fAllFound && ids[i] != 0 && (i == 3 || table.find(ids[i]) != nullptr);
+   assertUnit(fAllFound);
+   assertUnit(table.find(ids[0]) != table.find(ids[1]));
+   int numShards = 0;
+   for (int s = 0; s < SessionTable::NUM_SHARDS; s++)
+      numShards += table.shards[s].sessions.empty() ? 0 : 1;
+   assertUnit(numShards == SessionTable::NUM_SHARDS);
+}
+
+/*************************************
+ * HANDLE : new
+ * Input:  the start, a FEN, and nonsense
+ * Output: two games and a refusal
+ **************************************/
+void TestSession::handle_new()
+{
+   // SETUP
+   SessionServer server;
+   string fen = "8/8/4n3/8/3N4/8/8/8 b - - 0 1";
+
+   // EXERCISE
+   Response responseStart = call(server, REQUEST_NEW, 0);
+   Response responseFen = call(server, REQUEST_NEW, 0, fen.data(), fen.size());
+   Response responseBad = call(server, REQUEST_NEW, 0, "nonsense", 8);
+
+   // VERIFY
+   assertUnit(responseStart.type == REQUEST_NEW);
+   assertUnit(responseStart.status == STATUS_OK);
+   assertUnit(responseStart.tag == 42);
+   assertUnit(responseStart.payload.size() == 4);
+   assertUnit(responseFen.status == STATUS_OK);
+   assertUnit(responseFen.payload != responseStart.payload);
+   assertUnit(responseBad.status == STATUS_ILLEGAL);
+   assertUnit(responseBad.payload.empty());
+   assertUnit(server.sessions.size() == 2);
+}
+
+/*************************************
+ * HANDLE : move
+ * Input:  g1f3 from the start
+ * Output: the knight is on f3 and it is black's turn
+ **************************************/
+void TestSession::handle_move()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   const uint8_t g1f3[] = { 6, 21 };
+
+   // EXERCISE
+   Response response = call(server, REQUEST_MOVE, id, g1f3, 2);
+
+   // VERIFY
+   assertUnit(response.status == STATUS_OK);
+   assertUnit(response.payload.empty());
+   const Board & board = server.sessions.find(id)->board;
+   assertUnit(board.getCurrentMove() == 1);
+   assertUnit(board.getSquares()[6] == SPACE);
+   assertUnit(board.getSquares()[21] == squareCode(KNIGHT, true));
+}
+
+/*************************************
+ * HANDLE : move illegal
+ * Input:  g1g3, and a black move on white's turn
+ * Output: both refused, the board untouched
+ **************************************/
+void TestSession::handle_moveIllegal()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   const uint8_t g1g3[] = { 6, 22 };
+   const uint8_t b8c6[] = { 57, 42 };
+
+   // EXERCISE
+   Response responseShape = call(server, REQUEST_MOVE, id, g1g3, 2);
+   Response responseTurn = call(server, REQUEST_MOVE, id, b8c6, 2);
+
+   // VERIFY
+   assertUnit(responseShape.status == STATUS_ILLEGAL);
+   assertUnit(responseTurn.status == STATUS_ILLEGAL);
+   const Board & board = server.sessions.find(id)->board;
+   assertUnit(board.getCurrentMove() == 0);
+   assertUnit(board.getSquares()[6] == squareCode(KNIGHT, true));
+}
+
+/*************************************
+ * HANDLE : validate
+ * Input:  g1f3 and g1g3, only validated
+ * Output: yes and no, and the board untouched
+ **************************************/
+void TestSession::handle_validate()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   const uint8_t g1f3[] = { 6, 21 };
+   const uint8_t g1g3[] = { 6, 22 };
+
+   // EXERCISE
+   Response responseLegal = call(server, REQUEST_VALIDATE, id, g1f3, 2);
+   Response responseIllegal = call(server, REQUEST_VALIDATE, id, g1g3, 2);
+
+   // VERIFY
+   assertUnit(responseLegal.type == REQUEST_VALIDATE);
+   assertUnit(responseLegal.status == STATUS_OK);
+   assertUnit(responseIllegal.status == STATUS_ILLEGAL);
+   const Board & board = server.sessions.find(id)->board;
+   assertUnit(board.getCurrentMove() == 0);
+   assertUnit(board.getSquares()[6] == squareCode(KNIGHT, true));
+   assertUnit(board.getSquares()[21] == SPACE);
+}
+
+/*************************************
+ * HANDLE : query
+ * Input:  the start after g1f3
+ * Output: every square, black to move, one move made
+ **************************************/
+void TestSession::handle_query()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   const uint8_t g1f3[] = { 6, 21 };
+   call(server, REQUEST_MOVE, id, g1f3, 2);
+
+   // EXERCISE
+   Response response = call(server, REQUEST_QUERY, id);
+
+   // VERIFY
+   assertUnit(response.status == STATUS_OK);
+   assertUnit(response.payload.size() == 64 + 1 + 2);
+   const uint8_t * squares = server.sessions.find(id)->board.getSquares();
+   assertUnit(vector <uint8_t> (response.payload.begin(), response.payload.begin() + 64) ==
+              vector <uint8_t> (squares, squares + 64));
+   assertUnit(response.payload[21] == squareCode(KNIGHT, true));
+   assertUnit(response.payload[64] == 0);           // black to move
+   assertUnit(response.payload[65] == 1);
+   assertUnit(response.payload[66] == 0);
+}
+
+/*************************************
+ * HANDLE : close
+ * Input:  a game closed twice
+ * Output: gone the first time, not there the second
+ **************************************/
+void TestSession::handle_close()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+
+   // EXERCISE
+   Response responseFirst = call(server, REQUEST_CLOSE, id);
+   Response responseSecond = call(server, REQUEST_CLOSE, id);
+
+   // VERIFY
+   assertUnit(responseFirst.status == STATUS_OK);
+   assertUnit(responseSecond.status == STATUS_NO_SESSION);
+   assertUnit(server.sessions.size() == 0);
+}
+
+/*************************************
+ * HANDLE : no session
+ * Input:  a move and a query for a game never made
+ * Output: both say there is no such game
+ **************************************/
+void TestSession::handle_noSession()
+{
+   // SETUP
+   SessionServer server;
+   const uint8_t g1f3[] = { 6, 21 };
+
+   // EXERCISE
+   Response responseMove = call(server, REQUEST_MOVE, 12345, g1f3, 2);
+   Response responseQuery = call(server, REQUEST_QUERY, 12345);
+
+   // VERIFY
+   assertUnit(responseMove.status == STATUS_NO_SESSION);
+   assertUnit(responseQuery.status == STATUS_NO_SESSION);
+   assertUnit(responseQuery.payload.empty());
+}
+
+/*************************************
+ * HANDLE : bad request
+ * Input:  an unknown type, a move with one square,
+ *         a square off the board, and a frame too short
+ * Output: each one a bad request
+ **************************************/
+void TestSession::handle_badRequest()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   const uint8_t offBoard[] = { 6, 64 };
+   const uint8_t tooShort[] = { 1, 0, REQUEST_QUERY };
+   vector <uint8_t> bytes;
+   Response responseShort;
+
+   // EXERCISE
+   Response responseType = call(server, REQUEST_NUM, id);
+   Response responseOne = call(server, REQUEST_MOVE, id, offBoard, 1);
+   Response responseOff = call(server, REQUEST_VALIDATE, id, offBoard, 2);
+   server.handle(tooShort, sizeof(tooShort), bytes);
+   bool fDecoded = decodeResponse(bytes.data(), bytes.size(), responseShort);
+
+   // VERIFY
+   assertUnit(responseType.status == STATUS_BAD_REQUEST);
+   assertUnit(responseType.tag == 42);
+   assertUnit(responseOne.status == STATUS_BAD_REQUEST);
+   assertUnit(responseOff.status == STATUS_BAD_REQUEST);
+   assertUnit(fDecoded);
+   assertUnit(responseShort.status == STATUS_BAD_REQUEST);
+   assertUnit(server.sessions.find(id)->board.getCurrentMove() == 0);
+}
+
+/*************************************
+ * HANDLE : latency
+ * Input:  a new game, three moves, and a query
+ * Output: counted by type, and the report has a line
+ *         for each type used
+ **************************************/
+void TestSession::handle_latency()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   const uint8_t moves[3][2] = { { 6, 21 }, { 57, 42 }, { 21, 36 } };
+
+   // EXERCISE
+   for (int i = 0; i < 3; i++)
+      call(server, REQUEST_MOVE, id, moves[i], 2);
+   call(server, REQUEST_QUERY, id);
+   Response response = call(server, REQUEST_STATS, 0);
+
+   // VERIFY
+   assertUnit(server.getLatency(REQUEST_NEW).getCount() == 1);
+   assertUnit(server.getLatency(REQUEST_MOVE).getCount() == 3);
+   assertUnit(server.getLatency(REQUEST_QUERY).getCount() == 1);
+   assertUnit(server.getLatency(REQUEST_VALIDATE).getCount() == 0);
+   assertUnit(server.getLatency(REQUEST_MOVE).percentile(0.99) > 0.0);
+   string text(response.payload.begin(), response.payload.end());
+   assertUnit(response.status == STATUS_OK);
+   assertUnit(text.find("p99") != string::npos);
+   assertUnit(text.find("move") != string::npos);
+   assertUnit(text.find("query") != string::npos);
+   assertUnit(text.find("validate") == string::npos);
+}
+
+// the FEN after making smith on fen, or empty if it is not legal
+static string after(const string & fen, const string & smith)
+{
+   Board board(nullptr, true /*noreset*/);
+   board.setFen(fen);
+   MoveList moves;
+   board.getMoves(moves, board.whiteTurn());
+   for (const Move & move : moves)
+      if (move.getSource() == Position(smith.substr(0, 2).c_str()) &&
+          move.getDest()   == Position(smith.substr(2, 2).c_str()))
+      {
+         board.move(move);
+         return board.getFen();
+      }
+   return string();
+}
+
+/*************************************
+ * BATCH : encode round trip
+ * Input:  a FEN item and a session item, then the
+ *         same bytes cut short; results likewise
+ * Output: decoded as they went in; short fails
+ **************************************/
+void TestSession::batch_encodeRoundTrip()
+{
+   // SETUP
+   vector <BatchItem> items = { { 0, "8/8/8/8/3N4/8/8/8 w - - 0 1", "d4e6" },
+                                { 77, "", "g1f3" } };
+   vector <BatchResult> results = { { STATUS_OK, "8/8/4N3/8/8/8/8/8 b - - 0 1" },
+                                    { STATUS_ILLEGAL, "" } };
+   vector <uint8_t> payload;
+   vector <uint8_t> payloadResults;
+   vector <BatchItem> itemsDecoded;
+   vector <BatchResult> resultsDecoded;
+
+   // EXERCISE
+   encodeBatch(payload, items);
+   bool fItems = decodeBatch(payload.data(), payload.size(), itemsDecoded);
+   bool fShort = decodeBatch(payload.data(), payload.size() - 1, itemsDecoded);
+   bool fEncoded = encodeBatchResults(payloadResults, results);
+   bool fResults = decodeBatchResults(payloadResults.data(), payloadResults.size(), resultsDecoded);
+
+   // VERIFY
+   assertUnit(payload.size() == 2 + (4 + 1 + 27 + 1 + 4) + (4 + 1 + 0 + 1 + 4));
+   assertUnit(fItems);
+   assertUnit(!fShort);
+   assertUnit(fEncoded);
+   assertUnit(fResults);
+   assertUnit(resultsDecoded.size() == 2);
+   assertUnit(resultsDecoded[0].status == STATUS_OK);
+   assertUnit(resultsDecoded[0].fen == results[0].fen);
+   assertUnit(resultsDecoded[1].status == STATUS_ILLEGAL);
+   assertUnit(resultsDecoded[1].fen.empty());
+   decodeBatch(payload.data(), payload.size(), itemsDecoded);
+   assertUnit(itemsDecoded.size() == 2);
+   assertUnit(itemsDecoded[0].session == 0);
+   assertUnit(itemsDecoded[0].fen == items[0].fen);
+   assertUnit(itemsDecoded[0].move == "d4e6");
+   assertUnit(itemsDecoded[1].session == 77);
+   assertUnit(itemsDecoded[1].fen.empty());
+}
+
+/*************************************
+ * BATCH : fen
+ * Input:  a legal move, an illegal one, a FEN we
+ *         cannot read, and a move that is not Smith
+ * Output: the position after the legal one; the
+ *         others refused with no position
+ **************************************/
+void TestSession::batch_fen()
+{
+   // SETUP
+   SessionServer server;
+   string fen = "8/8/2n1n3/8/3N4/8/1N3n2/8 w - - 0 1";
+   vector <BatchItem> items = { { 0, fen, "d4e6" },
+                                { 0, fen, "d4d5" },
+                                { 0, "nonsense", "d4e6" },
+                                { 0, fen, "d4" } };
+   vector <BatchResult> results;
+
+   // EXERCISE
+   server.batch(items, results);
+
+   // VERIFY
+   assertUnit(results.size() == 4);
+   assertUnit(results[0].status == STATUS_OK);
+   assertUnit(results[0].fen == after(fen, "d4e6"));
+   assertUnit(!results[0].fen.empty());
+   assertUnit(results[1].status == STATUS_ILLEGAL);
+   assertUnit(results[1].fen.empty());
+   assertUnit(results[2].status == STATUS_BAD_REQUEST);
+   assertUnit(results[3].status == STATUS_BAD_REQUEST);
+   assertUnit(server.sessions.size() == 0);
+}
+
+/*************************************
+ * BATCH : session
+ * Input:  g1f3 on a game, and on a game never made
+ * Output: the game moves and we get its position;
+ *         the other has no game
+ **************************************/
+void TestSession::batch_session()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   vector <BatchItem> items = { { id, "", "g1f3" }, { id + 1, "", "g1f3" } };
+   vector <BatchResult> results;
+
+   // EXERCISE
+   server.batch(items, results);
+
+   // VERIFY
+   const Board & board = server.sessions.find(id)->board;
+   assertUnit(results[0].status == STATUS_OK);
+   assertUnit(results[0].fen == board.getFen());
+   assertUnit(board.getCurrentMove() == 1);
+   assertUnit(board.getSquares()[21] == squareCode(KNIGHT, true));
+   assertUnit(results[1].status == STATUS_NO_SESSION);
+   assertUnit(results[1].fen.empty());
+}
+
+/*************************************
+ * BATCH : parallel
+ * Input:  a thousand items with a pool of four
+ * Output: the same answers as one thread alone
+ **************************************/
+void TestSession::batch_parallel()
+{
+   // SETUP
+   const char * fens[] = { "8/8/2n1n3/8/3N4/8/1N3n2/8 w - - 0 1",
+                           "1n4n1/8/8/8/8/8/8/1N4N1 b - - 0 1" };
+   const char * smiths[] = { "d4e6", "b2c4", "b8c6", "g8f6", "a1a2" };
+   vector <BatchItem> items;
+   for (int i = 0; i < 1000; i++)
+      items.push_back({ 0, fens[i % 2], smiths[i % 5] });
+   SessionServer serverAlone;
+   SessionServer serverPool;
+   ThreadPool pool(4);
+   serverPool.setPool(&pool);
+   vector <BatchResult> resultsAlone;
+   vector <BatchResult> resultsPool;
+
+   // EXERCISE
+   serverAlone.batch(items, resultsAlone);
+   serverPool.batch(items, resultsPool);
+   pool.wait();
+
+   // VERIFY
+   assertUnit(resultsPool.size() == 1000);
+   bool fSame = true;
+   int numLegal = 0;
+   for (int i = 0; i < 1000; i++)
+   {
+      fSame = fSame && resultsPool[i].status == resultsAlone[i].status &&
+                       resultsPool[i].fen == resultsAlone[i].fen;
+      numLegal += resultsPool[i].status == STATUS_OK ? 1 : 0;
+   }
+   assertUnit(fSame);
+   assertUnit(numLegal == 400);      // d4e6 and b2c4 for white, b8c6 and g8f6 for black
+}
+
+/*************************************
+ * HANDLE : batch
+ * Input:  a batch request, and one cut short
+ * Output: the results in the response; the short
+ *         one a bad request, counted as a batch
+ **************************************/
+void TestSession::handle_batch()
+{
+   // SETUP
+   SessionServer server;
+   string fen = "8/8/8/8/3N4/8/8/8 w - - 0 1";
+   vector <BatchItem> items = { { 0, fen, "d4e6" }, { 0, fen, "d4d6" } };
+   vector <uint8_t> payload;
+   encodeBatch(payload, items);
+   vector <BatchResult> results;
+
+   // EXERCISE
+   Response response = call(server, REQUEST_BATCH, 0, payload.data(), payload.size());
+   Response responseShort = call(server, REQUEST_BATCH, 0, payload.data(), payload.size() - 1);
+
+   // VERIFY
+   assertUnit(response.type == REQUEST_BATCH);
+   assertUnit(response.status == STATUS_OK);
+   assertUnit(decodeBatchResults(response.payload.data(), response.payload.size(), results));
+   assertUnit(results.size() == 2);
+   assertUnit(results[0].status == STATUS_OK);
+   assertUnit(results[0].fen == after(fen, "d4e6"));
+   assertUnit(results[1].status == STATUS_ILLEGAL);
+   assertUnit(responseShort.status == STATUS_BAD_REQUEST);
+   assertUnit(server.getLatency(REQUEST_BATCH).getCount() == 2);
+}
+
+/*************************************
+ * HANDLE : batch too big
+ * Input:  one more than NUM_BATCH_MAX items, the
+ *         first a move on a game; then exactly
+ *         NUM_BATCH_MAX items
+ * Output: the first refused with the game unmoved;
+ *         the second answered in full
+ **************************************/
+void TestSession::handle_batchTooBig()
+{
+   // SETUP
+   SessionServer server;
+   uint32_t id = start(server);
+   string fen = "8/8/8/8/3N4/8/8/8 w - - 0 1";
+   vector <BatchItem> items(NUM_BATCH_MAX + 1, BatchItem{ 0, fen, "d4e6" });
+   items[0] = BatchItem{ id, "", "g1f3" };
+   vector <uint8_t> payloadBig;
+   encodeBatch(payloadBig, items);
+   items.pop_back();
+   vector <uint8_t> payloadMax;
+   encodeBatch(payloadMax, items);
+   vector <BatchResult> results;
+
+   // EXERCISE
+   Response responseBig = call(server, REQUEST_BATCH, 0, payloadBig.data(), payloadBig.size());
+   int numMovesBig = server.sessions.find(id)->board.getCurrentMove();
+   Response responseMax = call(server, REQUEST_BATCH, 0, payloadMax.data(), payloadMax.size());
+
+   // VERIFY
+   assertUnit(responseBig.status == STATUS_BAD_REQUEST);
+   assertUnit(responseBig.payload.empty());
+   assertUnit(numMovesBig == 0);
+   assertUnit(responseMax.status == STATUS_OK);
+   assertUnit(decodeBatchResults(responseMax.payload.data(), responseMax.payload.size(), results));
+   assertUnit(results.size() == NUM_BATCH_MAX);
+   assertUnit(results[0].status == STATUS_OK);
+   assertUnit(results[NUM_BATCH_MAX - 1].fen == after(fen, "d4e6"));
+   assertUnit(server.sessions.find(id)->board.getCurrentMove() == 1);
+}
+
+/*************************************
+ * SOCKET : round trip
+ * Input:  a client on a Unix domain socket makes a
+ *         game, makes a move for each side, and
+ *         queries
+ * Output: every response matched to its request by
+ *         tag, and the game is where the moves left it
+ **************************************/
+void TestSession::socket_roundTrip()
+{
+#ifndef _WIN32
+   // SETUP
+   string path = "/tmp/testSession." + to_string(getpid()) + ".sock";
+   SessionServer server;
+   SocketServer socketServer(server, 2);
+   bool fListen = socketServer.listen(path);
+   thread threadServer([&socketServer]() { socketServer.run(); });
+   SessionClient client;
+   bool fConnect = client.connect(path);
+   const uint8_t g1f3[] = { 6, 21 };
+   const uint8_t g8f6[] = { 62, 45 };
+   Response responseNew;
+   Response responseMoves[2];
+   Response responseQuery;
+
+   // EXERCISE
+   bool fNew = client.call(REQUEST_NEW, 0, responseNew);
+   uint32_t id = responseNew.payload.size() == 4 ? responseNew.payload[0] |
+                 (responseNew.payload[1] << 8) | (responseNew.payload[2] << 16) |
+                 (uint32_t(responseNew.payload[3]) << 24) : 0;
+   uint32_t tagFirst = client.send(REQUEST_MOVE, id, g1f3, 2);
+   bool fReceived = client.receive(responseMoves[0]);
+   uint32_t tagSecond = client.send(REQUEST_MOVE, id, g8f6, 2);
+   fReceived = client.receive(responseMoves[1]) && fReceived;
+   bool fQuery = client.call(REQUEST_QUERY, id, responseQuery);
+   client.close();
+   socketServer.stop();
+   threadServer.join();
+
+   // VERIFY
+   assertUnit(fListen);
+   assertUnit(fConnect);
+   assertUnit(fNew);
+   assertUnit(responseNew.status == STATUS_OK);
+   assertUnit(tagFirst != 0 && tagSecond != 0 && tagFirst != tagSecond);
+   assertUnit(fReceived);
+   assertUnit(responseMoves[0].tag == tagFirst);
+   assertUnit(responseMoves[0].status == STATUS_OK);
+   assertUnit(responseMoves[1].tag == tagSecond);
+   assertUnit(responseMoves[1].status == STATUS_OK);
+   assertUnit(fQuery);
+   assertUnit(responseQuery.payload.size() == 67);
+   assertUnit(responseQuery.payload[21] == squareCode(KNIGHT, true));
+   assertUnit(responseQuery.payload[45] == squareCode(KNIGHT, false));
+   assertUnit(responseQuery.payload[64] == 1);      // white to move
+   assertUnit(server.getLatency(REQUEST_MOVE).getCount() == 2);
+#endif // !_WIN32
+}
+
+/*************************************
+ * SOCKET : slow reader
+ * Input:  one client sends thousands of requests
+ *         and reads none of the answers until the
+ *         server stops answering it; then another
+ *         client makes a game
+ * Output: the other is answered though nobody reads
+ *         the first; the first then gets every answer
+ **************************************/
+void TestSession::socket_slowReader()
+{
+#ifndef _WIN32
+   // SETUP
+   const int numSent = 4000;
+   string path = "/tmp/testSession." + to_string(getpid()) + ".slow.sock";
+   SessionServer server;
+   SocketServer socketServer(server, 2);
+   socketServer.listen(path);
+   thread threadServer([&socketServer]() { socketServer.run(); });
+   SessionClient clientSlow;
+   SessionClient clientOther;
+   bool fConnect = clientSlow.connect(path) && clientOther.connect(path);
+   Response response;
+
+   // EXERCISE
+   bool fSent = true;
+   thread threadSlow([&clientSlow, &fSent, numSent]()
+   {
+      for (int i = 0; i < numSent; i++)
+         fSent = clientSlow.send(REQUEST_STATS, 0) != 0 && fSent;
+   });
+   uint64_t count = 0;
+   for (int i = 0; i < 1000 && (count == 0 || count != server.getLatency(REQUEST_STATS).getCount()); i++)
+   {
+      count = server.getLatency(REQUEST_STATS).getCount();
+      this_thread::sleep_for(chrono::milliseconds(2));
+   }
+   bool fOther = clientOther.call(REQUEST_NEW, 0, response);
+   uint8_t statusOther = response.status;
+   int numReceived = 0;
+   while (numReceived < numSent && clientSlow.receive(response))
+      numReceived++;
+   threadSlow.join();
+   clientSlow.close();
+   clientOther.close();
+   socketServer.stop();
+   threadServer.join();
+
+   // VERIFY
+   assertUnit(fConnect);
+   assertUnit(fSent);
+   assertUnit(fOther);
+   assertUnit(statusOther == STATUS_OK);
+   assertUnit(numReceived == numSent);
+   assertUnit(server.getLatency(REQUEST_STATS).getCount() == uint64_t(numSent));
+#endif // !_WIN32
+}
+
+/*************************************
+ * SOCKET : half close
+ * Input:  a client sends more requests than the
+ *         server takes at once, then says it will
+ *         send no more before reading any answer
+ * Output: every request is answered, then the
+ *         server closes the connection
+ **************************************/
+void TestSession::socket_halfClose()
+{
+#ifndef _WIN32
+   // SETUP
+   const int numSent = 200;
+   string path = "/tmp/testSession." + to_string(getpid()) + ".half.sock";
+   SessionServer server;
+   SocketServer socketServer(server, 2);
+   socketServer.listen(path);
+   thread threadServer([&socketServer]() { socketServer.run(); });
+   SessionClient client;
+   bool fConnect = client.connect(path);
+   bool fSent = true;
+   for (int i = 0; i < numSent; i++)
+      fSent = client.send(REQUEST_STATS, 0) != 0 && fSent;
+   Response response;
+
+   // EXERCISE
+   bool fFinish = client.finish();
+   int numReceived = 0;
+   while (numReceived < numSent && client.receive(response))
+      numReceived++;
+   bool fMore = client.receive(response);
+   client.close();
+   socketServer.stop();
+   threadServer.join();
+
+   // VERIFY
+   assertUnit(fConnect);
+   assertUnit(fSent);
+   assertUnit(fFinish);
+   assertUnit(numReceived == numSent);
+   assertUnit(fMore == false);
+#endif // !_WIN32
+}
+
+/*************************************
+ * SOCKET : load
+ * Input:  two clients sending batches of 16 for a
+ *         tenth of a second, then a socket nobody
+ *         listens on
+ * Output: validations every second and a report;
+ *         nothing from the other
+ **************************************/
+void TestSession::socket_load()
+{
+#ifndef _WIN32
+   // SETUP
+   string path = "/tmp/testSession." + to_string(getpid()) + ".load.sock";
+   SessionServer server;
+   SocketServer socketServer(server, 2);
+   socketServer.listen(path);
+   thread threadServer([&socketServer]() { socketServer.run(); });
+   ostringstream out;
+   ostringstream outNobody;
+
+   // EXERCISE
+   double perSecond = loadGenerate(path, 2, 16, 0.1, out);
+   double perSecondNobody = loadGenerate(path + ".nobody", 1, 16, 0.1, outNobody);
+   socketServer.stop();
+   threadServer.join();
+
+   // VERIFY
+   assertUnit(perSecond > 0.0);
+   assertUnit(out.str().find("validations/sec") != string::npos);
+   assertUnit(server.getLatency(REQUEST_BATCH).getCount() > 0);
+   assertUnit(perSecondNobody == 0.0);
+   assertUnit(outNobody.str().find("cannot connect") != string::npos);
+#endif // !_WIN32
+}
@@ -0,0 +1,72 @@
+/***********************************************************************
+ * Header File:
+ *    TEST SESSION
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the session server
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * SESSION TEST
+ * Test the SessionTable, SessionServer, and the
+ * socket they are served on
+ ***************************************************/
+class TestSession : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(encode_roundTrip);
+      runTest(decode_short);
+      runTest(table_createFind);
+      runTest(handle_new);
+      runTest(handle_move);
+      runTest(handle_moveIllegal);
+      runTest(handle_validate);
+      runTest(handle_query);
+      runTest(handle_close);
+      runTest(handle_noSession);
+      runTest(handle_badRequest);
+      runTest(handle_latency);
+      runTest(batch_encodeRoundTrip);
+      runTest(batch_fen);
+      runTest(batch_session);
+      runTest(batch_parallel);
+      runTest(handle_batch);
+      runTest(handle_batchTooBig);
+      runTest(socket_roundTrip);
+      runTest(socket_slowReader);
+      runTest(socket_halfClose);
+      runTest(socket_load);
+
+      report("Session");
+   }
+private:
+   void encode_roundTrip();
+   void decode_short();
+   void table_createFind();
+   void handle_new();
+   void handle_move();
+   void handle_moveIllegal();
+   void handle_validate();
+   void handle_query();
+   void handle_close();
+   void handle_noSession();
+   void handle_badRequest();
+   void handle_latency();
+   void batch_encodeRoundTrip();
+   void batch_fen();
+   void batch_session();
+   void batch_parallel();
+   void handle_batch();
+   void handle_batchTooBig();
+   void socket_roundTrip();
+   void socket_slowReader();
+   void socket_halfClose();
+   void socket_load();
+};
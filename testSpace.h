@@ -23,10 +23,10 @@ public:
 
    void run()
    {
-      construct_a1();
-      construct_h8();
-      construct_a8();
-      getType();
+      runTest(construct_a1);
+      runTest(construct_h8);
+      runTest(construct_a8);
+      runTest(getType);
 
       report("Space");
    }
@@ -0,0 +1,148 @@
+/***********************************************************************
+ * Source File:
+ *    TEST SPSC QUEUE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the single-producer, single-consumer queue
+ ************************************************************************/
+
+#include "testSpscQueue.h"
+#include "spscQueue.h"
+#include <thread>     // for THREAD, the producer
+using namespace std;
+
+/*************************************
+ * POP : empty
+ * Input:  a new queue
+ * Output: nothing to pop, item untouched
+ **************************************/
+void TestSpscQueue::pop_empty()
+{
+   // SETUP
+   SpscQueue <int, 4> queue;
+   int item = 99;
+
+   // EXERCISE
+   bool fPopped = queue.pop(item);
+
+   // VERIFY
+   assertUnit(fPopped == false);
+   assertUnit(item == 99);
+   assertUnit(queue.empty());
+}  // TEARDOWN
+
+/*************************************
+ * PUSH : order
+ * Input:  push 1, 2, 3
+ * Output: pop 1, 2, 3, then nothing
+ **************************************/
+void TestSpscQueue::push_order()
+{
+   // SETUP
+   SpscQueue <int, 4> queue;
+   int items[3] = { 0, 0, 0 };
+
+   // EXERCISE
+   queue.push(1);
+   queue.push(2);
+   queue.push(3);
+   queue.pop(items[0]);
+   queue.pop(items[1]);
+   queue.pop(items[2]);
+
+   // VERIFY
+   assertUnit(items[0] == 1);
+   assertUnit(items[1] == 2);
+   assertUnit(items[2] == 3);
+   assertUnit(queue.empty());
+}  // TEARDOWN
+
+/*************************************
+ * PUSH : full
+ * Input:  a queue of size 4, push 4 items
+ * Output: it holds 3, the fourth is refused
+ **************************************/
+void TestSpscQueue::push_full()
+{
+   // SETUP
+   SpscQueue <int, 4> queue;
+
+   // EXERCISE
+   bool fPushed[4];
+   for (int i = 0; i < 4; i++)
+      fPushed[i] = queue.push(i);
+
+   // VERIFY
+   assertUnit(fPushed[0] && fPushed[1] && fPushed[2]);
+   assertUnit(fPushed[3] == false);
+   int item = -1;
+   queue.pop(item);
+   assertUnit(item == 0);
+   assertUnit(queue.push(3));
+}  // TEARDOWN
+
+/*************************************
+ * PUSH : wraps
+ * Input:  push and pop 10 items through a queue of 4
+ * Output: each comes out as it went in, and the
+ *         indices stay inside the array
+ **************************************/
+void TestSpscQueue::push_wraps()
+{
+   // SETUP
+   SpscQueue <int, 4> queue;
+   bool fInOrder = true;
+
+   // EXERCISE
+   for (int i = 0; i < 10; i++)
+   {
+      int item = -1;
+      queue.push(i);
+      queue.pop(item);
+      fInOrder = fInOrder && item == i;
+   }
+
+   // VERIFY
+   assertUnit(fInOrder);
+   assertUnit(queue.head < 4);
+   assertUnit(queue.tail < 4);
+   assertUnit(queue.head == queue.tail);
+}  // TEARDOWN
+
+/*************************************
+ * THREADS : every item once
+ * Input:  a producer thread pushes 0...99999 through
+ *         a small queue, retrying when it is full
+ * Output: the consumer sees every one, in order
+ **************************************/
+void TestSpscQueue::threads_everyItemOnce()
+{
+   // SETUP
+   const int NUM_ITEMS = 100000;
+   SpscQueue <int, 16> queue;
+   thread producer([&queue, NUM_ITEMS]
+   {
+      for (int i = 0; i < NUM_ITEMS; i++)
+         while (!queue.push(i))
+            this_thread::yield();
+   });
+
+   // EXERCISE
+   int next = 0;
+   bool fInOrder = true;
+   while (next < NUM_ITEMS)
+   {
+      int item;
+      if (queue.pop(item))
+         fInOrder = fInOrder && item == next++;
+      else
+         this_thread::yield();
+   }
+   producer.join();
+
+   // VERIFY
+   assertUnit(fInOrder);
+   assertUnit(next == NUM_ITEMS);
+   assertUnit(queue.empty());
+}  // TEARDOWN
@@ -0,0 +1,37 @@
+/***********************************************************************
+ * Header File:
+ *    TEST SPSC QUEUE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the single-producer, single-consumer queue
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * SPSC QUEUE TEST
+ * Test the SpscQueue class
+ ***************************************************/
+class TestSpscQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(pop_empty);
+      runTest(push_order);
+      runTest(push_full);
+      runTest(push_wraps);
+      runTest(threads_everyItemOnce);
+
+      report("SpscQueue");
+   }
+private:
+   void pop_empty();
+   void push_order();
+   void push_full();
+   void push_wraps();
+   void threads_everyItemOnce();
+};
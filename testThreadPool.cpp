@@ -0,0 +1,109 @@
+/***********************************************************************
+ * Source File:
+ *    TEST THREAD POOL
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the thread pool
+ ************************************************************************/
+
+#include "testThreadPool.h"
+#include "threadPool.h"
+#include <atomic>     // for ATOMIC counters
+#include <chrono>     // for MILLISECONDS
+#include <cassert>
+using namespace std;
+
+/*************************************
+ * CONSTRUCT : size
+ * Input:  3 threads
+ * Output: 3 threads
+ **************************************/
+void TestThreadPool::construct_size()
+{
+   // EXERCISE
+   ThreadPool pool(3);
+
+   // VERIFY
+   assertUnit(pool.size() == 3);
+}  // TEARDOWN
+
+/*************************************
+ * CONSTRUCT : default
+ * Input:  0 threads
+ * Output: at least one
+ **************************************/
+void TestThreadPool::construct_default()
+{
+   // EXERCISE
+   ThreadPool pool(0);
+
+   // VERIFY
+   assertUnit(pool.size() >= 1);
+}  // TEARDOWN
+
+/*************************************
+ * WAIT : all jobs
+ * Input:  100 jobs on 4 threads, each adds its number
+ * Output: after wait() every job has run exactly once
+ **************************************/
+void TestThreadPool::wait_allJobs()
+{
+   // SETUP
+   ThreadPool pool(4);
+   atomic <int> sum(0);
+   atomic <int> count(0);
+
+   // EXERCISE
+   for (int i = 1; i <= 100; i++)
+      pool.submit([&sum, &count, i] { sum += i; count++; });
+   pool.wait();
+
+   // VERIFY
+   assertUnit(count == 100);
+   assertUnit(sum == 5050);
+   assertUnit(pool.jobs.empty());
+   assertUnit(pool.numBusy == 0);
+}  // TEARDOWN
+
+/*************************************
+ * WAIT : empty
+ * Input:  no jobs
+ * Output: wait() returns right away
+ **************************************/
+void TestThreadPool::wait_empty()
+{
+   // SETUP
+   ThreadPool pool(2);
+
+   // EXERCISE
+   pool.wait();
+
+   // VERIFY
+   assertUnit(pool.jobs.empty());
+}  // TEARDOWN
+
+/*************************************
+ * DESTRUCT : finishes the queue
+ * Input:  slow jobs on one thread, no wait()
+ * Output: the destructor runs them all before returning
+ **************************************/
+void TestThreadPool::destruct_finishesQueue()
+{
+   // SETUP
+   atomic <int> count(0);
+
+   // EXERCISE
+   {
+      ThreadPool pool(1);
+      for (int i = 0; i < 5; i++)
+         pool.submit([&count]
+         {
+            this_thread::sleep_for(chrono::milliseconds(2));
+            count++;
+         });
+   }
+
+   // VERIFY
+   assertUnit(count == 5);
+}
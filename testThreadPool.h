@@ -0,0 +1,37 @@
+/***********************************************************************
+ * Header File:
+ *    TEST THREAD POOL
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the thread pool
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * THREAD POOL TEST
+ * Test the ThreadPool class
+ ***************************************************/
+class TestThreadPool : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(construct_size);
+      runTest(construct_default);
+      runTest(wait_allJobs);
+      runTest(wait_empty);
+      runTest(destruct_finishesQueue);
+
+      report("ThreadPool");
+   }
+private:
+   void construct_size();
+   void construct_default();
+   void wait_allJobs();
+   void wait_empty();
+   void destruct_finishesQueue();
+};
@@ -0,0 +1,247 @@
+/***********************************************************************
+ * Source File:
+ *    TEST TIME MANAGER
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the time manager
+ ************************************************************************/
+
+#include "testTimeManager.h"
+#include "timeManager.h"
+#include <cassert>
+
+/*************************************
+ * START : sudden death
+ * Input:  60 seconds, no increment, no moves to go
+ * Output: soft is a small slice of the clock, hard is bigger
+ **************************************/
+void TestTimeManager::start_suddenDeath()
+{
+   // SETUP
+   TimeManager tm;
+
+   // EXERCISE
+   tm.start(60000.0, 0.0, 0);
+
+   // VERIFY
+   assertUnit(tm.getSoft() > 1000.0);
+   assertUnit(tm.getSoft() < 3000.0);
+   assertUnit(tm.getHard() > tm.getSoft());
+   assertUnit(tm.getHard() <= 30000.0);
+   assertUnit(tm.isStopped() == false);
+}
+
+/*************************************
+ * START : increment
+ * Input:  60 seconds, 2 second increment
+ * Output: more time than without the increment
+ **************************************/
+void TestTimeManager::start_increment()
+{
+   // SETUP
+   TimeManager tmPlain;
+   TimeManager tmIncrement;
+
+   // EXERCISE
+   tmPlain.start(60000.0, 0.0, 0);
+   tmIncrement.start(60000.0, 2000.0, 0);
+
+   // VERIFY
+   assertUnit(tmIncrement.getSoft() > tmPlain.getSoft() + 1000.0);
+}
+
+/*************************************
+ * START : moves to go
+ * Input:  60 seconds, 10 moves to go
+ * Output: about 6 seconds each
+ **************************************/
+void TestTimeManager::start_movesToGo()
+{
+   // SETUP
+   TimeManager tm;
+
+   // EXERCISE
+   tm.start(60000.0, 0.0, 10);
+
+   // VERIFY
+   assertUnit(tm.getSoft() > 5500.0);
+   assertUnit(tm.getSoft() < 6000.0);
+}
+
+/*************************************
+ * START : last move before the time control
+ * Input:  10 seconds, 1 move to go
+ * Output: we may use nearly all of it, but not all
+ **************************************/
+void TestTimeManager::start_lastMove()
+{
+   // SETUP
+   TimeManager tm;
+
+   // EXERCISE
+   tm.start(10000.0, 0.0, 1);
+
+   // VERIFY
+   assertUnit(tm.getHard() > 9000.0);
+   assertUnit(tm.getHard() < 10000.0);
+   assertUnit(tm.getSoft() <= tm.getHard());
+}
+
+/*************************************
+ * START : nearly out of time
+ * Input:  10 ms
+ * Output: never a negative allocation
+ **************************************/
+void TestTimeManager::start_lowOnTime()
+{
+   // SETUP
+   TimeManager tm;
+
+   // EXERCISE
+   tm.start(10.0, 0.0, 0);
+
+   // VERIFY
+   assertUnit(tm.getSoft() >= 0.0);
+   assertUnit(tm.getHard() >= 0.0);
+   assertUnit(tm.getSoft() <= tm.getHard());
+}
+
+/*************************************
+ * START FIXED
+ * Input:  250 ms
+ * Output: soft and hard are both 250 ms
+ **************************************/
+void TestTimeManager::startFixed()
+{
+   // SETUP
+   TimeManager tm;
+
+   // EXERCISE
+   tm.startFixed(250.0);
+
+   // VERIFY
+   assertEquals(tm.getSoft(), 250.0);
+   assertEquals(tm.getHard(), 250.0);
+}
+
+/*************************************
+ * IS HARD LIMIT : plenty of time
+ * Input:  a minute, checked on a multiple of NODES_CHECK
+ * Output: false
+ **************************************/
+void TestTimeManager::isHardLimit_notYet()
+{
+   // SETUP
+   TimeManager tm;
+   tm.startFixed(60000.0);
+
+   // EXERCISE
+   bool fLimit = tm.isHardLimit(TimeManager::NODES_CHECK);
+
+   // VERIFY
+   assertUnit(fLimit == false);
+}
+
+/*************************************
+ * IS HARD LIMIT : no time at all
+ * Input:  0 ms, checked between and on a multiple of NODES_CHECK
+ * Output: the clock is only read on the multiple
+ **************************************/
+void TestTimeManager::isHardLimit_expired()
+{
+   // SETUP
+   TimeManager tm;
+   tm.startFixed(0.0);
+
+   // EXERCISE
+   bool fBetween = tm.isHardLimit(TimeManager::NODES_CHECK + 1);
+   bool fOn      = tm.isHardLimit(TimeManager::NODES_CHECK * 2);
+
+   // VERIFY
+   assertUnit(fBetween == false);
+   assertUnit(fOn == true);
+   assertUnit(tm.isSoftLimit() == true);
+}
+
+/*************************************
+ * IS HARD LIMIT : stopped
+ * Input:  a minute, then stop()
+ * Output: true on the very next node
+ **************************************/
+void TestTimeManager::isHardLimit_stop()
+{
+   // SETUP
+   TimeManager tm;
+   tm.startFixed(60000.0);
+
+   // EXERCISE
+   tm.stop();
+
+   // VERIFY
+   assertUnit(tm.isHardLimit(1) == true);
+   assertUnit(tm.isSoftLimit() == true);
+}
+
+/*************************************
+ * UPDATE : the best move changed
+ * Input:  60 seconds, 30 to go, best move changed
+ * Output: the soft limit grows
+ **************************************/
+void TestTimeManager::update_changed()
+{
+   // SETUP
+   TimeManager tm;
+   tm.start(60000.0, 0.0, 30);
+   double msSoft = tm.getSoft();
+
+   // EXERCISE
+   tm.update(true /*fBestMoveChanged*/);
+
+   // VERIFY
+   assertUnit(tm.getSoft() > msSoft);
+   assertUnit(tm.getSoft() <= tm.getHard());
+}
+
+/*************************************
+ * UPDATE : the best move is stable
+ * Input:  changed once, then stable several times
+ * Output: the soft limit comes back down
+ **************************************/
+void TestTimeManager::update_stable()
+{
+   // SETUP
+   TimeManager tm;
+   tm.start(60000.0, 0.0, 30);
+   double msSoft = tm.getSoft();
+   tm.update(true /*fBestMoveChanged*/);
+   double msExtended = tm.getSoft();
+
+   // EXERCISE
+   for (int i = 0; i < 10; i++)
+      tm.update(false /*fBestMoveChanged*/);
+
+   // VERIFY
+   assertUnit(tm.getSoft() < msExtended);
+   assertUnit(tm.getSoft() < msSoft * 1.01);
+}
+
+/*************************************
+ * UPDATE : the best move changes every time
+ * Input:  changed many times
+ * Output: never more than the hard limit
+ **************************************/
+void TestTimeManager::update_capped()
+{
+   // SETUP
+   TimeManager tm;
+   tm.start(60000.0, 0.0, 30);
+
+   // EXERCISE
+   for (int i = 0; i < 20; i++)
+      tm.update(true /*fBestMoveChanged*/);
+
+   // VERIFY
+   assertUnit(tm.getSoft() <= tm.getHard());
+   assertUnit(tm.getSoft() <= tm.msSoftBase * 3.0 + 0.001);
+}
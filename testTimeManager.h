@@ -0,0 +1,58 @@
+/***********************************************************************
+ * Header File:
+ *    TEST TIME MANAGER
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for TimeManager
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * TIME MANAGER TEST
+ * Test the TimeManager class
+ ***************************************************/
+class TestTimeManager : public UnitTest
+{
+public:
+   void run()
+   {
+      // allocate
+      runTest(start_suddenDeath);
+      runTest(start_increment);
+      runTest(start_movesToGo);
+      runTest(start_lastMove);
+      runTest(start_lowOnTime);
+      runTest(startFixed);
+
+      // limits
+      runTest(isHardLimit_notYet);
+      runTest(isHardLimit_expired);
+      runTest(isHardLimit_stop);
+
+      // instability
+      runTest(update_changed);
+      runTest(update_stable);
+      runTest(update_capped);
+
+      report("TimeManager");
+   }
+private:
+   void start_suddenDeath();
+   void start_increment();
+   void start_movesToGo();
+   void start_lastMove();
+   void start_lowOnTime();
+   void startFixed();
+
+   void isHardLimit_notYet();
+   void isHardLimit_expired();
+   void isHardLimit_stop();
+
+   void update_changed();
+   void update_stable();
+   void update_capped();
+};
@@ -0,0 +1,189 @@
+/***********************************************************************
+ * Source File:
+ *    TEST TRACE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the scoped timers and counters. The test
+ *    runner is built with TRACE; without it nothing is recorded.
+ *    Each test class runs on its own thread, so we only look at
+ *    the events this thread recorded.
+ ************************************************************************/
+
+#include "testTrace.h"
+#include "trace.h"
+#include <sstream>    // for OSTRINGSTREAM
+#include <cstring>    // for STRCMP
+#include <chrono>     // for MILLISECONDS
+#include <thread>     // for SLEEP_FOR
+using namespace std;
+
+/*************************************
+ * LAST NAMED
+ * The most recent event this thread recorded with a name
+ **************************************/
+static bool lastNamed(const char * name, TraceEvent & event)
+{
+   vector <TraceEvent> events = traceEvents();
+   for (size_t i = events.size(); i > 0; i--)
+      if (strcmp(events[i - 1].name, name) == 0)
+      {
+         event = events[i - 1];
+         return true;
+      }
+   return false;
+}
+
+/*************************************
+ * ENABLED : build
+ * Input:  nothing
+ * Output: true exactly when built with TRACE
+ **************************************/
+void TestTrace::enabled_build()
+{
+#ifdef TRACE
+   assertUnit(traceEnabled() == true);
+#else
+   assertUnit(traceEnabled() == false);
+   assertUnit(traceEvents().empty());
+#endif
+}
+
+/*************************************
+ * SCOPE : records
+ * Input:  a scope that lasts at least 2ms
+ * Output: one 'X' event that long
+ **************************************/
+void TestTrace::scope_records()
+{
+   // EXERCISE
+   {
+      TRACE_SCOPE("test_scope");
+      this_thread::sleep_for(chrono::milliseconds(2));
+   }
+
+   // VERIFY
+   TraceEvent event;
+   bool fFound = lastNamed("test_scope", event);
+   if (traceEnabled())
+   {
+      assertUnit(fFound);
+      assertUnit(event.phase == 'X');
+      assertUnit(event.nsDuration >= 2000000);
+   }
+   else
+      assertUnit(fFound == false);
+}
+
+/*************************************
+ * COUNT : records
+ * Input:  count 42
+ * Output: one 'C' event with 42
+ **************************************/
+void TestTrace::count_records()
+{
+   // EXERCISE
+   TRACE_COUNT("test_count", 42);
+
+   // VERIFY
+   TraceEvent event;
+   bool fFound = lastNamed("test_count", event);
+   if (traceEnabled())
+   {
+      assertUnit(fFound);
+      assertUnit(event.phase == 'C');
+      assertUnit(event.value == 42);
+   }
+   else
+      assertUnit(fFound == false);
+}
+
+/*************************************
+ * RING : wraps
+ * Input:  10 more counts than the ring holds
+ * Output: the ring is full and the 10 oldest are gone
+ **************************************/
+void TestTrace::ring_wraps()
+{
+   // EXERCISE
+   for (long i = 0; i < TRACE_EVENTS + 10; i++)
+      TRACE_COUNT("test_wrap", i);
+
+   // VERIFY
+   vector <TraceEvent> events = traceEvents();
+   if (traceEnabled())
+   {
+      assertUnit(events.size() == (size_t)TRACE_EVENTS);
+      assertUnit(strcmp(events.front().name, "test_wrap") == 0);
+      assertUnit(events.front().value == 10);
+      assertUnit(events.back().value == TRACE_EVENTS + 9);
+   }
+   else
+      assertUnit(events.empty());
+}
+
+/*************************************
+ * WRITE : json
+ * Input:  a scope and a count
+ * Output: Chrome trace events for both. Only this
+ *         thread's, as the other tests are recording
+ **************************************/
+void TestTrace::write_json()
+{
+   // SETUP
+   {
+      TRACE_SCOPE("test_json_scope");
+   }
+   TRACE_COUNT("test_json_count", 7);
+   ostringstream out;
+
+   // EXERCISE
+   traceWriteThread(out);
+
+   // VERIFY
+   string json = out.str();
+   assertUnit(json.find("{ \"traceEvents\": [") == 0);
+   assertUnit(json.find("] }") != string::npos);
+   if (traceEnabled())
+   {
+      assertUnit(json.find("{ \"name\": \"test_json_scope\", \"ph\": \"X\", \"ts\": ") != string::npos);
+      assertUnit(json.find("\"ph\": \"C\"") != string::npos);
+      assertUnit(json.find("\"args\": { \"value\": 7 }") != string::npos);
+   }
+   else
+      assertUnit(json.find("test_json") == string::npos);
+}
+
+/*************************************
+ * RING : new track
+ * Input:  one thread records and ends, then another
+ * Output: each sees only its own event, under its
+ *         own tid, even when they share a ring
+ **************************************/
+void TestTrace::ring_newTrack()
+{
+   // SETUP
+   vector <TraceEvent> first;
+   vector <TraceEvent> second;
+
+   // EXERCISE
+   thread([&first]  { TRACE_COUNT("test_first", 1);  first  = traceEvents(); }).join();
+   thread([&second] { TRACE_COUNT("test_second", 2); second = traceEvents(); }).join();
+
+   // VERIFY
+   if (traceEnabled())
+   {
+      assertUnit(first.size() == 1);
+      assertUnit(second.size() == 1);
+      if (first.size() == 1 && second.size() == 1)
+      {
+         assertUnit(strcmp(second[0].name, "test_second") == 0);
+         assertUnit(first[0].tid != second[0].tid);
+      }
+   }
+   else
+   {
+      assertUnit(first.empty());
+      assertUnit(second.empty());
+   }
+}
@@ -0,0 +1,39 @@
+/***********************************************************************
+ * Header File:
+ *    TEST TRACE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the scoped timers and counters
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * TRACE TEST
+ * Test TRACE_SCOPE, TRACE_COUNT and the writer
+ ***************************************************/
+class TestTrace : public UnitTest
+{
+public:
+   void run()
+   {
+      runTest(enabled_build);
+      runTest(scope_records);
+      runTest(count_records);
+      runTest(ring_wraps);
+      runTest(write_json);
+      runTest(ring_newTrack);
+
+      report("Trace");
+   }
+private:
+   void enabled_build();
+   void scope_records();
+   void count_records();
+   void ring_wraps();
+   void write_json();
+   void ring_newTrack();
+};
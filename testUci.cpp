@@ -0,0 +1,243 @@
+/***********************************************************************
+ * Source File:
+ *    TEST UCI
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the UCI front end
+ ************************************************************************/
+
+#include "testUci.h"
+#include "uci.h"
+#include "piece.h"
+#include <sstream>    // for STRINGSTREAM
+#include <chrono>     // for MILLISECONDS
+#include <cstdio>     // for REMOVE
+#include <cassert>
+using namespace std;
+
+/*************************************
+ * UCI : handshake
+ * Input:  "uci"
+ * Output: our name, our options, then "uciok" last
+ **************************************/
+void TestUci::uci_handshake()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+
+   // EXERCISE
+   bool fContinue = uci.command("uci");
+
+   // VERIFY
+   string text = out.str();
+   assertUnit(fContinue == true);
+   assertUnit(text.find("id name ") == 0);
+   assertUnit(text.find("option name NullMove type check") != string::npos);
+   assertUnit(text.size() >= 6 && text.substr(text.size() - 6) == "uciok\n");
+}
+
+/*************************************
+ * IS READY
+ * Input:  "isready" then "quit"
+ * Output: "readyok", and quit says to stop reading
+ **************************************/
+void TestUci::isReady()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+
+   // EXERCISE
+   uci.command("isready");
+   bool fContinue = uci.command("quit");
+
+   // VERIFY
+   assertUnit(out.str() == "readyok\n");
+   assertUnit(fContinue == false);
+}
+
+/*************************************
+ * POSITION : startpos with moves
+ * Input:  "position startpos moves g1f3 b8c6"
+ * Output: two moves made, the knights moved
+ **************************************/
+void TestUci::position_startposMoves()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+
+   // EXERCISE
+   uci.command("position startpos moves g1f3 b8c6");
+
+   // VERIFY
+   assertUnit(uci.board.getCurrentMove() == 2);
+   assertUnit(uci.board[Position(5, 2)].getType() == KNIGHT);
+   assertUnit(uci.board[Position(2, 5)].getType() == KNIGHT);
+   assertUnit(uci.board[Position(6, 0)].getType() == SPACE);
+   assertUnit(out.str().empty());
+}
+
+/*************************************
+ * POSITION : fen
+ * Input:  a white knight on e5, a black one on a8, black to move
+ * Output: the board is set up and it is black's turn
+ **************************************/
+void TestUci::position_fen()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+
+   // EXERCISE
+   uci.command("position fen n7/8/8/4N3/8/8/8/8 b - - 0 12");
+
+   // VERIFY
+   assertUnit(uci.board.whiteTurn() == false);
+   assertUnit(uci.board[Position(4, 4)].getType() == KNIGHT);
+   assertUnit(uci.board[Position(4, 4)].isWhite() == true);
+   assertUnit(uci.board[Position(0, 7)].isWhite() == false);
+   assertUnit(uci.board[Position(1, 0)].getType() == SPACE);
+   assertUnit(out.str().empty());
+}
+
+/*************************************
+ * POSITION : illegal move
+ * Input:  "position startpos moves g1g3"
+ * Output: a complaint and no move made
+ **************************************/
+void TestUci::position_illegal()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+
+   // EXERCISE
+   uci.command("position startpos moves g1g3");
+
+   // VERIFY
+   assertUnit(uci.board.getCurrentMove() == 0);
+   assertUnit(out.str() == "info string illegal move g1g3\n");
+}
+
+/*************************************
+ * GO : depth
+ * Input:  "go depth 2" from the starting position
+ * Output: info for depths 1 and 2, then a knight move
+ **************************************/
+void TestUci::go_depth()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+   uci.command("position startpos");
+
+   // EXERCISE
+   uci.command("go depth 2");
+   uci.wait();
+
+   // VERIFY
+   string text = out.str();
+   assertUnit(text.find("info depth 1 ") != string::npos);
+   assertUnit(text.find("info depth 2 ") != string::npos);
+   assertUnit(text.find("info depth 3 ") == string::npos);
+   size_t iBest = text.find("bestmove ");
+   assertUnit(iBest != string::npos);
+   assertUnit(text.find("bestmove b1") == iBest || text.find("bestmove g1") == iBest);
+   assertUnit(uci.board.getCurrentMove() == 0);
+}
+
+/*************************************
+ * GO : infinite, then stop
+ * Input:  "go infinite", wait a little, "stop"
+ * Output: no bestmove until stop, then exactly one
+ **************************************/
+void TestUci::go_infiniteStop()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+   uci.command("position startpos");
+
+   // EXERCISE
+   uci.command("go infinite");
+   this_thread::sleep_for(chrono::milliseconds(50));
+   bool fAnswered = false;
+   {
+      lock_guard <mutex> lock(uci.mutexOut);
+      fAnswered = out.str().find("bestmove") != string::npos;
+   }
+   uci.command("stop");
+
+   // VERIFY
+   string text = out.str();
+   assertUnit(fAnswered == false);
+   size_t iBest = text.find("bestmove ");
+   assertUnit(iBest != string::npos);
+   assertUnit(text.find("bestmove ", iBest + 1) == string::npos);
+   assertUnit(uci.board.getCurrentMove() == 0);
+}
+
+/*************************************
+ * SET OPTION : null move
+ * Input:  "setoption name NullMove value false"
+ * Output: the search no longer uses it
+ **************************************/
+void TestUci::setOption_nullMove()
+{
+   // SETUP
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+
+   // EXERCISE
+   uci.command("setoption name NullMove value false");
+
+   // VERIFY
+   assertUnit(uci.search.useNullMove == false);
+   assertUnit(uci.search.useLateMoveReductions == true);
+   assertUnit(out.str().empty());
+}
+
+/*************************************
+ * SET OPTION : book file
+ * Input:  a book with only b1c3 from the start, then
+ *         "go depth 5", then no book and a missing one
+ * Output: b1c3 without a search; then it is gone
+ **************************************/
+void TestUci::setOption_bookFile()
+{
+   // SETUP
+   const char * fileName = "testUci.bin";
+   BookBuilder builder;
+   builder.add(Board(), Move(Position(1, 0), Position(2, 2)), 1);
+   builder.write(fileName);
+   istringstream in;
+   ostringstream out;
+   Uci uci(in, out);
+
+   // EXERCISE
+   uci.command(string("setoption name BookFile value ") + fileName);
+   uci.command("position startpos");
+   uci.command("go depth 5");
+   string textBook = out.str();
+   uci.command("setoption name BookFile value <empty>");
+   bool fOpenAfter = uci.book.isOpen();
+   uci.command("setoption name BookFile value testUciMissing.bin");
+   remove(fileName);
+
+   // VERIFY
+   assertUnit(textBook == "bestmove b1c3\n");
+   assertUnit(!uci.worker.joinable());
+   assertUnit(!fOpenAfter);
+   assertUnit(out.str().find("cannot open testUciMissing.bin") != string::npos);
+}
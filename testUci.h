@@ -0,0 +1,55 @@
+/***********************************************************************
+ * Header File:
+ *    TEST UCI
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The unit tests for the UCI front end
+ ************************************************************************/
+
+#pragma once
+
+#include "unitTest.h"
+
+/***************************************************
+ * UCI TEST
+ * Test the Uci class by feeding it commands
+ ***************************************************/
+class TestUci : public UnitTest
+{
+public:
+   void run()
+   {
+      // handshake
+      runTest(uci_handshake);
+      runTest(isReady);
+
+      // position
+      runTest(position_startposMoves);
+      runTest(position_fen);
+      runTest(position_illegal);
+
+      // search
+      runTest(go_depth);
+      runTest(go_infiniteStop);
+
+      // options
+      runTest(setOption_nullMove);
+      runTest(setOption_bookFile);
+
+      report("Uci");
+   }
+private:
+   void uci_handshake();
+   void isReady();
+
+   void position_startposMoves();
+   void position_fen();
+   void position_illegal();
+
+   void go_depth();
+   void go_infiniteStop();
+
+   void setOption_nullMove();
+   void setOption_bookFile();
+};
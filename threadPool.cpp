@@ -0,0 +1,92 @@
+/***********************************************************************
+ * Source File:
+ *    THREAD POOL
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A fixed set of worker threads that run jobs from a queue
+ ************************************************************************/
+
+#include "threadPool.h"
+#include <cassert>
+using namespace std;
+
+/*************************************************
+ * THREAD POOL : CONSTRUCT
+ *************************************************/
+ThreadPool::ThreadPool(int numThreads) : numBusy(0), fQuit(false)
+{
+   if (numThreads <= 0)
+      numThreads = (int)thread::hardware_concurrency();
+   if (numThreads <= 0)
+      numThreads = 1;
+
+   for (int i = 0; i < numThreads; i++)
+      threads.push_back(thread(&ThreadPool::work, this));
+}
+
+/*************************************************
+ * THREAD POOL : DESTRUCT
+ * Finish what is in the queue, then let the threads go
+ *************************************************/
+ThreadPool::~ThreadPool()
+{
+   {
+      lock_guard <mutex> lock(mutexJobs);
+      fQuit = true;
+   }
+   jobAdded.notify_all();
+   for (thread & t : threads)
+      t.join();
+}
+
+/*************************************************
+ * THREAD POOL : SUBMIT
+ *************************************************/
+void ThreadPool::submit(const function<void()> & job)
+{
+   {
+      lock_guard <mutex> lock(mutexJobs);
+      assert(!fQuit);
+      jobs.push(job);
+   }
+   jobAdded.notify_one();
+}
+
+/*************************************************
+ * THREAD POOL : WAIT
+ *************************************************/
+void ThreadPool::wait()
+{
+   unique_lock <mutex> lock(mutexJobs);
+   jobDone.wait(lock, [this] { return jobs.empty() && numBusy == 0; });
+}
+
+/*************************************************
+ * THREAD POOL : WORK
+ * Each thread takes jobs until we quit and the queue is empty
+ *************************************************/
+void ThreadPool::work()
+{
+   while (true)
+   {
+      function<void()> job;
+      {
+         unique_lock <mutex> lock(mutexJobs);
+         jobAdded.wait(lock, [this] { return fQuit || !jobs.empty(); });
+         if (jobs.empty())
+            return;
+         job = jobs.front();
+         jobs.pop();
+         numBusy++;
+      }
+
+      job();
+
+      {
+         lock_guard <mutex> lock(mutexJobs);
+         numBusy--;
+      }
+      jobDone.notify_all();
+   }
+}
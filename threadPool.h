@@ -0,0 +1,53 @@
+/***********************************************************************
+ * Header File:
+ *    THREAD POOL
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    A fixed set of worker threads that run jobs from a queue. Start
+ *    the threads once and hand them work, rather than starting a new
+ *    thread for every job.
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>               // for VECTOR of threads
+#include <queue>                // for QUEUE of jobs
+#include <thread>               // for THREAD
+#include <mutex>                // for MUTEX
+#include <condition_variable>   // for CONDITION_VARIABLE
+#include <functional>           // for FUNCTION, a job
+
+class TestThreadPool;
+
+/***************************************************
+ * THREAD POOL
+ * Run jobs on a few threads
+ ***************************************************/
+class ThreadPool
+{
+   friend TestThreadPool;
+public:
+   // zero threads means one per hardware thread
+   ThreadPool(int numThreads = 0);
+   ~ThreadPool();
+
+   // run a job on whichever thread is free next
+   void submit(const std::function<void()> & job);
+
+   // block until every job submitted so far has finished
+   void wait();
+
+   int size() const { return (int)threads.size(); }
+
+private:
+   void work();
+
+   std::vector <std::thread> threads;
+   std::queue <std::function<void()>> jobs;
+   std::mutex mutexJobs;
+   std::condition_variable jobAdded;    // a worker has something to do
+   std::condition_variable jobDone;     // wait() may be finished
+   int numBusy;                         // jobs being run right now
+   bool fQuit;                          // the destructor is waiting for us
+};
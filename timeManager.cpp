@@ -0,0 +1,118 @@
+/***********************************************************************
+ * Source File:
+ *    TIME MANAGER
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Decide how long the search may think about a move. The soft limit
+ *    is when we stop starting new iterations, the hard limit is when we
+ *    stop no matter what.
+ ************************************************************************/
+
+#include "timeManager.h"
+#include <chrono>      // for STEADY_CLOCK
+#include <algorithm>   // for MIN and MAX
+#include <limits>      // for INFINITY
+using namespace std;
+
+const int    MOVES_TO_GO_DEFAULT = 30;     // guess for sudden death
+const double MS_OVERHEAD         = 30.0;   // keep this much in reserve
+const double HARD_FACTOR         = 4.0;    // hard limit is this times soft
+const double HARD_MAX_FRACTION   = 0.5;    // never more than this of the clock
+const double INSTABILITY_EXTEND  = 1.0;    // extra soft time per best move change
+const double INSTABILITY_DECAY   = 0.5;    // how quickly we calm down
+const double INSTABILITY_MAX     = 2.0;    // at most triple the soft time
+
+/*************************************************
+ * MS NOW
+ * The current time in milliseconds
+ *************************************************/
+static double msNow()
+{
+   using namespace std::chrono;
+   return duration<double, milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+/*************************************************
+ * TIME MANAGER : CONSTRUCT
+ *************************************************/
+TimeManager::TimeManager() :
+   msStart(msNow()),
+   msSoftBase(0.0),
+   msSoft(0.0),
+   msHard(0.0),
+   instability(0.0),
+   fStop(false)
+{
+}
+
+/*************************************************
+ * TIME MANAGER : START
+ * Spread what is left on the clock over the moves we
+ * still have to make, plus most of the increment
+ *************************************************/
+void TimeManager::start(double msRemaining, double msIncrement, int movesToGo)
+{
+   msStart = msNow();
+   instability = 0.0;
+   fStop = false;
+
+   double msAvailable = max(msRemaining - MS_OVERHEAD, 0.0);
+   int moves = movesToGo > 0 ? min(movesToGo, MOVES_TO_GO_DEFAULT) : MOVES_TO_GO_DEFAULT;
+
+   msSoftBase = msAvailable / moves + msIncrement * 0.75;
+   msHard = min(msSoftBase * HARD_FACTOR, msAvailable * HARD_MAX_FRACTION);
+
+   // with one move to go we can use nearly everything
+   if (movesToGo == 1)
+      msHard = msAvailable;
+
+   msSoftBase = min(msSoftBase, msHard);
+   msSoft = msSoftBase;
+}
+
+/*************************************************
+ * TIME MANAGER : START FIXED
+ *************************************************/
+void TimeManager::startFixed(double msMove)
+{
+   msStart = msNow();
+   instability = 0.0;
+   fStop = false;
+   msSoftBase = msSoft = msHard = msMove;
+}
+
+/*************************************************
+ * TIME MANAGER : START INFINITE
+ * Analysis: the clock never runs out
+ *************************************************/
+void TimeManager::startInfinite()
+{
+   msStart = msNow();
+   instability = 0.0;
+   fStop = false;
+   msSoftBase = msSoft = msHard = numeric_limits<double>::infinity();
+}
+
+/*************************************************
+ * TIME MANAGER : UPDATE
+ * Extend the soft limit while the principal variation is
+ * unstable, never past the hard limit
+ *************************************************/
+void TimeManager::update(bool fBestMoveChanged)
+{
+   instability *= INSTABILITY_DECAY;
+   if (fBestMoveChanged)
+      instability = min(instability + INSTABILITY_EXTEND, INSTABILITY_MAX);
+
+   msSoft = min(msSoftBase * (1.0 + instability), msHard);
+}
+
+/*************************************************
+ * TIME MANAGER : ELAPSED
+ * Milliseconds since the search started
+ *************************************************/
+double TimeManager::elapsed() const
+{
+   return msNow() - msStart;
+}
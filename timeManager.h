@@ -0,0 +1,72 @@
+/***********************************************************************
+ * Header File:
+ *    TIME MANAGER
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Decide how long the search may think about a move. The soft limit
+ *    is when we stop starting new iterations, the hard limit is when we
+ *    stop no matter what.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>   // for ATOMIC, so another thread can stop us
+
+class TestTimeManager;
+
+/***************************************************
+ * TIME MANAGER
+ * The engine's own clock, independent of the frame rate
+ ***************************************************/
+class TimeManager
+{
+   friend TestTimeManager;
+public:
+   TimeManager();
+
+   // a game clock: time left, increment per move, and moves until the
+   // next time control (0 means the rest of the game)
+   void start(double msRemaining, double msIncrement = 0.0, int movesToGo = 0);
+
+   // exactly this long for this move
+   void startFixed(double msMove);
+
+   // until somebody calls stop()
+   void startInfinite();
+
+   // cheap enough to call every node: only looks at the clock every
+   // NODES_CHECK nodes
+   bool isHardLimit(long nodes)
+   {
+      if (!fStop && nodes % NODES_CHECK == 0 && elapsed() >= msHard)
+         fStop = true;
+      return fStop;
+   }
+
+   // called between iterations: should we start another one?
+   bool isSoftLimit() const { return fStop || elapsed() >= msSoft; }
+
+   // called after each iteration. When the best move keeps changing,
+   // the position is unclear so we give it more time.
+   void update(bool fBestMoveChanged);
+
+   // getters
+   double elapsed() const;
+   double getSoft() const { return msSoft; }
+   double getHard() const { return msHard; }
+   bool   isStopped() const { return fStop; }
+
+   // stop the search as soon as possible. Safe to call from another thread
+   void stop() { fStop = true; }
+
+   static const int NODES_CHECK = 1024;   // how often we look at the clock
+
+private:
+   double msStart;       // when the search started
+   double msSoftBase;    // soft limit before any extension
+   double msSoft;        // stop starting new iterations after this
+   double msHard;        // stop searching after this
+   double instability;   // how much the best move has been changing
+   std::atomic <bool> fStop;   // we are out of time or were told to stop
+};
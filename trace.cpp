@@ -0,0 +1,262 @@
+/***********************************************************************
+ * Source File:
+ *    TRACE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The per-thread ring buffers behind TRACE_SCOPE and TRACE_COUNT,
+ *    and the Chrome trace-event JSON writer
+ ************************************************************************/
+
+#include "trace.h"
+
+#ifdef TRACE
+#include <atomic>    // for ATOMIC event count
+#include <chrono>    // for STEADY_CLOCK
+#include <memory>    // for SHARED_PTR
+#include <mutex>     // for MUTEX around the list of threads
+#include <iomanip>   // for SETPRECISION
+using namespace std;
+
+/***************************************************
+ * THREAD BUFFER
+ * One thread's events. Only the owner writes; count
+ * is how many it has ever recorded, so the oldest
+ * are overwritten once it passes TRACE_EVENTS
+ ***************************************************/
+struct ThreadBuffer
+{
+   ThreadBuffer(int tid) : events(TRACE_EVENTS), count(0), tid(tid) {}
+   vector <TraceEvent> events;
+   atomic <uint64_t> count;
+   int tid;
+};
+
+// every buffer ever made, so they outlive their threads, and the ones
+// whose threads are done, to be used again. Each thread that takes one
+// gets the next tid, so a ring that changes hands changes tracks too
+static int tidNext = 0;
+static mutex & buffersMutex()
+{
+   static mutex buffersMutex;
+   return buffersMutex;
+}
+static vector <shared_ptr <ThreadBuffer>> & buffers()
+{
+   static vector <shared_ptr <ThreadBuffer>> buffers;
+   return buffers;
+}
+static vector <shared_ptr <ThreadBuffer>> & buffersFree()
+{
+   static vector <shared_ptr <ThreadBuffer>> buffersFree;
+   return buffersFree;
+}
+
+/***************************************************
+ * BUFFER OWNER
+ * Hands the thread's buffer back when the thread
+ * ends. What it recorded stays until the next thread
+ * to take the buffer writes over it
+ ***************************************************/
+struct BufferOwner
+{
+   ~BufferOwner()
+   {
+      if (pBuffer)
+      {
+         lock_guard <mutex> lock(buffersMutex());
+         buffersFree().push_back(pBuffer);
+      }
+   }
+   shared_ptr <ThreadBuffer> pBuffer;
+};
+
+/*************************************************
+ * BUFFER THREAD
+ * This thread's buffer, the first time we need it:
+ * one a finished thread gave back, or else a new one.
+ * So there are only ever as many as there were
+ * threads recording at once
+ *************************************************/
+static ThreadBuffer & bufferThread()
+{
+   thread_local BufferOwner owner;
+   if (!owner.pBuffer)
+   {
+      lock_guard <mutex> lock(buffersMutex());
+      if (buffersFree().empty())
+      {
+         owner.pBuffer = make_shared <ThreadBuffer>(tidNext++);
+         buffers().push_back(owner.pBuffer);
+      }
+      else
+      {
+         owner.pBuffer = buffersFree().back();
+         buffersFree().pop_back();
+         owner.pBuffer->tid = tidNext++;
+      }
+   }
+   return *owner.pBuffer;
+}
+
+/*************************************************
+ * EVENTS
+ * A buffer's events, oldest first. With fOwner, only
+ * the ones its thread recorded, not what an earlier
+ * thread left behind
+ *************************************************/
+static vector <TraceEvent> events(const ThreadBuffer & buffer, bool fOwner = false)
+{
+   uint64_t count = buffer.count.load(memory_order_acquire);
+   uint64_t first = count > (uint64_t)TRACE_EVENTS ? count - TRACE_EVENTS : 0;
+   vector <TraceEvent> events;
+   events.reserve((size_t)(count - first));
+   for (uint64_t i = first; i < count; i++)
+   {
+      const TraceEvent & event = buffer.events[(size_t)(i % TRACE_EVENTS)];
+      if (!fOwner || event.tid == buffer.tid)
+         events.push_back(event);
+   }
+   return events;
+}
+
+/*************************************************
+ * TRACE NOW
+ * Nanoseconds since the first time we asked
+ *************************************************/
+uint64_t traceNow()
+{
+   static const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+      chrono::steady_clock::now() - start).count();
+}
+
+/*************************************************
+ * TRACE RECORD
+ *************************************************/
+void traceRecord(const char * name, char phase, uint64_t nsStart,
+                 uint64_t nsDuration, long value)
+{
+   ThreadBuffer & buffer = bufferThread();
+   uint64_t count = buffer.count.load(memory_order_relaxed);
+   TraceEvent & event = buffer.events[(size_t)(count % TRACE_EVENTS)];
+   event.name       = name;
+   event.phase      = phase;
+   event.nsStart    = nsStart;
+   event.nsDuration = nsDuration;
+   event.value      = value;
+   event.tid        = buffer.tid;
+   buffer.count.store(count + 1, memory_order_release);
+}
+
+bool traceEnabled()
+{
+   return true;
+}
+
+/*************************************************
+ * WRITE EVENTS
+ * Events as Chrome JSON. Chrome wants microseconds.
+ * The names are ours, so they need no escaping
+ *************************************************/
+static void writeEvents(ostream & out, const vector <TraceEvent> & events, bool & fFirst)
+{
+   for (const TraceEvent & event : events)
+   {
+      out << (fFirst ? "\n" : ",\n")
+          << "  { \"name\": \"" << event.name << "\""
+          << ", \"ph\": \"" << event.phase << "\""
+          << ", \"ts\": " << event.nsStart / 1000.0;
+      if (event.phase == 'X')
+         out << ", \"dur\": " << event.nsDuration / 1000.0;
+      out << ", \"pid\": 1, \"tid\": " << event.tid;
+      if (event.phase == 'C')
+         out << ", \"args\": { \"value\": " << event.value << " }";
+      out << " }";
+      fFirst = false;
+   }
+}
+
+/*************************************************
+ * TRACE WRITE
+ *************************************************/
+void traceWrite(ostream & out)
+{
+   ios::fmtflags flags = out.flags();
+   streamsize precision = out.precision();
+   out << fixed << setprecision(3);
+   out << "{ \"traceEvents\": [";
+
+   bool fFirst = true;
+   lock_guard <mutex> lock(buffersMutex());
+   for (const shared_ptr <ThreadBuffer> & pBuffer : buffers())
+      writeEvents(out, events(*pBuffer), fFirst);
+
+   out << "\n] }\n";
+   out.flags(flags);
+   out.precision(precision);
+}
+
+/*************************************************
+ * TRACE WRITE THREAD
+ *************************************************/
+void traceWriteThread(ostream & out)
+{
+   ios::fmtflags flags = out.flags();
+   streamsize precision = out.precision();
+   out << fixed << setprecision(3);
+   out << "{ \"traceEvents\": [";
+
+   bool fFirst = true;
+   writeEvents(out, events(bufferThread(), true /*fOwner*/), fFirst);
+
+   out << "\n] }\n";
+   out.flags(flags);
+   out.precision(precision);
+}
+
+/*************************************************
+ * TRACE CLEAR
+ *************************************************/
+void traceClear()
+{
+   lock_guard <mutex> lock(buffersMutex());
+   for (const shared_ptr <ThreadBuffer> & pBuffer : buffers())
+      pBuffer->count.store(0, memory_order_release);
+}
+
+/*************************************************
+ * TRACE EVENTS
+ *************************************************/
+vector <TraceEvent> traceEvents()
+{
+   return events(bufferThread(), true /*fOwner*/);
+}
+
+#else // !TRACE
+
+bool traceEnabled()
+{
+   return false;
+}
+
+void traceWrite(std::ostream & out)
+{
+   out << "{ \"traceEvents\": [\n] }\n";
+}
+
+void traceWriteThread(std::ostream & out)
+{
+   traceWrite(out);
+}
+
+void traceClear()
+{
+}
+
+std::vector <TraceEvent> traceEvents()
+{
+   return std::vector <TraceEvent>();
+}
+
+#endif // !TRACE
@@ -0,0 +1,86 @@
+/***********************************************************************
+ * Header File:
+ *    TRACE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Scoped timers and counters for the hot paths. Build with TRACE
+ *    defined and each TRACE_SCOPE records how long its block took,
+ *    and each TRACE_COUNT records a value, into a ring buffer that
+ *    belongs to the thread, and goes to the next thread when it ends.
+ *    traceWrite() dumps them as Chrome trace-event JSON, to be opened
+ *    in chrome://tracing or Perfetto, one track per thread.
+ *    Without TRACE the macros are empty, their arguments are not
+ *    even evaluated, and traceWrite() writes an empty trace.
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>   // for OSTREAM
+#include <vector>     // for VECTOR of events
+#include <cstdint>    // for UINT64_T
+
+const int TRACE_EVENTS = 1 << 16;   // events kept per thread
+
+/***************************************************
+ * TRACE EVENT
+ * Either a timed scope ('X') or a counter ('C')
+ ***************************************************/
+struct TraceEvent
+{
+   const char * name;     // a string literal, never freed
+   char     phase;        // 'X' for a scope, 'C' for a counter
+   uint64_t nsStart;      // since the first event in the program
+   uint64_t nsDuration;   // scopes only
+   long     value;        // counters only
+   int      tid;          // the thread that recorded it, counting from 0
+};
+
+// were we built with TRACE?
+bool traceEnabled();
+
+// { "traceEvents": [ ... ] } for every thread that recorded anything.
+// Call this when the threads are not recording
+void traceWrite(std::ostream & out);
+
+// the same for only what this thread recorded, while the others may be
+void traceWriteThread(std::ostream & out);
+
+// forget everything every thread has recorded. Also only when the
+// threads are not recording
+void traceClear();
+
+// what this thread has recorded, oldest first
+std::vector <TraceEvent> traceEvents();
+
+#ifdef TRACE
+
+uint64_t traceNow();
+void traceRecord(const char * name, char phase, uint64_t nsStart,
+                 uint64_t nsDuration, long value);
+
+/***************************************************
+ * TRACE SCOPE
+ * Record how long we were alive
+ ***************************************************/
+class TraceScope
+{
+public:
+   TraceScope(const char * name) : name(name), nsStart(traceNow()) {}
+   ~TraceScope() { traceRecord(name, 'X', nsStart, traceNow() - nsStart, 0); }
+private:
+   const char * name;
+   uint64_t nsStart;
+};
+
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b)  TRACE_JOIN2(a, b)
+#define TRACE_SCOPE(name)        TraceScope TRACE_JOIN(traceScope, __LINE__)(name)
+#define TRACE_COUNT(name, value) traceRecord(name, 'C', traceNow(), 0, (long)(value))
+
+#else // !TRACE
+
+#define TRACE_SCOPE(name)
+#define TRACE_COUNT(name, value)
+
+#endif // !TRACE
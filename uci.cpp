@@ -0,0 +1,389 @@
+/***********************************************************************
+ * Source File:
+ *    UCI
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The Universal Chess Interface: a chess GUI or a tournament manager
+ *    sends us commands one line at a time and we answer the same way.
+ *    The search runs on its own thread so "stop" is handled right away.
+ ************************************************************************/
+
+#include "uci.h"
+#include "position.h"
+#include <sstream>     // for ISTRINGSTREAM
+#include <set>         // for SET, what the board gives us
+#include <cassert>
+using namespace std;
+
+const int DEPTH_MAX = 60;    // deeper than we will ever get
+
+/*************************************************
+ * UCI : CONSTRUCT
+ * Keep this quick: no network until somebody asks for one
+ *************************************************/
+Uci::Uci(istream & in, ostream & out) :
+   in(in),
+   out(out),
+   board(nullptr),
+   search(board),
+   pNetwork(nullptr),
+   random(random_device()()),
+   fStopRequested(false),
+   fInfinite(false)
+{
+   search.setReport(info, this);
+}
+
+/*************************************************
+ * UCI : DESTRUCT
+ *************************************************/
+Uci::~Uci()
+{
+   stop();
+   board.setNetwork(nullptr);
+   delete pNetwork;
+}
+
+/*************************************************
+ * UCI : RUN
+ * At the end of the input, a search with a limit is
+ * allowed to finish so a script can pipe in commands
+ *************************************************/
+void Uci::run()
+{
+   string line;
+   while (getline(in, line))
+      if (!command(line))
+         return;
+
+   if (!fInfinite)
+      wait();
+   stop();
+}
+
+/*************************************************
+ * UCI : COMMAND
+ * Unknown commands are ignored, as the protocol asks
+ *************************************************/
+bool Uci::command(const string & line)
+{
+   istringstream args(line);
+   string token;
+   args >> token;
+
+   if (token == "uci")
+      uci();
+   else if (token == "isready")
+      isReady();
+   else if (token == "ucinewgame")
+      newGame();
+   else if (token == "position")
+      position(args);
+   else if (token == "go")
+      go(args);
+   else if (token == "stop")
+      stop();
+   else if (token == "setoption")
+      setOption(args);
+   else if (token == "quit")
+   {
+      stop();
+      return false;
+   }
+   return true;
+}
+
+/*************************************************
+ * UCI : WAIT
+ * Let a search with a limit run out on its own
+ *************************************************/
+void Uci::wait()
+{
+   if (worker.joinable())
+      worker.join();
+}
+
+/*************************************************
+ * UCI : UCI
+ * Who we are and what can be changed
+ *************************************************/
+void Uci::uci()
+{
+   write("id name Chess");
+   write("id author <your name here>");
+   write("option name NullMove type check default true");
+   write("option name LateMoveReductions type check default true");
+   write("option name EvalFile type string default <empty>");
+   write("option name BookFile type string default <empty>");
+   write("uciok");
+}
+
+/*************************************************
+ * UCI : IS READY
+ * Answered right away, even in the middle of a search
+ *************************************************/
+void Uci::isReady()
+{
+   write("readyok");
+}
+
+/*************************************************
+ * UCI : NEW GAME
+ *************************************************/
+void Uci::newGame()
+{
+   stop();
+   board.reset();
+}
+
+/*************************************************
+ * UCI : POSITION
+ *    position startpos [moves g1f3 ...]
+ *    position fen <fen> [moves g1f3 ...]
+ *************************************************/
+void Uci::position(istream & args)
+{
+   stop();
+
+   string token;
+   args >> token;
+   if (token == "startpos")
+   {
+      board.reset();
+      args >> token;
+   }
+   else if (token == "fen")
+   {
+      string fen;
+      while (args >> token && token != "moves")
+         fen += (fen.empty() ? "" : " ") + token;
+      if (!board.setFen(fen))
+      {
+         write("info string cannot set up fen " + fen);
+         board.reset();
+         return;
+      }
+   }
+   else
+      return;
+
+   if (token != "moves")
+      return;
+
+   while (args >> token)
+   {
+      Move move;
+      if (!findMove(token, move))
+      {
+         write("info string illegal move " + token);
+         return;
+      }
+      board.move(move);
+   }
+}
+
+/*************************************************
+ * UCI : GO
+ *    go [wtime w] [btime b] [winc w] [binc b] [movestogo n]
+ *       [movetime ms] [depth d] [infinite]
+ * With no limits at all we search until "stop"
+ *************************************************/
+void Uci::go(istream & args)
+{
+   stop();
+
+   double msTime[2] = { -1.0, -1.0 };
+   double msInc[2] = { 0.0, 0.0 };
+   double msMove = -1.0;
+   int movesToGo = 0;
+   int depth = DEPTH_MAX;
+   bool fInfinite = false;
+
+   string token;
+   while (args >> token)
+   {
+      if (token == "wtime")          args >> msTime[0];
+      else if (token == "btime")     args >> msTime[1];
+      else if (token == "winc")      args >> msInc[0];
+      else if (token == "binc")      args >> msInc[1];
+      else if (token == "movestogo") args >> movesToGo;
+      else if (token == "movetime")  args >> msMove;
+      else if (token == "depth")     args >> depth;
+      else if (token == "infinite")  fInfinite = true;
+   }
+
+   // a move from the book needs no thinking, unless we were asked to
+   // think until told to stop
+   Move move;
+   if (!fInfinite && book.pick(board, move, random()))
+   {
+      write("bestmove " + moveText(move));
+      return;
+   }
+
+   // start the clock here, not on the worker, so a "stop" that
+   // arrives before the worker gets going is not lost
+   int us = board.whiteTurn() ? 0 : 1;
+   if (msMove >= 0.0)
+      timeManager.startFixed(msMove);
+   else if (msTime[us] >= 0.0 && !fInfinite)
+      timeManager.start(msTime[us], msInc[us], movesToGo);
+   else
+      timeManager.startInfinite();
+
+   fStopRequested = false;
+   this->fInfinite = fInfinite || (msMove < 0.0 && msTime[us] < 0.0 && depth == DEPTH_MAX);
+   worker = thread(&Uci::think, this, depth, fInfinite);
+}
+
+/*************************************************
+ * UCI : STOP
+ * Tell the search to finish and wait for it
+ *************************************************/
+void Uci::stop()
+{
+   timeManager.stop();
+   {
+      lock_guard <mutex> lock(mutexStop);
+      fStopRequested = true;
+   }
+   stopped.notify_all();
+   wait();
+}
+
+/*************************************************
+ * UCI : SET OPTION
+ *    setoption name <id> [value <x>]
+ *************************************************/
+void Uci::setOption(istream & args)
+{
+   stop();
+
+   string token;
+   string name;
+   string value;
+   args >> token;   // "name"
+   while (args >> token && token != "value")
+      name += (name.empty() ? "" : " ") + token;
+   while (args >> token)
+      value += (value.empty() ? "" : " ") + token;
+
+   if (name == "NullMove")
+      search.useNullMove = (value == "true");
+   else if (name == "LateMoveReductions")
+      search.useLateMoveReductions = (value == "true");
+   else if (name == "EvalFile")
+   {
+      board.setNetwork(nullptr);
+      if (value.empty() || value == "<empty>")
+         return;
+      if (!pNetwork)
+         pNetwork = new Network;
+      if (pNetwork->load(value.c_str()))
+         board.setNetwork(pNetwork);
+      else
+         write("info string cannot load " + value);
+   }
+   else if (name == "BookFile")
+   {
+      book.close();
+      if (!value.empty() && value != "<empty>" && !book.open(value))
+         write("info string cannot open " + value);
+   }
+   else
+      write("info string no such option " + name);
+}
+
+/*************************************************
+ * UCI : THINK
+ * The worker thread. "go infinite" must not answer
+ * until it is told to stop, even if the search ends.
+ *************************************************/
+void Uci::think(int maxDepth, bool fInfinite)
+{
+   Move move = search.think(maxDepth, timeManager);
+
+   if (fInfinite)
+   {
+      unique_lock <mutex> lock(mutexStop);
+      stopped.wait(lock, [this] { return fStopRequested; });
+   }
+
+   bool fNoMove = move.getMoveType() == Move::MOVE_ERROR;
+   write("bestmove " + (fNoMove ? string("0000") : moveText(move)));
+}
+
+/*************************************************
+ * UCI : INFO
+ * Called by the search after every iteration
+ *************************************************/
+void Uci::info(const Search & search, void * p)
+{
+   Uci * pUci = (Uci *)p;
+   double ms = search.getElapsed();
+   ostringstream line;
+   line << "info depth " << search.getDepth()
+        << " score cp " << search.getScore()
+        << " nodes " << search.getNodes()
+        << " time " << (long)ms
+        << " nps " << (long)(ms > 0.0 ? search.getNodes() * 1000.0 / ms : 0.0)
+        << " pv " << moveText(search.getBestMove());
+   pUci->write(line.str());
+}
+
+/*************************************************
+ * UCI : MOVE TEXT
+ * Coordinate notation: "g1f3", "e7e8q"
+ *************************************************/
+string Uci::moveText(const Move & move)
+{
+   string text;
+   text += (char)('a' + move.getSource().getCol());
+   text += (char)('1' + move.getSource().getRow());
+   text += (char)('a' + move.getDest().getCol());
+   text += (char)('1' + move.getDest().getRow());
+   switch (move.getPromote())
+   {
+   case QUEEN:  text += 'q'; break;
+   case ROOK:   text += 'r'; break;
+   case BISHOP: text += 'b'; break;
+   case KNIGHT: text += 'n'; break;
+   default:     break;
+   }
+   return text;
+}
+
+/*************************************************
+ * UCI : FIND MOVE
+ * Which of our legal moves does this text mean?
+ *************************************************/
+bool Uci::findMove(const string & text, Move & move)
+{
+   set <Move> moves;
+   board.getMoves(moves, board.whiteTurn());
+   for (const Move & candidate : moves)
+      if (moveText(candidate) == text)
+      {
+         // moving into check is not legal
+         board.move(candidate);
+         bool fInCheck = board.isInCheck(!board.whiteTurn());
+         board.undo();
+         if (fInCheck)
+            return false;
+
+         move = candidate;
+         return true;
+      }
+   return false;
+}
+
+/*************************************************
+ * UCI : WRITE
+ * One whole line at a time, whichever thread we are on
+ *************************************************/
+void Uci::write(const string & line)
+{
+   lock_guard <mutex> lock(mutexOut);
+   out << line << endl;
+}
@@ -0,0 +1,79 @@
+/***********************************************************************
+ * Header File:
+ *    UCI
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    The Universal Chess Interface: a chess GUI or a tournament manager
+ *    sends us commands one line at a time and we answer the same way.
+ *    The search runs on its own thread so "stop" is handled right away.
+ ************************************************************************/
+
+#pragma once
+
+#include <iostream>             // for ISTREAM and OSTREAM
+#include <string>               // for STRING
+#include <thread>               // for THREAD, where the search runs
+#include <mutex>                // for MUTEX, so we write one line at a time
+#include <condition_variable>   // for CONDITION_VARIABLE, to wait for "stop"
+#include <random>               // for MT19937, to pick from the book
+#include "board.h"
+#include "search.h"
+#include "timeManager.h"
+#include "nnue.h"
+#include "book.h"
+
+class TestUci;
+
+/***************************************************
+ * UCI
+ * Read commands, run the search, write the answers
+ ***************************************************/
+class Uci
+{
+   friend TestUci;
+public:
+   Uci(std::istream & in, std::ostream & out);
+   ~Uci();
+
+   // read commands until "quit" or the end of the input
+   void run();
+
+   // handle one line. Returns false on "quit"
+   bool command(const std::string & line);
+
+   // wait for the search, if any, to finish on its own
+   void wait();
+
+private:
+   void uci();
+   void isReady();
+   void newGame();
+   void position(std::istream & args);
+   void go(std::istream & args);
+   void stop();
+   void setOption(std::istream & args);
+
+   void think(int maxDepth, bool fInfinite);
+   static void info(const Search & search, void * p);
+   static std::string moveText(const Move & move);
+   bool findMove(const std::string & text, Move & move);
+   void write(const std::string & line);
+
+   std::istream & in;
+   std::ostream & out;
+   std::mutex mutexOut;          // one writer at a time
+
+   Board board;
+   Search search;
+   TimeManager timeManager;
+   Network * pNetwork;           // only when there is an EvalFile
+   Book book;                    // only when there is a BookFile
+   std::mt19937 random;          // which of the book's moves to play
+   std::thread worker;           // runs the search
+
+   std::mutex mutexStop;         // for "go infinite", which waits for "stop"
+   std::condition_variable stopped;
+   bool fStopRequested;
+   bool fInfinite;               // will the search only end with "stop"?
+};
@@ -0,0 +1,80 @@
+/**********************************************************************
+* Source File:
+*    UCI MAIN
+* Author:
+*    <your name here>
+* Summary:
+*    The headless engine: no window, no OpenGL, just the Universal
+*    Chess Interface on standard in and standard out:
+*       uci [--trace trace.json] [--book book.bin]
+*    Or make an opening book from a collection of games:
+*       uci --make-book games.pgn book.bin [--plies n]
+************************************************************************/
+
+#include "uci.h"        // for UCI
+#include "trace.h"      // for TRACE WRITE
+#include "book.h"       // for BOOK BUILDER
+#include <iostream>     // for CIN and COUT
+#include <fstream>      // for OFSTREAM and IFSTREAM
+#include <cstring>      // for STRCMP
+#include <cstdlib>      // for ATOI
+using namespace std;
+
+/*********************************
+ * MAIN - Where it all begins...
+ *********************************/
+int main(int argc, char** argv)
+{
+   const char * fileTrace = nullptr;
+   const char * fileBook = nullptr;
+   const char * filePgn = nullptr;
+   int maxPlies = 30;
+   for (int i = 1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+         fileTrace = argv[++i];
+      else if (strcmp(argv[i], "--book") == 0 && i + 1 < argc)
+         fileBook = argv[++i];
+      else if (strcmp(argv[i], "--make-book") == 0 && i + 2 < argc)
+      {
+         filePgn = argv[++i];
+         fileBook = argv[++i];
+      }
+      else if (strcmp(argv[i], "--plies") == 0 && i + 1 < argc)
+         maxPlies = atoi(argv[++i]);
+      else
+      {
+         cerr << "usage: " << argv[0] << " [--trace trace.json] [--book book.bin]\n"
+              << "       " << argv[0] << " --make-book games.pgn book.bin [--plies n]\n";
+         return 1;
+      }
+   }
+
+   // make the book and go
+   if (filePgn)
+   {
+      ifstream fin(filePgn);
+      BookBuilder builder(maxPlies);
+      int numGames = builder.addPgn(fin);
+      if (!fin.eof() || !builder.write(fileBook))
+      {
+         cerr << "cannot make " << fileBook << " from " << filePgn << '\n';
+         return 1;
+      }
+      cout << numGames << " games, " << builder.size() << " moves\n";
+      return 0;
+   }
+
+   Uci uci(cin, cout);
+   if (fileBook)
+      uci.command(string("setoption name BookFile value ") + fileBook);
+   uci.run();
+
+   // what the searches were doing just before we quit
+   if (fileTrace)
+   {
+      ofstream fout(fileTrace);
+      traceWrite(fout);
+   }
+   return 0;
+}
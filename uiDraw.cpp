@@ -15,6 +15,9 @@
 #include <sstream>    // convert an integer into text
 #include <cassert>    // I feel the need... the need for asserts
 #include <time.h>     // for clock
+#include <vector>     // for VECTOR of vertices
+#include <unordered_map>   // for UNORDERED_MAP of text lines
+#include <map>        // for MAP of glyph atlases
 
 #include "position.h"
 
@@ -23,12 +26,16 @@
 #include <openGL/gl.h>    // Main OpenGL library
 #include <GLUT/glut.h>    // Second OpenGL library
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_18
+#define GLUT_TEXT_HEIGHT  24      // pixels from the lowest descender to the top
+#define GLUT_TEXT_DESCENT 6       // pixels below the baseline
 #endif // __APPLE__
 
 #ifdef __linux__
 #include <GL/gl.h>        // Main OpenGL library
 #include <GL/glut.h>      // Second OpenGL library
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
+#define GLUT_TEXT_HEIGHT  16      // pixels from the lowest descender to the top
+#define GLUT_TEXT_DESCENT 4       // pixels below the baseline
 #endif // __linux__
 
 #ifdef _WIN32
@@ -38,6 +45,8 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #define GLUT_TEXT GLUT_BITMAP_HELVETICA_12
+#define GLUT_TEXT_HEIGHT  16      // pixels from the lowest descender to the top
+#define GLUT_TEXT_DESCENT 4       // pixels below the baseline
 #endif // _WIN32
 
 
@@ -46,23 +55,348 @@
 
 using namespace std;
 
-// pieces: black and white
-const int RGB_WHITE[] = { 255, 255, 255 };
-const int RGB_BLACK[] = { 0, 0, 0 };
+/************************************************************************
+* GL COLOR
+* Set the color on the board
+*   INPUT  rgb  RGB color in integers (0...255)
+*************************************************************************/
+void glColor(const int * rgb)
+{
+   glColor3f((GLfloat)(rgb[0] / 256.0), 
+             (GLfloat)(rgb[1] / 256.0),
+             (GLfloat)(rgb[2] / 256.0));
+}
+
+// the characters in the glyph atlas, and how many across it is
+const int GLYPH_FIRST = 32;    // space
+const int GLYPH_LAST  = 126;   // tilde
+const int GLYPH_COLS  = 16;
+
+// lines of text we remember before starting over
+const size_t MAX_CACHED_LINES = 256;
+
+/*************************************************************************
+ * VERTEX
+ * One corner of a quad or end of a line, with its color and, for text,
+ * where it is in the glyph atlas. Laid out for glVertexPointer(),
+ * glTexCoordPointer() and glColorPointer()
+ *************************************************************************/
+struct Vertex
+{
+   GLfloat x;
+   GLfloat y;
+   GLfloat u;
+   GLfloat v;
+   GLubyte rgba[4];
+};
+
+/*************************************************************************
+ * VERTEX BATCH
+ * Geometry sent to OpenGL in one glDrawArrays() call
+ *************************************************************************/
+class VertexBatch
+{
+public:
+   void add(GLfloat x, GLfloat y, const int * rgb, GLfloat u = 0.0, GLfloat v = 0.0)
+   {
+      Vertex vertex = { x, y, u, v,
+                        { (GLubyte)rgb[0], (GLubyte)rgb[1], (GLubyte)rgb[2], 255 } };
+      vertices.push_back(vertex);
+   }
+   void addQuad(int x0, int y0, int x1, int y1, const int * rgb)
+   {
+      add((GLfloat)x0, (GLfloat)y0, rgb);
+      add((GLfloat)x1, (GLfloat)y0, rgb);
+      add((GLfloat)x1, (GLfloat)y1, rgb);
+      add((GLfloat)x0, (GLfloat)y1, rgb);
+   }
+
+   // another batch moved over by (x, y) and colored rgb
+   void append(const VertexBatch & rhs, GLfloat x, GLfloat y, const int * rgb)
+   {
+      for (const Vertex & vertex : rhs.vertices)
+         add(vertex.x + x, vertex.y + y, rgb, vertex.u, vertex.v);
+   }
+
+   bool empty() const { return vertices.empty(); }
+   void clear()       { vertices.clear();         }
+   void draw(GLenum mode, GLuint texture = 0) const;
+
+private:
+   std::vector <Vertex> vertices;
+};
+
+/*************************************************************************
+ * GLYPH ATLAS
+ * Every printable character of the GLUT font, drawn once into the back
+ * buffer and copied into a texture. Each glyph sits in a cell with its
+ * baseline GLUT_TEXT_DESCENT pixels up and a pixel to spare on the left
+ *************************************************************************/
+class GlyphAtlas
+{
+public:
+   GlyphAtlas() : texture(0), widthCell(0), widthTexture(0), heightTexture(0) {}
+
+   bool   isReady()    const { return texture != 0; }
+   GLuint getTexture() const { return texture;      }
+
+   // needs the window, before anything is drawn in the frame
+   bool build();
+
+   // add one character at the pen, returning how far to move it
+   int addGlyph(VertexBatch & batch, GLfloat x, GLfloat y, char letter) const;
+
+private:
+   GLuint texture;
+   int    widthCell;
+   int    widthTexture;
+   int    heightTexture;
+   int    advances[GLYPH_LAST - GLYPH_FIRST + 1];
+};
+
+// the pieces and highlights of this frame, in the order they were drawn
+static VertexBatch batchFrame;
+
+// the text of this frame, drawn over everything else
+static VertexBatch batchText;
+
+// a glyph atlas for each window, and the one we are drawing in. Every
+// atlas has the same layout, so the lines of text laid out, at the
+// origin and in white, are good in any of them
+static std::map <int, GlyphAtlas> atlases;
+static GlyphAtlas * pAtlas = nullptr;
+static std::unordered_map <std::string, VertexBatch> linesText;
+
+// how many times we handed geometry to OpenGL
+static unsigned long drawCalls = 0;
+
+/*************************************************************************
+ * VERTEX BATCH : DRAW
+ * With a texture, only its opaque texels are drawn
+ *************************************************************************/
+void VertexBatch::draw(GLenum mode, GLuint texture) const
+{
+   if (vertices.empty())
+      return;
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+   glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vertices[0].x);
+   glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), vertices[0].rgba);
+   if (texture)
+   {
+      glEnable(GL_TEXTURE_2D);
+      glBindTexture(GL_TEXTURE_2D, texture);
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+      glEnable(GL_ALPHA_TEST);
+      glAlphaFunc(GL_GREATER, (GLfloat)0.5);
+      glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+      glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &vertices[0].u);
+   }
+
+   glDrawArrays(mode, 0, (GLsizei)vertices.size());
+
+   if (texture)
+   {
+      glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+      glDisable(GL_ALPHA_TEST);
+      glDisable(GL_TEXTURE_2D);
+   }
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+   drawCalls++;
+}
+
+/*************************************************************************
+ * GLYPH ATLAS : BUILD
+ * Draw the glyphs white on black in window pixels, then copy them into
+ * an intensity texture so a glyph is opaque exactly where GLUT would
+ * have set a pixel. Textures in OpenGL 1.1 are a power of two on a
+ * side, but only the part we drew is copied. Returns false, leaving us
+ * with GLUT's bitmaps, if the window is too small to draw them in.
+ *************************************************************************/
+bool GlyphAtlas::build()
+{
+   void* pFont = GLUT_TEXT;
+   GLint viewport[4];
+   glGetIntegerv(GL_VIEWPORT, viewport);
+
+   int widthMax = 0;
+   for (int letter = GLYPH_FIRST; letter <= GLYPH_LAST; letter++)
+   {
+      advances[letter - GLYPH_FIRST] = glutBitmapWidth(pFont, letter);
+      if (advances[letter - GLYPH_FIRST] > widthMax)
+         widthMax = advances[letter - GLYPH_FIRST];
+   }
+   widthCell = widthMax + 2;
+   int rows = (GLYPH_LAST - GLYPH_FIRST + GLYPH_COLS) / GLYPH_COLS;
+   int widthUsed  = GLYPH_COLS * widthCell;
+   int heightUsed = rows * GLUT_TEXT_HEIGHT;
+   if (viewport[2] < widthUsed || viewport[3] < heightUsed)
+      return false;
+   for (widthTexture = 1;  widthTexture  < widthUsed;  widthTexture  *= 2);
+   for (heightTexture = 1; heightTexture < heightUsed; heightTexture *= 2);
+
+   // one pixel per unit while we draw the glyphs
+   glMatrixMode(GL_PROJECTION);
+   glPushMatrix();
+   glLoadIdentity();
+   glOrtho(0.0, (GLdouble)viewport[2], 0.0, (GLdouble)viewport[3], -1.0, 1.0);
+   glMatrixMode(GL_MODELVIEW);
+   glPushMatrix();
+   glLoadIdentity();
+
+   glClear(GL_COLOR_BUFFER_BIT);
+   glColor3f((GLfloat)1.0, (GLfloat)1.0, (GLfloat)1.0);
+   for (int letter = GLYPH_FIRST; letter <= GLYPH_LAST; letter++)
+   {
+      int i = letter - GLYPH_FIRST;
+      glRasterPos2i((i % GLYPH_COLS) * widthCell + 1,
+                    (i / GLYPH_COLS) * GLUT_TEXT_HEIGHT + GLUT_TEXT_DESCENT);
+      glutBitmapCharacter(pFont, letter);
+   }
+
+   glPopMatrix();
+   glMatrixMode(GL_PROJECTION);
+   glPopMatrix();
+   glMatrixMode(GL_MODELVIEW);
+
+   // and from the back buffer into the texture
+   glGenTextures(1, &texture);
+   glBindTexture(GL_TEXTURE_2D, texture);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+   glTexImage2D(GL_TEXTURE_2D, 0, GL_INTENSITY, widthTexture, heightTexture, 0,
+                GL_LUMINANCE, GL_UNSIGNED_BYTE, NULL);
+   glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, viewport[0], viewport[1],
+                       widthUsed, heightUsed);
+   glBindTexture(GL_TEXTURE_2D, 0);
+   return true;
+}
+
+/*************************************************************************
+ * GLYPH ATLAS : ADD GLYPH
+ *   INPUT  x, y    the pen, on the baseline
+ *          letter  what to draw. Anything we do not have takes no room
+ *************************************************************************/
+int GlyphAtlas::addGlyph(VertexBatch & batch, GLfloat x, GLfloat y, char letter) const
+{
+   int i = (unsigned char)letter - GLYPH_FIRST;
+   if (i < 0 || i > GLYPH_LAST - GLYPH_FIRST)
+      return 0;
+
+   GLfloat x0 = x - (GLfloat)1.0;
+   GLfloat y0 = y - (GLfloat)GLUT_TEXT_DESCENT;
+   GLfloat x1 = x0 + (GLfloat)widthCell;
+   GLfloat y1 = y0 + (GLfloat)GLUT_TEXT_HEIGHT;
+   GLfloat u0 = (GLfloat)((i % GLYPH_COLS) * widthCell) / (GLfloat)widthTexture;
+   GLfloat v0 = (GLfloat)((i / GLYPH_COLS) * GLUT_TEXT_HEIGHT) / (GLfloat)heightTexture;
+   GLfloat u1 = u0 + (GLfloat)widthCell / (GLfloat)widthTexture;
+   GLfloat v1 = v0 + (GLfloat)GLUT_TEXT_HEIGHT / (GLfloat)heightTexture;
+
+   batch.add(x0, y0, RGB_WHITE, u0, v0);
+   batch.add(x1, y0, RGB_WHITE, u1, v0);
+   batch.add(x1, y1, RGB_WHITE, u1, v1);
+   batch.add(x0, y1, RGB_WHITE, u0, v1);
+   return advances[i];
+}
+
+/*************************************************************************
+ * DRAW STRING
+ * One line of text with its baseline starting at (x, y). Each line is
+ * laid out once and remembered, so a label drawn every frame costs a
+ * copy of its quads. Without the atlas, GLUT draws it a letter at a time
+ *************************************************************************/
+static void drawString(GLfloat x, GLfloat y, const char * text, const int * rgb)
+{
+   if (!pAtlas || !pAtlas->isReady())
+   {
+      void* pFont = GLUT_TEXT;
+      drawFlush();
+      glColor(rgb);
+      glRasterPos2f(x, y);
+      for (const char* p = text; *p; p++)
+         glutBitmapCharacter(pFont, *p);
+      return;
+   }
 
-// normal squares: tan and brown
-const int RGB_WHITE_SQUARE[] = { 210, 180, 140 };
-const int RGB_BLACK_SQUARE[] = { 165, 42, 42 };
+   auto it = linesText.find(text);
+   if (it == linesText.end())
+   {
+      if (linesText.size() >= MAX_CACHED_LINES)
+         linesText.clear();
+      VertexBatch line;
+      GLfloat xPen = 0.0;
+      for (const char* p = text; *p; p++)
+         xPen += (GLfloat)pAtlas->addGlyph(line, xPen, 0.0, *p);
+      it = linesText.emplace(text, line).first;
+   }
+   batchText.append(it->second, x, y, rgb);
+}
 
-// the color of a selected square
-const int RGB_SELECTED[] = { 255, 0, 0 };
-//const int RGB_SELECTED[] = { 115, 88, 70 };
+/*************************************************************************
+ * DRAW PREPARE
+ * Build the window's glyph atlas, if we have not yet
+ *************************************************************************/
+void drawPrepare(int idWindow)
+{
+   pAtlas = &atlases[idWindow];
+   if (!pAtlas->isReady())
+      pAtlas->build();
+}
 
-// color of the coordinates
-const int RGB_LETTERS[] = { 128, 128, 128 };
+/*************************************************************************
+ * DRAW RESTORE
+ * Copy the front buffer, what is on the screen, over the back one. The
+ * raster position is the corner of the viewport, found with nothing
+ * between it and the window
+ *************************************************************************/
+void drawRestore()
+{
+   GLint viewport[4];
+   glGetIntegerv(GL_VIEWPORT, viewport);
+
+   glMatrixMode(GL_PROJECTION);
+   glPushMatrix();
+   glLoadIdentity();
+   glMatrixMode(GL_MODELVIEW);
+   glPushMatrix();
+   glLoadIdentity();
+
+   glReadBuffer(GL_FRONT);
+   glDrawBuffer(GL_BACK);
+   glRasterPos2i(-1, -1);
+   glCopyPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_COLOR);
+   glReadBuffer(GL_BACK);
+
+   glPopMatrix();
+   glMatrixMode(GL_PROJECTION);
+   glPopMatrix();
+   glMatrixMode(GL_MODELVIEW);
+}
 
-// color of the square around the board
-const int RGB_SQUARE[] = { 64, 64, 64 };
+/*************************************************************************
+ * DRAW FLUSH
+ * Send the pieces and highlights drawn so far to OpenGL, then the
+ * text over them
+ *************************************************************************/
+void drawFlush()
+{
+   batchFrame.draw(GL_QUADS);
+   batchFrame.clear();
+   batchText.draw(GL_QUADS, pAtlas ? pAtlas->getTexture() : 0);
+   batchText.clear();
+}
+
+/*************************************************************************
+ * GET DRAW CALLS
+ *************************************************************************/
+unsigned long getDrawCalls()
+{
+   return drawCalls;
+}
 
 /*************************************************************************
  * DISPLAY the text in the buffer on the screen
@@ -104,14 +438,7 @@ void ogstream::flush()
  ************************************************************************/
 void ogstream::drawText(const Position& topLeft, const char* text) const
 {
-    void* pFont = GLUT_TEXT;
-
-    // prepare to draw the text from the top-left corner
-    glRasterPos2f((GLfloat)topLeft.getX(), (GLfloat)topLeft.getY());
-
-    // loop through the text
-    for (const char* p = text; *p; p++)
-        glutBitmapCharacter(pFont, *p);
+    drawString((GLfloat)topLeft.getX(), (GLfloat)topLeft.getY(), text, RGB_WHITE);
 }
 
 /*************************************************************************
@@ -122,58 +449,35 @@ void ogstream::drawText(const Position& topLeft, const char* text) const
  ************************************************************************/
 void ogstream::drawLetter(const Position& topLeft, char letter) const
 {
-    void* pFont = GLUT_TEXT;
-
-    // prepare to draw the text from the top-left corner
-    glRasterPos2f((GLfloat)topLeft.getX(), (GLfloat)topLeft.getY());
-
-    // loop through the text
-    glutBitmapCharacter(pFont, letter);
+    char text[2] = { letter, '\0' };
+    drawString((GLfloat)topLeft.getX(), (GLfloat)topLeft.getY(), text, RGB_WHITE);
 }
 
 
-/************************************************************************
-* GL COLOR
-* Set the color on the board
-*   INPUT  rgb  RGB color in integers (0...255)
-*************************************************************************/
-void glColor(const int * rgb)
-{
-   glColor3f((GLfloat)(rgb[0] / 256.0), 
-             (GLfloat)(rgb[1] / 256.0),
-             (GLfloat)(rgb[2] / 256.0));
-}
-
 /************************************************************************
 * DRAW Piece
-* Draw a piece at a certain location on the board
+* Add a piece at a certain location on the board to this frame's batch
 *   INPUT  location   The location of the piece
 *          black      Whether the piece is black
 *          rectangles The rectangles of the piece
 *************************************************************************/
-void ogstream::drawPiece(bool black, Rect rectangle[], int num) const
+void ogstream::drawPiece(bool black, const Rect rectangle[], int num)
 {
    assert(position.isValid());
-   GLint x   = (GLint)((position.getCol() + 0.5) * 
-                       SIZE_SQUARE  + OFFSET_BOARD);
-   GLint y   = (GLint)((position.getRow() + 0.5) *
-                       SIZE_SQUARE + OFFSET_BOARD);
-
-   // get ready to draw
-   glBegin(GL_QUADS);
-   glColor(black ? RGB_BLACK : RGB_WHITE);
+   int x   = (int)((position.getCol() + 0.5) * 
+                   SIZE_SQUARE  + OFFSET_BOARD);
+   int y   = (int)((position.getRow() + 0.5) *
+                   SIZE_SQUARE + OFFSET_BOARD);
+   const int * rgb = black ? RGB_BLACK : RGB_WHITE;
 
    // iterate through the rectangles
    for (int i = 0; i < num; i++)
    { 
-      glVertex2i(x + rectangle[i].x0, y + rectangle[i].y0);
-      glVertex2i(x + rectangle[i].x1, y + rectangle[i].y1);
-      glVertex2i(x + rectangle[i].x2, y + rectangle[i].y2);
-      glVertex2i(x + rectangle[i].x3, y + rectangle[i].y3);
+      batchFrame.add(x + rectangle[i].x0, y + rectangle[i].y0, rgb);
+      batchFrame.add(x + rectangle[i].x1, y + rectangle[i].y1, rgb);
+      batchFrame.add(x + rectangle[i].x2, y + rectangle[i].y2, rgb);
+      batchFrame.add(x + rectangle[i].x3, y + rectangle[i].y3, rgb);
    }
-
-   // finish the drawing
-   glEnd();
 }
 
 /************************************************************************
@@ -184,7 +488,7 @@ void ogstream::drawPiece(bool black, Rect rectangle[], int num) const
 *************************************************************************/
 void ogstream::drawKing(const Position& pos, bool black)
 {
-   Rect rectangles[] =
+   static const Rect rectangles[] =
    {
       { 1,8,  -1,8,  -1,1,   1,1},     // cross vertical
       {-3,6,   3,6,   3,4,  -3,4},     // cross horizontal
@@ -207,7 +511,7 @@ void ogstream::drawKing(const Position& pos, bool black)
 *************************************************************************/
 void ogstream::drawQueen(const Position& pos, bool black)
 {
-   Rect rectangles[] =
+   static const Rect rectangles[] =
    {
       { 8,8,   5,8,   5,5,   8,5 },     // right crown jewel
       {-8,8,  -5,8,  -5,5,  -8,5 },     // left crown jewel
@@ -232,7 +536,7 @@ void ogstream::drawQueen(const Position& pos, bool black)
 *************************************************************************/
 void ogstream::drawRook(const Position& pos, bool black)
 {
-   Rect rectangles[] =
+   static const Rect rectangles[] =
    {
       {-8,7,  -8,4,  -4,4,  -4,7},   // left battlement
       { 8,7,   8,4,   4,4,   4,7},   // right battlement
@@ -253,7 +557,7 @@ void ogstream::drawRook(const Position& pos, bool black)
 *************************************************************************/
 void ogstream::drawKnight(const Position& pos, bool black)
 {
-   Rect rectangles[] =
+   static const Rect rectangles[] =
    {
       {-7,3,  -3,6,  -1,3,  -5,0},  // muzzle
       {-2,6,  -2,8,   0,8,   0,3},  // head
@@ -275,7 +579,7 @@ void ogstream::drawKnight(const Position& pos, bool black)
 *************************************************************************/
 void ogstream::drawBishop(const Position& pos, bool black)
 {
-   Rect rectangles[] =
+   static const Rect rectangles[] =
    {
       {-1,8,  -1,2,   1,2,   1,8 },   // center of head
       { 1,8,   1,2,   5,2,   5,5 },   // right part of head
@@ -297,7 +601,7 @@ void ogstream::drawBishop(const Position& pos, bool black)
 *************************************************************************/
 void ogstream::drawPawn(const Position& pos, bool black)
 {
-   Rect rectangles[] =
+   static const Rect rectangles[] =
    {
       { 1,7,  -1,7,  -2,5,  2,5 }, // top of head
       { 3,5,  -3,5,  -3,3,  3,3 }, // bottom of head
@@ -309,107 +613,110 @@ void ogstream::drawPawn(const Position& pos, bool black)
    drawPiece(black, rectangles, 4);
 }
 
+/************************************************************************
+* BOARD BATCHES
+* The squares and the two boxes around them never change, so we
+* build their vertices the first time and draw them from then on
+************************************************************************/
+static const VertexBatch & batchSquares()
+{
+   static VertexBatch batch;
+   if (batch.empty())
+      for (int row = 0; row < 8; row++)
+         for (int col = 0; col < 8; col++)
+            batch.addQuad((col + 0) * SIZE_SQUARE + 1 + OFFSET_BOARD,
+                          (row + 0) * SIZE_SQUARE + 1 + OFFSET_BOARD,
+                          (col + 1) * SIZE_SQUARE - 1 + OFFSET_BOARD,
+                          (row + 1) * SIZE_SQUARE - 1 + OFFSET_BOARD,
+                          // set the checker-board color
+                          (row + col) % 2 == 0 ? RGB_BLACK_SQUARE : RGB_WHITE_SQUARE);
+   return batch;
+}
+
+static const VertexBatch & batchBorder()
+{
+   static VertexBatch batch;
+   if (batch.empty())
+   {
+      // a box around the coordinates, then one around the edge
+      const int boxes[2][2] =
+      {
+         { OFFSET_BOARD / 2, 8 * SIZE_SQUARE + OFFSET_BOARD + OFFSET_BOARD / 2 },
+         { OFFSET_BOARD - 2, OFFSET_BOARD + 8 * SIZE_SQUARE + 2 }
+      };
+      for (int i = 0; i < 2; i++)
+      {
+         int inner  = boxes[i][0];
+         int outter = boxes[i][1];
+         const int corners[5][2] =
+         {
+            { inner, inner }, { inner, outter }, { outter, outter },
+            { outter, inner }, { inner, inner }
+         };
+         for (int side = 0; side < 4; side++)
+         {
+            batch.add(corners[side][0],     corners[side][1],     RGB_SQUARE);
+            batch.add(corners[side + 1][0], corners[side + 1][1], RGB_SQUARE);
+         }
+      }
+   }
+   return batch;
+}
+
 /************************************************************************
 * DRAW BOARD
 * Draw the chess board
 ************************************************************************/
 void ogstream::drawBoard()
 {
-   // draw the squares of the board
-   glBegin(GL_QUADS);
-   for (int row = 0; row < 8; row++)
-      for (int col = 0; col < 8; col++)
-      {
-         // set the checker-board color
-         if ((row + col) % 2 == 0)
-            glColor(RGB_BLACK_SQUARE);
-         else
-            glColor(RGB_WHITE_SQUARE);
-
-         // draw the square
-         GLint x0 = (GLint)((col + 0) * SIZE_SQUARE + 1 + OFFSET_BOARD);
-         GLint x1 = (GLint)((col + 1) * SIZE_SQUARE - 1 + OFFSET_BOARD);
-         GLint y0 = (GLint)((row + 0) * SIZE_SQUARE + 1 + OFFSET_BOARD);
-         GLint y1 = (GLint)((row + 1) * SIZE_SQUARE - 1 + OFFSET_BOARD);
-         glVertex2i(x0, y0);
-         glVertex2i(x1, y0);
-         glVertex2i(x1, y1);
-         glVertex2i(x0, y1);
-      }
-   glEnd();
-
-   // draw a box around the coordinates
-   glBegin(GL_LINE_STRIP);
-   glColor(RGB_SQUARE);
-   GLint inner = OFFSET_BOARD / 2;
-   GLint outter = 8 * SIZE_SQUARE + OFFSET_BOARD + OFFSET_BOARD / 2;
-   glVertex2i(inner, inner);
-   glVertex2i(inner, outter);
-   glVertex2i(outter, outter);
-   glVertex2i(outter, inner);
-   glVertex2i(inner, inner);
-   glEnd();
-   
-   // draw a box around the edge
-   inner = OFFSET_BOARD - 2;
-   outter = OFFSET_BOARD + 8 * SIZE_SQUARE + 2;
-   glBegin(GL_LINE_STRIP);
-   glVertex2i(inner, inner);
-   glVertex2i(inner, outter);
-   glVertex2i(outter, outter);
-   glVertex2i(outter, inner);
-   glVertex2i(inner, inner);
-   glEnd();
+   // whatever was drawn before the board goes under it
+   drawFlush();
+
+   // the squares of the board and the boxes around them
+   batchSquares().draw(GL_QUADS);
+   batchBorder().draw(GL_LINES);
 
-   
    // draw the letters along the bottom and the top
-   glColor(RGB_LETTERS);
    const GLfloat WIDTH_LETTER  = 4.0;  // width of one letter
    const GLfloat HEIGHT_LETTER = 14.0; // height of one letter
    const GLfloat TEXT_MARGIN   = 2.0;  // how close a letter can get to the edge
    for (int col = 0; col < 8; col++)
    {
-      void* pFont = GLUT_TEXT;
-
       // Bottom row
       GLfloat xPos = (GLfloat)OFFSET_BOARD +         // indent by the board margin
                      (GLfloat)(col * SIZE_SQUARE) +  // tab over by the number of columns
                      (GLfloat)(SIZE_SQUARE / 2) +    // center on the column
                      -WIDTH_LETTER;                  // back up by the width of a letter
       GLfloat yPos = TEXT_MARGIN;                    // just a bit from the bottom
-      glRasterPos2f(xPos, yPos);
-      glutBitmapCharacter(pFont, (char)('a' + col));
+      char letter[2] = { (char)('a' + col), '\0' };
+      drawString(xPos, yPos, letter, RGB_LETTERS);
 
       // top row
       yPos = (GLfloat)(OFFSET_BOARD * 2) +           // add the margins and...
              (GLfloat)(8 * SIZE_SQUARE) +            // add the size of the squares
              -HEIGHT_LETTER +                        // subtract the size of a letter
              -TEXT_MARGIN;                           // just a bit from the bottom
-      glRasterPos2f(xPos, yPos);
-      glutBitmapCharacter(pFont, (char)('a' + col));
+      drawString(xPos, yPos, letter, RGB_LETTERS);
    }
 
    // draw the numbers along the side
    for (int row = 0; row < 8; row++)
    {
-      void* pFont = GLUT_TEXT;
-      
       // left column
       GLfloat xPos = TEXT_MARGIN;                    // just a bit from the side
       GLfloat yPos = (GLfloat)OFFSET_BOARD +         // indent by the board margin
       (GLfloat)(row * SIZE_SQUARE) +  // tab over by the number of rows
       (GLfloat)(SIZE_SQUARE / 2) +    // center on the row
       -HEIGHT_LETTER/2;               // back up by the height of a letter
-      glRasterPos2f(xPos, yPos);
-      glutBitmapCharacter(pFont, (char)('1' + row));
+      char number[2] = { (char)('1' + row), '\0' };
+      drawString(xPos, yPos, number, RGB_LETTERS);
       
       // right column
       xPos = (GLfloat)(OFFSET_BOARD * 2) +           // add the margins and...
       (GLfloat)(8 * SIZE_SQUARE) +            // add the size of the squares
       -HEIGHT_LETTER +                        // subtract the size of a letter
       -TEXT_MARGIN;                           // just a bit from the bottom
-      glRasterPos2f(xPos, yPos);
-      glutBitmapCharacter(pFont, (char)('1' + row));
+      drawString(xPos, yPos, number, RGB_LETTERS);
    }
 }
 
@@ -428,24 +735,12 @@ void ogstream::drawSelected(const Position& pos)
    int row = pos.getRow();
    int col = pos.getCol();
 
-
-   // set the color and drawing style
-   glBegin(GL_QUADS);
-   glColor(RGB_SELECTED);
-
-   // draw the square
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + 3 + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + 3 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE - 3 + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + 3 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE - 3 + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE - 3 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + 3 + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE - 3 + OFFSET_BOARD));
-
-   // indicate we are finished
-   glEnd();
-
+   // the square
+   batchFrame.addQuad((col + 0) * SIZE_SQUARE + 3 + OFFSET_BOARD,
+                      (row + 0) * SIZE_SQUARE + 3 + OFFSET_BOARD,
+                      (col + 1) * SIZE_SQUARE - 3 + OFFSET_BOARD,
+                      (row + 1) * SIZE_SQUARE - 3 + OFFSET_BOARD,
+                      RGB_SELECTED);
 }
 
 /************************************************************************
@@ -463,39 +758,19 @@ void ogstream::drawHover(const Position& pos)
    int row = pos.getRow();
    int col = pos.getCol();
 
-   // set the color and drawing style
-   glBegin(GL_QUADS);
-   glColor(RGB_SELECTED);
-
-   // draw the square
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE + OFFSET_BOARD));
-
-   // set the checker-board color
-   if ((row + col) % 2 == 0)
-      glColor(RGB_BLACK_SQUARE);
-   else
-      glColor(RGB_WHITE_SQUARE);
-
-   // draw the square
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + 2 + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + 2 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE - 2 + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + 2 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE - 2 + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE - 2 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + 2 + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE - 2 + OFFSET_BOARD));
-
-
-   // finish the drawing
-   glEnd();
+   // the outline
+   batchFrame.addQuad((col + 0) * SIZE_SQUARE + OFFSET_BOARD,
+                      (row + 0) * SIZE_SQUARE + OFFSET_BOARD,
+                      (col + 1) * SIZE_SQUARE + OFFSET_BOARD,
+                      (row + 1) * SIZE_SQUARE + OFFSET_BOARD,
+                      RGB_SELECTED);
+
+   // and the square inside it in the checker-board color
+   batchFrame.addQuad((col + 0) * SIZE_SQUARE + 2 + OFFSET_BOARD,
+                      (row + 0) * SIZE_SQUARE + 2 + OFFSET_BOARD,
+                      (col + 1) * SIZE_SQUARE - 2 + OFFSET_BOARD,
+                      (row + 1) * SIZE_SQUARE - 2 + OFFSET_BOARD,
+                      (row + col) % 2 == 0 ? RGB_BLACK_SQUARE : RGB_WHITE_SQUARE);
 }
 
 /************************************************************************
@@ -513,23 +788,41 @@ void ogstream::drawPossible(const Position& pos)
    int row = pos.getRow();
    int col = pos.getCol();
 
-   // set the color and drawing style
-   glBegin(GL_QUADS);
-   glColor(RGB_SELECTED);
-
-   // draw the square
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + 7  + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + 7 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE - 7  + OFFSET_BOARD),
-              (GLint)((row + 0) * SIZE_SQUARE + 7 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 1) * SIZE_SQUARE - 7  + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE - 7 + OFFSET_BOARD));
-   glVertex2i((GLint)((col + 0) * SIZE_SQUARE + 7  + OFFSET_BOARD),
-              (GLint)((row + 1) * SIZE_SQUARE - 7 + OFFSET_BOARD));
-
-   // finish the drawing
-   glEnd();
+   // the square
+   batchFrame.addQuad((col + 0) * SIZE_SQUARE + 7 + OFFSET_BOARD,
+                      (row + 0) * SIZE_SQUARE + 7 + OFFSET_BOARD,
+                      (col + 1) * SIZE_SQUARE - 7 + OFFSET_BOARD,
+                      (row + 1) * SIZE_SQUARE - 7 + OFFSET_BOARD,
+                      RGB_SELECTED);
 }
 
+/************************************************************************
+* DRAW SQUARE
+* One square of the board: the background around it, then the square
+* in the checker-board color, just as drawBoard() left it
+*   INPUT  pos  The square to draw
+************************************************************************/
+void ogstream::drawSquare(const Position& pos)
+{
+   // do nothing if there is nothing to do
+   if (pos.isInvalid())
+      return;
 
+   // find the row and column
+   int row = pos.getRow();
+   int col = pos.getCol();
 
+   // the background, where a hover outline may have been
+   batchFrame.addQuad((col + 0) * SIZE_SQUARE + OFFSET_BOARD,
+                      (row + 0) * SIZE_SQUARE + OFFSET_BOARD,
+                      (col + 1) * SIZE_SQUARE + OFFSET_BOARD,
+                      (row + 1) * SIZE_SQUARE + OFFSET_BOARD,
+                      RGB_BLACK);
+
+   // and the square
+   batchFrame.addQuad((col + 0) * SIZE_SQUARE + 1 + OFFSET_BOARD,
+                      (row + 0) * SIZE_SQUARE + 1 + OFFSET_BOARD,
+                      (col + 1) * SIZE_SQUARE - 1 + OFFSET_BOARD,
+                      (row + 1) * SIZE_SQUARE - 1 + OFFSET_BOARD,
+                      (row + col) % 2 == 0 ? RGB_BLACK_SQUARE : RGB_WHITE_SQUARE);
+}
@@ -16,6 +16,23 @@
 #include <sstream>    // for OSTRINGSTRING
 using std::string;
 
+// pieces: black and white
+const int RGB_WHITE[] = { 255, 255, 255 };
+const int RGB_BLACK[] = { 0, 0, 0 };
+
+// normal squares: tan and brown
+const int RGB_WHITE_SQUARE[] = { 210, 180, 140 };
+const int RGB_BLACK_SQUARE[] = { 165, 42, 42 };
+
+// the color of a selected square
+const int RGB_SELECTED[] = { 255, 0, 0 };
+
+// color of the coordinates
+const int RGB_LETTERS[] = { 128, 128, 128 };
+
+// color of the square around the board
+const int RGB_SQUARE[] = { 64, 64, 64 };
+
  /*************************************************************************
   * GRAPHICS STREAM
   * A graphics stream that behaves much like COUT except on a drawn screen.
@@ -51,11 +68,13 @@ public:
     virtual void drawHover(   const Position& pos);
     virtual void drawPossible(const Position& pos);
 
+    // One square of the board over whatever was there, so only the
+    // squares that changed need drawing again
+    virtual void drawSquare(const Position& pos);
+
 protected:
     Position position;
 
-private:
-
     /************************************************************************
     * RECT
     * One rectangle
@@ -72,7 +91,36 @@ private:
         int y3;
     };
 
-    void drawPiece(bool black, Rect rectangle[], int num) const;
+    // draw the rectangles of a piece centered on position
+    virtual void drawPiece(bool black, const Rect rectangle[], int num);
+
+private:
     void drawText(const Position& topLeft, const char* text) const;
     void drawLetter(const Position& topLeft, char letter) const;
 };
+
+/*************************************************************************
+ * DRAW FLUSH
+ * The pieces and highlights are gathered into one batch, the text into
+ * another, and both sent to OpenGL together: before the board and at
+ * the end of every frame
+ *************************************************************************/
+void drawFlush();
+
+/*************************************************************************
+ * DRAW PREPARE
+ * Get ready to draw in a window, before the frame is cleared: the first
+ * time, the font is drawn into a texture so text can be drawn as quads.
+ * Each window has its own OpenGL context, so its own texture
+ *************************************************************************/
+void drawPrepare(int idWindow);
+
+/*************************************************************************
+ * DRAW RESTORE
+ * After a swap the buffer we draw into holds nothing we can count on,
+ * so copy what is on the screen into it before drawing only what changed
+ *************************************************************************/
+void drawRestore();
+
+// how many batches have been sent to OpenGL so far
+unsigned long getDrawCalls();
@@ -0,0 +1,232 @@
+/***********************************************************************
+ * Source File:
+ *    USER INTERFACE IMAGE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Draw the board into an Image, the same layout ogstream draws in
+ *    the window, and the batch mode that turns FENs into pictures
+ ************************************************************************/
+
+#include "uiImage.h"
+#include "board.h"    // for BOARD
+#include <chrono>     // for STEADY_CLOCK
+using namespace std;
+
+// the window's size in its own units: the board and a margin around it
+const int SIZE_WINDOW = 8 * SIZE_SQUARE + 2 * OFFSET_BOARD;
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : CONSTRUCT
+ *************************************************************************/
+ogstreamImage::ogstreamImage(double scale) :
+   ogstream(),
+   scale(scale),
+   image((int)(SIZE_WINDOW * scale + 0.5), (int)(SIZE_WINDOW * scale + 0.5))
+{
+}
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : CLEAR
+ *************************************************************************/
+void ogstreamImage::clear()
+{
+   str("");
+   image.clipNone();
+   image.clear(RGB_BLACK);
+}
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : FLUSH
+ * Like ogstream::flush(), a line at a time down from position
+ *************************************************************************/
+void ogstreamImage::flush()
+{
+   string text = str();
+   size_t begin = 0;
+   while (begin < text.size())
+   {
+      size_t end = text.find('\n', begin);
+      if (end == string::npos)
+         end = text.size();
+      image.drawText(position.getX() * scale, position.getY() * scale,
+                     text.substr(begin, end - begin).c_str(), RGB_WHITE);
+      position.adjustRow(-1);
+      begin = end + 1;
+   }
+   str("");
+}
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : FILL SQUARE
+ * A square of the board, inset pixels (in the window's units) from
+ * its edges
+ *************************************************************************/
+void ogstreamImage::fillSquare(int col, int row, int inset, const int * rgb)
+{
+   image.fillRect(((col + 0) * SIZE_SQUARE + inset + OFFSET_BOARD) * scale,
+                  ((row + 0) * SIZE_SQUARE + inset + OFFSET_BOARD) * scale,
+                  ((col + 1) * SIZE_SQUARE - inset + OFFSET_BOARD) * scale,
+                  ((row + 1) * SIZE_SQUARE - inset + OFFSET_BOARD) * scale,
+                  rgb);
+}
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : DRAW PIECE
+ *************************************************************************/
+void ogstreamImage::drawPiece(bool black, const Rect rectangle[], int num)
+{
+   double x = (position.getCol() + 0.5) * SIZE_SQUARE + OFFSET_BOARD;
+   double y = (position.getRow() + 0.5) * SIZE_SQUARE + OFFSET_BOARD;
+   for (int i = 0; i < num; i++)
+   {
+      const double xs[4] =
+      {
+         (x + rectangle[i].x0) * scale, (x + rectangle[i].x1) * scale,
+         (x + rectangle[i].x2) * scale, (x + rectangle[i].x3) * scale
+      };
+      const double ys[4] =
+      {
+         (y + rectangle[i].y0) * scale, (y + rectangle[i].y1) * scale,
+         (y + rectangle[i].y2) * scale, (y + rectangle[i].y3) * scale
+      };
+      image.fillQuad(xs, ys, black ? RGB_BLACK : RGB_WHITE);
+   }
+}
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : DRAW BOARD
+ * The squares, the two boxes around them, and the coordinates
+ *************************************************************************/
+void ogstreamImage::drawBoard()
+{
+   for (int row = 0; row < 8; row++)
+      for (int col = 0; col < 8; col++)
+         fillSquare(col, row, 1,
+                    (row + col) % 2 == 0 ? RGB_BLACK_SQUARE : RGB_WHITE_SQUARE);
+
+   const int boxes[2][2] =
+   {
+      { OFFSET_BOARD / 2, 8 * SIZE_SQUARE + OFFSET_BOARD + OFFSET_BOARD / 2 },
+      { OFFSET_BOARD - 2, OFFSET_BOARD + 8 * SIZE_SQUARE + 2 }
+   };
+   for (int i = 0; i < 2; i++)
+   {
+      double inner  = boxes[i][0] * scale;
+      double outter = boxes[i][1] * scale;
+      image.drawLine(inner,  inner,  inner,  outter, RGB_SQUARE);
+      image.drawLine(inner,  outter, outter, outter, RGB_SQUARE);
+      image.drawLine(outter, outter, outter, inner,  RGB_SQUARE);
+      image.drawLine(outter, inner,  inner,  inner,  RGB_SQUARE);
+   }
+
+   // the letters along the bottom and the top, the numbers on the sides
+   const double TEXT_MARGIN = 2.0;
+   for (int i = 0; i < 8; i++)
+   {
+      char letter[2] = { (char)('a' + i), '\0' };
+      double x = (OFFSET_BOARD + i * SIZE_SQUARE + SIZE_SQUARE / 2) * scale
+                 - Image::getTextWidth(letter) / 2;
+      image.drawText(x, TEXT_MARGIN * scale, letter, RGB_LETTERS);
+      image.drawText(x, (SIZE_WINDOW - OFFSET_BOARD / 2 + TEXT_MARGIN) * scale,
+                     letter, RGB_LETTERS);
+
+      char number[2] = { (char)('1' + i), '\0' };
+      double y = (OFFSET_BOARD + i * SIZE_SQUARE + SIZE_SQUARE / 2) * scale - 3;
+      image.drawText(TEXT_MARGIN * scale, y, number, RGB_LETTERS);
+      image.drawText((SIZE_WINDOW - OFFSET_BOARD / 2 + TEXT_MARGIN) * scale, y,
+                     number, RGB_LETTERS);
+   }
+}
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : HIGHLIGHTS
+ * The same insets as the window
+ *************************************************************************/
+void ogstreamImage::drawSelected(const Position& pos)
+{
+   if (pos.isValid())
+      fillSquare(pos.getCol(), pos.getRow(), 3, RGB_SELECTED);
+}
+
+void ogstreamImage::drawHover(const Position& pos)
+{
+   if (pos.isInvalid())
+      return;
+   int row = pos.getRow();
+   int col = pos.getCol();
+   fillSquare(col, row, 0, RGB_SELECTED);
+   fillSquare(col, row, 2, (row + col) % 2 == 0 ? RGB_BLACK_SQUARE : RGB_WHITE_SQUARE);
+}
+
+void ogstreamImage::drawPossible(const Position& pos)
+{
+   if (pos.isValid())
+      fillSquare(pos.getCol(), pos.getRow(), 7, RGB_SELECTED);
+}
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM : DRAW SQUARE
+ * The background where a hover outline may have been, then the square
+ *************************************************************************/
+void ogstreamImage::drawSquare(const Position& pos)
+{
+   if (pos.isInvalid())
+      return;
+   int row = pos.getRow();
+   int col = pos.getCol();
+   fillSquare(col, row, 0, RGB_BLACK);
+   fillSquare(col, row, 1, (row + col) % 2 == 0 ? RGB_BLACK_SQUARE : RGB_WHITE_SQUARE);
+}
+
+/*************************************************************************
+ * RENDER BATCH
+ * One board and one image for every position, so drawing a picture
+ * allocates nothing; only writing it does
+ *************************************************************************/
+int renderBatch(istream & in, const string & dirOut, const string & extension,
+                double scale, ostream & out)
+{
+   ogstreamImage gout(scale);
+   Board board(&gout);
+   Position posNone(-1);
+
+   int numDrawn = 0;
+   int numFailed = 0;
+   double secondsDraw = 0.0;
+   auto start = chrono::steady_clock::now();
+   string fen;
+   for (int line = 1; getline(in, fen); line++)
+   {
+      if (fen.empty())
+         continue;
+      if (!board.setFen(fen))
+      {
+         out << "line " << line << ": cannot show \"" << fen << "\"\n";
+         numFailed++;
+         continue;
+      }
+
+      auto startDraw = chrono::steady_clock::now();
+      gout.clear();
+      board.markAllDirty();
+      board.display(posNone, posNone);
+      secondsDraw += chrono::duration<double>(chrono::steady_clock::now() - startDraw).count();
+
+      string fileName = dirOut + "/" + to_string(line) + extension;
+      if (!gout.getImage().write(fileName))
+      {
+         out << "cannot write " << fileName << "\n";
+         numFailed++;
+         continue;
+      }
+      numDrawn++;
+   }
+
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+   out << "rendered " << numDrawn << " positions in " << seconds << "s: "
+       << (seconds > 0.0 ? (long)(numDrawn / seconds) : 0) << " per second, "
+       << (secondsDraw > 0.0 ? (long)(numDrawn / secondsDraw) : 0)
+       << " per second without writing\n";
+   return numFailed;
+}
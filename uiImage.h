@@ -0,0 +1,61 @@
+/***********************************************************************
+ * Header File:
+ *    USER INTERFACE IMAGE
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    An ogstream that draws into an Image instead of an OpenGL window,
+ *    so positions can be turned into pictures without a display. The
+ *    pieces are the same rectangles the window draws.
+ ************************************************************************/
+
+#pragma once
+
+#include "uiDraw.h"   // for OGSTREAM
+#include "image.h"    // for IMAGE
+#include <string>     // for STRING
+#include <iostream>   // for ISTREAM
+
+/*************************************************************************
+ * IMAGE GRAPHICS STREAM
+ * The board is drawn in the window's units, scaled by scale into the
+ * image. Call clear() before each picture
+ *************************************************************************/
+class ogstreamImage : public ogstream
+{
+public:
+    ogstreamImage(double scale = 1.0);
+    ~ogstreamImage() { flush(); }
+
+    // start over with an empty picture
+    void clear();
+    const Image & getImage() const { return image; }
+
+    // text goes into the image too
+    virtual void flush();
+
+    // Methods to draw the board
+    virtual void drawBoard();
+    virtual void drawSelected(const Position& pos);
+    virtual void drawHover(   const Position& pos);
+    virtual void drawPossible(const Position& pos);
+    virtual void drawSquare(  const Position& pos);
+
+protected:
+    virtual void drawPiece(bool black, const Rect rectangle[], int num);
+
+private:
+    void fillSquare(int col, int row, int inset, const int * rgb);
+
+    double scale;
+    Image image;
+};
+
+/*************************************************************************
+ * RENDER BATCH
+ * One FEN per line in, one picture per line out: dirOut/1.png, 2.png...
+ * (or .ppm). Lines that are not a position we can show are skipped.
+ * Reports how many were drawn and how fast. Returns how many failed
+ *************************************************************************/
+int renderBatch(std::istream & in, const std::string & dirOut,
+                const std::string & extension, double scale, std::ostream & out);
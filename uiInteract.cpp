@@ -15,6 +15,10 @@
 #include <cassert>    // I feel the need... the need for asserts
 #include <time.h>     // for clock
 #include <cstdlib>    // for rand()
+#include <chrono>     // for STEADY_CLOCK
+#include <iostream>   // for CERR
+#include <iomanip>    // for SETPRECISION
+#include <map>        // for MAP of windows
 
 
 #ifdef __APPLE__
@@ -28,6 +32,10 @@
 #include <GL/glut.h>  // Second OpenGL library
 #endif // __linux__
 
+#ifndef _WIN32
+#include <sys/resource.h>   // for GETRUSAGE
+#endif // !_WIN32
+
 #ifdef _WIN32
 #include <stdio.h>
 #include <stdlib.h>
@@ -40,9 +48,14 @@
 #endif // _WIN32
 
 #include "uiInteract.h"
+#include "uiDraw.h"
+#include "trace.h"
 
 using namespace std;
 
+// how often we look for redraws asked for by other threads
+const unsigned int MS_POLL = 50;
+
 
 /*********************************************************************
  * SLEEP
@@ -72,6 +85,50 @@ void sleep(unsigned long msSleep)
    return;
 }
 
+/*********************************************************************
+ * CPU SECONDS
+ * The processor time this process has used, in every thread
+ *********************************************************************/
+static double cpuSeconds()
+{
+#ifdef _WIN32
+   FILETIME create, exit, kernel, user;
+   if (!GetProcessTimes(GetCurrentProcess(), &create, &exit, &kernel, &user))
+      return 0.0;
+   ULARGE_INTEGER k, u;
+   k.LowPart = kernel.dwLowDateTime;
+   k.HighPart = kernel.dwHighDateTime;
+   u.LowPart = user.dwLowDateTime;
+   u.HighPart = user.dwHighDateTime;
+   return (double)(k.QuadPart + u.QuadPart) * 1e-7;   // 100ns units
+#else // LINUX, XCODE
+   rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0.0;
+   return (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+          (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif // LINUX, XCODE
+}
+
+static double wallSeconds()
+{
+   return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// every open window, by its GLUT id
+static map <int, Interface *> sessions;
+
+/*********************************************************************
+ * POST IF REQUESTED
+ * Hand a pending redraw to GLUT, which draws once no matter
+ * how many times it was asked. Only from the main thread
+ *********************************************************************/
+static void postIfRequested(const Interface & ui)
+{
+   if (ui.getRenderMode() == Interface::RENDER_ON_DEMAND && ui.isRedrawRequested())
+      glutPostWindowRedisplay(ui.getSessionId());
+}
+
 /************************************************************************
  * DRAW CALLBACK
  * This is the main callback from OpenGL. It gets called constantly by
@@ -80,26 +137,53 @@ void sleep(unsigned long msSleep)
  * when the appropriate time period has passsed.
  *
  * Note: This and all other callbacks can't be member functions, they must
- * have global scope for OpenGL to see them.
+ * have global scope for OpenGL to see them. GLUT makes the window the
+ * event is for the current one, which tells us which session it is.
  *************************************************************************/
 void drawCallback()
 {
-   // even though this is a local variable, all the members are static
-   Interface ui;
-   // Prepare the background buffer for drawing
-   glClear(GL_COLOR_BUFFER_BIT); //clear the screen
+   TRACE_SCOPE("render");
+   auto start = chrono::steady_clock::now();
+
+   Interface * pUI = Interface::find(glutGetWindow());
+   if (!pUI)
+      return;
+   Interface & ui = *pUI;
+   ui.frames++;
+
+   // anything asked for from here on needs another frame
+   ui.fRedraw = false;
+   drawPrepare(ui.getSessionId());
+
+   // Prepare the background buffer for drawing. Unless the window is
+   // new, or the window system lost some of the screen when part of
+   // it was uncovered, start with what is on the screen now
+   if (glutLayerGet(GLUT_NORMAL_DAMAGED))
+      ui.fFull = true;
+   if (ui.needsFullRedraw())
+      glClear(GL_COLOR_BUFFER_BIT); //clear the screen
+   else
+      drawRestore();
    glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
    
    //calls the client's display function
    assert(ui.callBack != NULL);
    ui.callBack(&ui, ui.p);
+
+   // whatever the client drew is still waiting in the batch
+   drawFlush();
+   ui.msFrames += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+   ui.fFull = false;
    
-   //loop until the timer runs out
-   if (!ui.isTimeToDraw())
-      sleep((unsigned long)((ui.getNextTick() - clock()) / 1000));
+   // at a fixed rate, loop until the timer runs out
+   if (ui.getRenderMode() == Interface::RENDER_FIXED_FPS)
+   {
+      if (!ui.isTimeToDraw())
+         sleep((unsigned long)((ui.getNextTick() - clock()) / 1000));
 
-   // from this point, set the next draw time
-   ui.setNextDrawTime();
+      // from this point, set the next draw time
+      ui.setNextDrawTime();
+   }
 
    // bring forth the background buffer
    glutSwapBuffers();
@@ -118,19 +202,20 @@ void clickCallback(int button, int state, int x, int y)
    // determine what to do if the button is selected
    if (button == GLUT_LEFT_BUTTON && state == GLUT_DOWN)
    {
-      // Even though this is a local variable, all the members are static
-      // so we are actually getting the same version as in the constructor.
-      Interface ui;
+      Interface * pUI = Interface::find(glutGetWindow());
+      if (!pUI)
+         return;
 
       // get coordinates from screen dimensions
       Position pos;
-      pos.setXY((double)x, (double)y);
+      pos.setXY((double)x, (double)y, pUI->squareWidth, pUI->squareHeight);
 
       // if the current cell is selected, then deselect it
-      if (ui.getSelectPosition() == pos)
-         ui.clearSelectPosition();
+      if (pUI->getSelectPosition() == pos)
+         pUI->clearSelectPosition();
       else
-         ui.setSelectPosition(pos);
+         pUI->setSelectPosition(pos);
+      postIfRequested(*pUI);
    }
 }
 
@@ -141,15 +226,17 @@ void clickCallback(int button, int state, int x, int y)
  *************************************************************************/
 void moveCallback(int x, int y)
 {
-   // Even though this is a local variable, all the members are static
-   // so we are actually getting the same version as in the constructor.
-   Interface ui;
-   Position pos;
+   Interface * pUI = Interface::find(glutGetWindow());
+   if (!pUI)
+      return;
 
    // get coordinates from screen dimensions
-   pos.setXY((double)x, (double)y);
+   Position pos;
+   pos.setXY((double)x, (double)y, pUI->squareWidth, pUI->squareHeight);
 
-   ui.setHoverPosition(pos);
+   // only a new square is worth drawing again
+   pUI->setHoverPosition(pos);
+   postIfRequested(*pUI);
 }
 
 /************************************************************************
@@ -159,14 +246,42 @@ void moveCallback(int x, int y)
  *************************************************************************/
 void resizeCallback(int width, int height)
 {
-    // Even though this is a local variable, the square_width and square_height
-    // member variables are static.
-    Position pos;
+    Interface * pUI = Interface::find(glutGetWindow());
+    if (!pUI)
+       return;
 
-    pos.setSquareWidth ((double)(width - OFFSET_BOARD * 2) / 8.0 );
-    pos.setSquareHeight((double)(height- OFFSET_BOARD * 2) / 8.0);
+    pUI->squareWidth  = (double)(width - OFFSET_BOARD * 2) / 8.0;
+    pUI->squareHeight = (double)(height- OFFSET_BOARD * 2) / 8.0;
 
     glViewport(0, 0, width, height);
+    pUI->fFull = true;
+    pUI->requestRedraw();
+    postIfRequested(*pUI);
+}
+
+/************************************************************************
+ * POLL CALLBACK
+ * Other threads cannot talk to GLUT, so they only set a flag
+ * with requestRedraw(). A few times a second we look at it
+ * for every window
+ *************************************************************************/
+void pollCallback(int value)
+{
+   for (auto & session : sessions)
+      postIfRequested(*session.second);
+   glutTimerFunc(MS_POLL, pollCallback, 0);
+}
+
+/************************************************************************
+ * IDLE CALLBACK
+ * There is one idle function for all the windows, so it asks
+ * for a frame from each one drawn at a fixed rate
+ *************************************************************************/
+void idleCallback()
+{
+   for (auto & session : sessions)
+      if (session.second->renderMode == Interface::RENDER_FIXED_FPS)
+         glutPostWindowRedisplay(session.first);
 }
 
 /************************************************************************
@@ -210,23 +325,65 @@ void Interface::setFramesPerSecond(double value)
     timePeriod = (1.0 / value);
 }
 
+/************************************************************************
+ * INTERFACE : SET RENDER MODE
+ * On demand, GLUT is idle until something asks for a frame. At a fixed
+ * rate, the idle function asks for frames and drawing sleeps until the
+ * next one is due. The idle function is only there while some window
+ * wants it
+ *************************************************************************/
+void Interface::setRenderMode(RenderMode mode)
+{
+   renderMode = mode;
+   bool fAnyFixed = false;
+   for (auto & session : sessions)
+      fAnyFixed = fAnyFixed || session.second->renderMode == RENDER_FIXED_FPS;
+   glutIdleFunc(fAnyFixed ? idleCallback : NULL);
+   requestRedraw();
+}
+
+/************************************************************************
+ * INTERFACE : GET CPU USAGE
+ * CPU seconds used per wall second since the first window opened: 1.0
+ * is one core kept busy the whole time
+ *************************************************************************/
+double Interface::getCpuUsage()
+{
+   double wall = wallSeconds() - wallStart;
+   return wall > 0.0 ? (cpuSeconds() - cpuStart) / wall : 0.0;
+}
+
+/************************************************************************
+ * INTERFACE : REPORT USAGE
+ * A line per window on the way out, so the two modes can be compared.
+ * The draw calls are counted for all the windows together
+ *************************************************************************/
+void Interface::reportUsage()
+{
+   unsigned long framesAll = 0;
+   for (auto & session : sessions)
+   {
+      const Interface & ui = *session.second;
+      framesAll += ui.frames;
+      cerr << "render " << session.first << ": "
+           << (ui.renderMode == RENDER_ON_DEMAND ? "on demand" : "fixed fps")
+           << ", " << ui.frames << " frames, " << fixed
+           << setprecision(3) << ui.getFrameTime() << "ms per frame\n";
+   }
+   cerr << "render: " << sessions.size() << " windows in " << fixed << setprecision(1)
+        << wallSeconds() - wallStart << "s, "
+        << setprecision(1) << (framesAll ? (double)getDrawCalls() / framesAll : 0.0)
+        << " draw calls per frame, "
+        << setprecision(2) << getCpuUsage() * 100.0 << "% cpu\n";
+}
+
 /***************************************************
  * STATICS
- * All the static member variables need to be initialized
- * Somewhere globally.  This is a good spot
+ * Only what all the windows share
  **************************************************/
-Position      Interface::posHover = -1;
-Position      Interface::posSelect = -1;
-Position      Interface::posSelectPrevious = -1;
 bool          Interface::initialized   = false;
-double        Interface::timePeriod    = 0.2; // default to 5 frames/second
-unsigned long Interface::nextTick      = 0;        // redraw now please
-void *        Interface::p             = NULL;
-void (*Interface::callBack)(Interface *, void *) = NULL;
-char          Interface::key          = '\0';
-
-double Position::squareWidth  = (double)SIZE_SQUARE;
-double Position::squareHeight = (double)SIZE_SQUARE;
+double        Interface::cpuStart      = 0.0;
+double        Interface::wallStart     = 0.0;
 
 /***************************************************************
  * KEYBOARD CALLBACK
@@ -235,10 +392,12 @@ double Position::squareHeight = (double)SIZE_SQUARE;
  ***************************************************************/
 void keyboardCallback(unsigned char key, int x, int y)
 {
-   // Even though this is a local variable, all the members are static
-   // so we are actually getting the same version as in the constructor.
-   Interface ui;
-   ui.keyEvent(key, true /*fDown*/);
+   Interface * pUI = Interface::find(glutGetWindow());
+   if (!pUI)
+      return;
+   pUI->keyEvent(key, true /*fDown*/);
+   pUI->requestRedraw();
+   postIfRequested(*pUI);
 }
 
 /***************************************************************
@@ -262,45 +421,99 @@ void Interface::resetKey()
 {
    this->key = '\0';
 }
+
+/************************************************************************
+ * INTERFACE : CONSTRUCT
+ * Every window starts drawn on demand at 5 frames a second, with
+ * squares of SIZE_SQUARE pixels and the first frame drawn in full
+ *************************************************************************/
+Interface::Interface(const char * title) :
+   idWindow(0),
+   p(NULL),
+   callBack(NULL),
+   timePeriod(0.2),                  // default to 5 frames/second
+   nextTick(0),                      // redraw now please
+   renderMode(RENDER_ON_DEMAND),
+   fRedraw(true),                    // the first frame
+   frames(0),
+   fFull(true),                      // nothing is drawn yet
+   msFrames(0.0),
+   squareWidth((double)SIZE_SQUARE),
+   squareHeight((double)SIZE_SQUARE),
+   posHover(-1),
+   posSelect(-1),
+   posSelectPrevious(-1),
+   key('\0')
+{
+   initialize(title);
+}
+
+/************************************************************************
+ * INTERFACE : DESTRUCT
+ * Close the window. GLUT sends nothing more for it
+ *************************************************************************/
+Interface::~Interface()
+{
+   sessions.erase(idWindow);
+   if (idWindow)
+      glutDestroyWindow(idWindow);
+}
+
+/************************************************************************
+ * INTERFACE : FIND
+ *************************************************************************/
+Interface * Interface::find(int idWindow)
+{
+   auto it = sessions.find(idWindow);
+   return it == sessions.end() ? nullptr : it->second;
+}
+
 /************************************************************************
  * INTEFACE : INITIALIZE
  * Initialize our drawing window.  This will set the size and position,
  * get ready for drawing, set up the colors, and everything else ready to
- * draw the window.  All these are part of initializing Open GL.
- *  INPUT    argc:       Count of command-line arguments from main
- *           argv:       The actual command-line parameters
- *           title:      The text for the titlebar of the window
+ * draw the window.  All these are part of initializing Open GL. GLUT
+ * itself is only set up for the first window.
+ *  INPUT    title:      The text for the titlebar of the window
  *************************************************************************/
 void Interface::initialize(const char * title)
 {
-   if (initialized)
-      return;
-   Position pos;
+   if (!initialized)
+   {
+      // set up the random number generator
+      srand((unsigned int)time(NULL));
+
+      int argc = 0;
+      glutInit(&argc, NULL);
+      glutTimerFunc(MS_POLL, pollCallback, 0);
+      initialized = true;
+
+      // from here on we count what drawing costs
+      cpuStart  = cpuSeconds();
+      wallStart = wallSeconds();
+      atexit(reportUsage);
+   }
 
-   // set up the random number generator
-   srand((unsigned int)time(NULL));
-
-   // create the window
-   int argc = 0;
-   glutInit(&argc, NULL);
-   glutInitWindowSize(8 * (int)pos.getSquareWidth()  - 1 + OFFSET_BOARD * 2,   // size of
-                      8 * (int)pos.getSquareHeight() - 1 + OFFSET_BOARD * 2); // the window
-            
-   glutInitWindowPosition( 10, 10);                // initial position 
-   glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);    // double buffering
-   glutCreateWindow(title);                        // text on titlebar
+   // create the window, each one a little further down and over
+   int width  = 8 * (int)squareWidth  - 1 + OFFSET_BOARD * 2;
+   int height = 8 * (int)squareHeight - 1 + OFFSET_BOARD * 2;
+   int offset = 10 + 30 * (int)(sessions.size() % 10);
+   glutInitWindowSize(width, height);                     // size of the window
+   glutInitWindowPosition(offset, offset);                // initial position 
+   glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);           // double buffering
+   idWindow = glutCreateWindow(title);                    // text on titlebar
+   sessions[idWindow] = this;
    glutIgnoreKeyRepeat(true);
    
    // set up the drawing style: B/W and 2D
    glClearColor(0,0,0, 0);                   // Black is the background color
-   gluOrtho2D((GLdouble)0.0, (GLdouble)(8.0 * pos.getSquareWidth() + (int)(OFFSET_BOARD * 2)),
-              (GLdouble)0.0, (GLdouble)(8.0 * pos.getSquareHeight()+ (int)(OFFSET_BOARD * 2)));
-   glutReshapeWindow(8 * (int)pos.getSquareWidth()  - 1 + OFFSET_BOARD * 2,
-                     8 * (int)pos.getSquareHeight() - 1 + OFFSET_BOARD * 2);
+   gluOrtho2D((GLdouble)0.0, (GLdouble)(8.0 * squareWidth + (int)(OFFSET_BOARD * 2)),
+              (GLdouble)0.0, (GLdouble)(8.0 * squareHeight+ (int)(OFFSET_BOARD * 2)));
+   glutReshapeWindow(width, height);
 
-   // register the callbacks so OpenGL knows how to call us
+   // register the callbacks so OpenGL knows how to call us. These are
+   // for this window; the timer and the idle function are for all
    glutDisplayFunc(      drawCallback    );
-   glutIdleFunc(         drawCallback    );
    glutMouseFunc(        clickCallback   );
    glutPassiveMotionFunc(moveCallback    );
    glutReshapeFunc(      resizeCallback  );
@@ -309,15 +522,13 @@ void Interface::initialize(const char * title)
 #ifdef __APPLE__
    glutWMCloseFunc(      closeCallback   );
 #endif 
-   initialized = true;
    
    // done
    return;
 }
 
 /************************************************************************
- * INTERFACE : RUN
- *            Start the main graphics loop and play the game
+ * INTERFACE : SET CALL BACK
  * INPUT callBack:   Callback function.  Every time we are beginning
  *                   to draw a new frame, we first callback to the client
  *                   to see if he wants to do anything, such as move
@@ -326,14 +537,22 @@ void Interface::initialize(const char * title)
  *                   will need to cast this back to your own data
  *                   type before using it.
  *************************************************************************/
-void Interface::run(void (*callBack)(Interface *, void *), void *p)
+void Interface::setCallBack(void (*callBack)(Interface *, void *), void *p)
 {
-   // setup the callbacks
    this->p = p;
    this->callBack = callBack;
+}
+
+/************************************************************************
+ * INTERFACE : RUN
+ *            Start the main graphics loop and play the game, in this
+ *            window and any others already given a callback
+ *************************************************************************/
+void Interface::run(void (*callBack)(Interface *, void *), void *p)
+{
+   setCallBack(callBack, p);
 
    glutMainLoop();
 
    return;
 }
-
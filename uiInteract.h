@@ -12,29 +12,52 @@
  *    3. callback     - Specified in Run, this user-provided
  *                      function will get called with every frame
  *    4. isDown()     - Is a given key pressed on this loop?
+ *    By default we only draw when something changed: input, or
+ *    the client calling requestRedraw(). The old fixed frame
+ *    rate is still there with setRenderMode(RENDER_FIXED_FPS).
+ *    Every Interface is its own window with its own state, so
+ *    one process can run many of them
  **********************************************/
 
 #pragma once
 
+#include <atomic>     // for ATOMIC redraw request
 #include "position.h"
 
 /********************************************
  * INTERFACE
- * All the data necessary to keep our graphics
- * state in memory
+ * One window and everything it needs to draw and
+ * take input. Each window is a session of its own,
+ * found by its GLUT window id, so one process can
+ * host many boards
  ********************************************/
 class Interface
 {
 public:
-   Interface() {}
-   // Constructor if you want to set up the window with anything but
-   // the default parameters
-   Interface(const char* title)
+   // when the window is drawn
+   enum RenderMode
    {
-      initialize(title);
-   }
+      RENDER_ON_DEMAND,   // only when something changed
+      RENDER_FIXED_FPS    // every frame period, changed or not
+   };
+
+   // open a window with this title
+   Interface(const char* title);
+   ~Interface();
+   Interface(const Interface &) = delete;
+   Interface & operator = (const Interface &) = delete;
+
+   // the GLUT window id, which tells the sessions apart
+   int getSessionId() const { return idWindow; }
+
+   // the session with this window id, or nullptr if it is closed
+   static Interface * find(int idWindow);
 
-   // This will set the game in motion
+   // what to call back to draw this window, and what to hand it
+   void setCallBack(void (*callBack)(Interface*, void*), void* p);
+
+   // This will set the game in motion. With more than one window,
+   // give the others their callbacks first: this runs them all
    void run(void (*callBack)(Interface*, void*), void* p);
 
    // Is it time to redraw the screen
@@ -57,18 +80,47 @@ public:
    // Current frame rate
    double frameRate() const { return timePeriod; };
 
+   // how the window is redrawn
+   void setRenderMode(RenderMode mode);
+   RenderMode getRenderMode() const { return renderMode; }
+
+   // ask for a new frame. Safe to call from any thread, such as a
+   // search reporting progress; input asks on its own
+   void requestRedraw()            { fRedraw = true;  }
+   bool isRedrawRequested() const  { return fRedraw;  }
+
+   // is the whole window new, after it opened, was resized, or was
+   // uncovered? Otherwise the frame starts as a copy of the screen and
+   // the client only draws what changed
+   bool needsFullRedraw()   const  { return fFull; }
+
+   // how much drawing this window costs: frames so far and the
+   // milliseconds it took to build and submit one on average. The
+   // CPU is the whole process's, per second of wall time since the
+   // first window opened
+   unsigned long getFrames() const { return frames; }
+   double getFrameTime()     const { return frames ? msFrames / frames : 0.0; }
+   static double getCpuUsage();
+   static void reportUsage();
+
+   // the size of a square in this window's pixels
+   double getSquareWidth()   const { return squareWidth;  }
+   double getSquareHeight()  const { return squareHeight; }
+
    Position  getSelectPosition()   const { return posSelect; }
    Position  getHoverPosition()    const { return posHover; }
    Position  getPreviousPosition() const { return posSelectPrevious; }
 
    void setSelectPosition(const Position& pos)
    {
+      requestRedraw();
       if (pos != posSelect)
          posSelectPrevious = posSelect;
       posSelect = pos;
    }
    void clearSelectPosition()
    {
+      requestRedraw();
       posSelectPrevious.setInvalid();
       posSelect.setInvalid();
    }
@@ -79,24 +131,42 @@ public:
 
    void setHoverPosition(const Position & pos)
    {
+      if (pos != posHover)
+         requestRedraw();
       posHover = pos;
    }
 
-   static void* p;                   // for client
-   static void (*callBack)(Interface*, void*);
-
 private:
    void initialize(const char* title);
 
-   static bool         initialized;  // only run the constructor once!
-   static double       timePeriod;   // interval between frame draws
-   static unsigned long nextTick;     // time (from clock()) of our next draw
-
-   static Position  posHover;          // mouse hover position in chess coordinates
-   static Position  posSelect;         // mouse clicked position in chess coordinates
-   static Position  posSelectPrevious; // previous clicked position
+   static bool          initialized;  // GLUT is ready for windows
+   static double        cpuStart;     // CPU seconds when the first window opened
+   static double        wallStart;    // wall seconds when the first window opened
+
+   int           idWindow;            // GLUT's id for our window
+   void*         p;                   // for client
+   void        (*callBack)(Interface*, void*);
+   double        timePeriod;          // interval between frame draws
+   unsigned long nextTick;            // time (from clock()) of our next draw
+   RenderMode    renderMode;          // on demand or at a fixed rate
+   std::atomic <bool> fRedraw;        // someone wants a new frame
+   unsigned long frames;              // frames drawn
+   bool          fFull;               // clear and draw this frame in full
+   double        msFrames;            // time spent drawing them
+   double        squareWidth;         // a square in window pixels
+   double        squareHeight;
+
+   friend void drawCallback();
+   friend void clickCallback(int button, int state, int x, int y);
+   friend void moveCallback(int x, int y);
+   friend void resizeCallback(int width, int height);
+   friend void idleCallback();
+
+   Position  posHover;                // mouse hover position in chess coordinates
+   Position  posSelect;               // mouse clicked position in chess coordinates
+   Position  posSelectPrevious;       // previous clicked position
    
-   static char key;                    // key pressed
+   char key;                          // key pressed
 };
 
 /***************************************************************
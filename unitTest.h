@@ -14,22 +14,63 @@
 #undef assertComplexFixture
 #undef assertStandardFixture
 #undef assertEmptyFixture
+#undef runTest
 
 #define NOT_YET_IMPLEMENTED false
 
 #define assertEquals(value, test) assertUnitParameters(closeEnough(value, test), #test, __LINE__, __FUNCTION__)
 #define assertUnit(condition)              assertUnitParameters(condition, #condition, __LINE__, __FUNCTION__)
+#define runTest(test)                      runTimed(#test, [this] { test(); })
 
 #include <iostream>  // for std::cerr
 #include <iomanip>   // for std::setw
 #include <string>    // for std::string
 #include <vector>    // for std::vector
 #include <map>       // for std::map
+#include <chrono>    // for std::chrono::steady_clock
+#include <mutex>     // for std::mutex
+#include <atomic>    // for std::atomic
 
 class UnitTest
 {
 public:
    UnitTest() { reset(); }
+
+   virtual ~UnitTest() {}
+
+   // run all the tests in this class and report the results
+   virtual void run() = 0;
+
+   // where report() writes. Each test class gets its own stream when
+   // they run side by side, so the reports do not interleave
+   void setOutput(std::ostream & out) { pOut = &out; }
+
+   /*************************************************************
+    * NUM FAILURES
+    * How many tests, across every test class, have failed so
+    * far. A test that is only NOT_YET_IMPLEMENTED is not counted.
+    *************************************************************/
+   static std::atomic<int> & numFailures()
+   {
+      static std::atomic<int> numFailures(0);
+      return numFailures;
+   }
+
+   /*************************************************************
+    * TIMINGS
+    * How long each test took, "Class::method" and milliseconds,
+    * across every test class that has reported so far
+    *************************************************************/
+   struct Timing
+   {
+      std::string name;
+      double      ms;
+   };
+   static std::vector<Timing> getTimings()
+   {
+      std::lock_guard<std::mutex> lock(timingsMutex());
+      return timings();
+   }
    
 private:
    // a test failure is a failure string and a line number
@@ -42,6 +83,22 @@ private:
    // each test has a name (the key) and the list of failures(value).
    std::map<std::string, std::vector<Failure>> tests;
 
+   // milliseconds spent in each test, from its first line to its last
+   std::map<std::string, double> times;
+
+   std::ostream * pOut = &std::cout;
+
+   static std::vector<Timing> & timings()
+   {
+      static std::vector<Timing> timings;
+      return timings;
+   }
+   static std::mutex & timingsMutex()
+   {
+      static std::mutex timingsMutex;
+      return timingsMutex;
+   }
+
 protected:
 
    // for closeEnough() and assertEquals(), what is the tolerance?
@@ -61,6 +118,7 @@ protected:
    void reset()
    {
       tests.clear();
+      times.clear();
    }
    
    /*************************************************************
@@ -73,40 +131,70 @@ protected:
       for (auto & test : tests)
          if (!test.second.empty())
          {
-            std::cout << "\t" << test.first << "()\n";
+            *pOut << "\t" << test.first << "()\n";
             for (auto & failure : test.second)
-               std::cout << "\t\tline:"   << failure.lineNumber
-                         << " condition:" << failure.failure << "\n";
+               *pOut << "\t\tline:"   << failure.lineNumber
+                     << " condition:" << failure.failure << "\n";
          }
 
       // name the test case
-      std::cout << std::left << std::setw(15) << name << ":\t";
+      *pOut << std::left << std::setw(15) << name << ":\t";
 
       // handle the no test case
       if (tests.empty())
       {
-         std::cout << "There were no tests]\n";
+         *pOut << "There were no tests]\n";
          return;
       }
 
       // determine the success rate
       int numSuccess = 0;
       for (auto& test : tests)
+      {
          numSuccess += (test.second.empty() ? 1 : 0);
+         for (auto& failure : test.second)
+            if (failure.failure != "NOT_YET_IMPLEMENTED")
+            {
+               numFailures()++;
+               break;
+            }
+      }
       double successRate = (double)numSuccess / (double)tests.size();
 
       // display the summary
-      std::cout.setf(std::ios::fixed | std::ios::showpoint);
-      std::cout.precision(1);
-      std::cout << "There were "
+      pOut->setf(std::ios::fixed | std::ios::showpoint);
+      pOut->precision(1);
+      *pOut << "There were "
          << tests.size()
          << " tests run for a success rate of: "
          << (successRate * 100.0) << "%\n";
 
+      // remember how long each test took
+      {
+         std::lock_guard<std::mutex> lock(timingsMutex());
+         for (auto& time : times)
+            timings().push_back(Timing{std::string(name) + "::" + time.first,
+                                       time.second});
+      }
+
       // after we have reported, the reset for the next report
       reset();
    }
    
+   /*************************************************************
+    * RUN TIMED
+    * Run one test, timing the whole of it: setup, the checks,
+    * and the teardown. run() calls it through runTest()
+    *************************************************************/
+   template <class Test>
+   void runTimed(const char * name, Test test)
+   {
+      auto start = std::chrono::steady_clock::now();
+      test();
+      times[name] += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count();
+   }
+
    /*************************************************************
     * ASSERT UNIT PARAMETERS
     * Custom assert code so we can see all the errors at once
@@ -0,0 +1,70 @@
+/***********************************************************************
+ * Source File:
+ *    ZOBRIST
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Random 64-bit keys, one per piece on each square
+ ************************************************************************/
+
+#include "zobrist.h"
+#include <cassert>
+
+const int ZOBRIST_TYPES = PAWN + 1;   // every PieceType, though SPACE is never used
+
+/*************************************************
+ * SPLIT MIX
+ * A small, fast generator. The keys only need to look
+ * random and be the same every time we run.
+ *************************************************/
+static uint64_t splitMix(uint64_t & state)
+{
+   uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+   return z ^ (z >> 31);
+}
+
+/*************************************************
+ * KEYS
+ * The table, filled the first time we need it
+ *************************************************/
+struct Keys
+{
+   uint64_t piece[ZOBRIST_TYPES][2][64];
+   uint64_t side;
+
+   Keys()
+   {
+      uint64_t state = 2024;
+      for (int pt = 0; pt < ZOBRIST_TYPES; pt++)
+         for (int color = 0; color < 2; color++)
+            for (int square = 0; square < 64; square++)
+               piece[pt][color][square] = splitMix(state);
+      side = splitMix(state);
+   }
+};
+
+static const Keys & keys()
+{
+   static const Keys keys;
+   return keys;
+}
+
+/*************************************************
+ * ZOBRIST PIECE
+ *************************************************/
+uint64_t zobristPiece(PieceType pt, bool isWhite, int square)
+{
+   assert(0 <= pt && pt < ZOBRIST_TYPES);
+   assert(0 <= square && square < 64);
+   return keys().piece[pt][isWhite ? 0 : 1][square];
+}
+
+/*************************************************
+ * ZOBRIST SIDE
+ *************************************************/
+uint64_t zobristSide()
+{
+   return keys().side;
+}
@@ -0,0 +1,21 @@
+/***********************************************************************
+ * Header File:
+ *    ZOBRIST
+ * Author:
+ *    <your name here>
+ * Summary:
+ *    Random 64-bit keys, one per piece on each square. XOR together the
+ *    keys of the pieces on the board and you have a hash of the position
+ *    that can be updated one piece at a time.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>       // for UINT64_T
+#include "pieceType.h"   // for PIECE TYPE
+
+// the key for one piece on one square (0...63, a1 is 0)
+uint64_t zobristPiece(PieceType pt, bool isWhite, int square);
+
+// XORed in when black is to move
+uint64_t zobristSide();